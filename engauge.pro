@@ -112,6 +112,7 @@ HEADERS  += \
     src/Cmd/CmdSettingsSegments.h \
     src/Cmd/CmdStackShadow.h \
     src/Cmd/CmdUndoForTest.h \
+    src/util/CoalescingThread.h \
     src/Color/ColorConstants.h \
     src/Color/ColorFilter.h \
     src/Color/ColorFilterEntry.h \
@@ -143,6 +144,9 @@ HEADERS  += \
     src/Coord/CoordUnitsPolarTheta.h \
     src/Coord/CoordUnitsTime.h \
     src/Correlation/Correlation.h \
+    src/Correlation/CorrelationBatchWorker.h \
+    src/Correlation/CorrelationBorrow.h \
+    src/Correlation/CorrelationPool.h \
     src/Cursor/CursorFactory.h \
     src/Cursor/CursorSize.h \
     src/Curve/Curve.h \
@@ -174,6 +178,8 @@ HEADERS  += \
     src/Dlg/DlgFilterCommand.h \
     src/Dlg/DlgFilterThread.h \
     src/Dlg/DlgFilterWorker.h \
+    src/Dlg/DlgGridRemovalThread.h \
+    src/Dlg/DlgGridRemovalWorker.h \
     src/Dlg/DlgImportAdvanced.h \
     src/Dlg/DlgImportCroppingNonPdf.h \
     src/Dlg/DlgRequiresTransform.h \
@@ -217,6 +223,7 @@ HEADERS  += \
     src/util/EnumsToQt.h \
     src/Export/ExportAlignLinear.h \
     src/Export/ExportAlignLog.h \
+    src/Export/ExportColumns.h \
     src/Export/ExportDelimiter.h \
     src/Export/ExportImageForRegression.h \
     src/Export/ExportLayoutFunctions.h \
@@ -225,8 +232,11 @@ HEADERS  += \
     src/Export/ExportPointsSelectionRelations.h \
     src/Export/ExportDelimiter.h \
     src/Export/ExportFileAbstractBase.h \
+    src/Export/ExportFileBinary.h \
     src/Export/ExportFileFunctions.h \
+    src/Export/ExportFileFunctionsWorker.h \
     src/Export/ExportFileRelations.h \
+    src/Export/ExportFileRelationsWorker.h \
     src/Export/ExportHeader.h \
     src/Export/ExportOrdinalsSmooth.h \
     src/Export/ExportOrdinalsStraight.h \
@@ -235,6 +245,7 @@ HEADERS  += \
     src/Export/ExportValuesOrdinal.h \
     src/Export/ExportValuesXOrY.h \
     src/Export/ExportXThetaValuesMergedFunctions.h \
+    src/Export/ExportYRadiusValues.h \
     src/FileCmd/FileCmdAbstract.h \
     src/FileCmd/FileCmdClose.h \
     src/FileCmd/FileCmdExport.h \
@@ -246,7 +257,12 @@ HEADERS  += \
     src/Filter/FilterImage.h \
     src/Fitting/FittingCurve.h \
     src/Fitting/FittingCurveCoefficients.h \
+    src/Fitting/FittingIncremental.h \
+    src/Fitting/FittingLeastSquares.h \
     src/Fitting/FittingModel.h \
+    src/Fitting/FittingOrderSelection.h \
+    src/Fitting/FittingOrderSelectionThread.h \
+    src/Fitting/FittingOrderSelectionWorker.h \
     src/Fitting/FittingPointsConvenient.h \
     src/Fitting/FittingStatistics.h \
     src/Fitting/FittingWindow.h \
@@ -255,17 +271,23 @@ HEADERS  += \
     src/Format/FormatCoordsUnitsStrategyNonPolarTheta.h \
     src/Format/FormatCoordsUnitsStrategyPolarTheta.h \
     src/Format/FormatDateTime.h \
+    src/Format/FormatDateTimeCompiled.h \
     src/Format/FormatDegreesMinutesSecondsBase.h \
     src/Format/FormatDegreesMinutesSecondsNonPolarTheta.h \
     src/Format/FormatDegreesMinutesSecondsPolarTheta.h \
+    src/Format/FormatDouble.h \
     src/Callback/functor.h \
+    src/Geometry/GeometryCache.h \
     src/Geometry/GeometryModel.h \
+    src/Geometry/GeometryPrefixSums.h \
+    src/Geometry/GeometryResult.h \
     src/Geometry/GeometryStrategyAbstractBase.h \
     src/Geometry/GeometryStrategyContext.h \
     src/Geometry/GeometryStrategyFunctionSmooth.h \
     src/Geometry/GeometryStrategyFunctionStraight.h \
     src/Geometry/GeometryStrategyRelationSmooth.h \
     src/Geometry/GeometryStrategyRelationStraight.h \
+    src/Geometry/GeometryThread.h \
     src/Geometry/GeometryWindow.h \
     src/Ghosts/GhostEllipse.h \
     src/Ghosts/GhostPath.h \
@@ -290,6 +312,7 @@ HEADERS  += \
     src/Grid/GridLine.h \
     src/Grid/GridLineFactory.h \
     src/Grid/GridLineLimiter.h \
+    src/Grid/GridLineRasterizer.h \
     src/Grid/GridLines.h \
     src/Grid/GridLineStyle.h \
     src/Grid/GridRemoval.h \
@@ -311,6 +334,8 @@ HEADERS  += \
     src/Mime/MimePointsDetector.h \
     src/Mime/MimePointsExport.h \
     src/Mime/MimePointsImport.h \    
+    src/Mime/MimePointsParser.h \
+    src/Mime/MimePointsParserThread.h \
     src/util/mmsubs.h \
     src/NonPdf/NonPdf.h \
     src/NonPdf/NonPdfCropping.h \
@@ -328,6 +353,7 @@ HEADERS  += \
     src/Point/PointShape.h \
     src/Point/PointStyle.h \
     src/util/QtToString.h \
+    src/util/RunnableBatch.h \
     src/ScaleBar/ScaleBarAxisPointsUnite.h \
     src/Segment/Segment.h \
     src/Segment/SegmentFactory.h \
@@ -443,6 +469,7 @@ SOURCES += \
     src/Cmd/CmdSettingsSegments.cpp \
     src/Cmd/CmdStackShadow.cpp \
     src/Cmd/CmdUndoForTest.cpp \
+    src/util/CoalescingThread.cpp \
     src/Color/ColorFilter.cpp \
     src/Color/ColorFilterHistogram.cpp \
     src/Color/ColorFilterMode.cpp \
@@ -471,6 +498,9 @@ SOURCES += \
     src/Coord/CoordUnitsPolarTheta.cpp \
     src/Coord/CoordUnitsTime.cpp \
     src/Correlation/Correlation.cpp \
+    src/Correlation/CorrelationBatchWorker.cpp \
+    src/Correlation/CorrelationBorrow.cpp \
+    src/Correlation/CorrelationPool.cpp \
     src/Cursor/CursorFactory.cpp \
     src/Cursor/CursorSize.cpp \
     src/Curve/Curve.cpp \
@@ -502,6 +532,8 @@ SOURCES += \
     src/Dlg/DlgFilterCommand.cpp \
     src/Dlg/DlgFilterThread.cpp \
     src/Dlg/DlgFilterWorker.cpp \
+    src/Dlg/DlgGridRemovalThread.cpp \
+    src/Dlg/DlgGridRemovalWorker.cpp \
     src/Dlg/DlgImportAdvanced.cpp \
     src/Dlg/DlgImportCroppingNonPdf.cpp \
     src/Dlg/DlgRequiresTransform.cpp \
@@ -542,10 +574,14 @@ SOURCES += \
     src/util/EnumsToQt.cpp \
     src/Export/ExportAlignLinear.cpp \
     src/Export/ExportAlignLog.cpp \
+    src/Export/ExportColumns.cpp \
     src/Export/ExportDelimiter.cpp \
     src/Export/ExportFileAbstractBase.cpp \
+    src/Export/ExportFileBinary.cpp \
     src/Export/ExportFileFunctions.cpp \
+    src/Export/ExportFileFunctionsWorker.cpp \
     src/Export/ExportFileRelations.cpp \
+    src/Export/ExportFileRelationsWorker.cpp \
     src/Export/ExportHeader.cpp \
     src/Export/ExportImageForRegression.cpp \
     src/Export/ExportLayoutFunctions.cpp \
@@ -557,6 +593,7 @@ SOURCES += \
     src/Export/ExportToClipboard.cpp \
     src/Export/ExportToFile.cpp \
     src/Export/ExportXThetaValuesMergedFunctions.cpp \
+    src/Export/ExportYRadiusValues.cpp \
     src/FileCmd/FileCmdAbstract.cpp \
     src/FileCmd/FileCmdClose.cpp \
     src/FileCmd/FileCmdExport.cpp \
@@ -567,7 +604,12 @@ SOURCES += \
     src/FileCmd/FileCmdSerialize.cpp \
     src/Filter/FilterImage.cpp \
     src/Fitting/FittingCurve.cpp \    
+    src/Fitting/FittingIncremental.cpp \
+    src/Fitting/FittingLeastSquares.cpp \
     src/Fitting/FittingModel.cpp \
+    src/Fitting/FittingOrderSelection.cpp \
+    src/Fitting/FittingOrderSelectionThread.cpp \
+    src/Fitting/FittingOrderSelectionWorker.cpp \
     src/Fitting/FittingStatistics.cpp \
     src/Fitting/FittingWindow.cpp \    
     src/Format/FormatCoordsUnits.cpp \
@@ -575,16 +617,21 @@ SOURCES += \
     src/Format/FormatCoordsUnitsStrategyNonPolarTheta.cpp \
     src/Format/FormatCoordsUnitsStrategyPolarTheta.cpp \
     src/Format/FormatDateTime.cpp \
+    src/Format/FormatDateTimeCompiled.cpp \
     src/Format/FormatDegreesMinutesSecondsBase.cpp \
     src/Format/FormatDegreesMinutesSecondsNonPolarTheta.cpp \
     src/Format/FormatDegreesMinutesSecondsPolarTheta.cpp \
+    src/Format/FormatDouble.cpp \
+    src/Geometry/GeometryCache.cpp \
     src/Geometry/GeometryModel.cpp \
+    src/Geometry/GeometryPrefixSums.cpp \
     src/Geometry/GeometryStrategyAbstractBase.cpp \
     src/Geometry/GeometryStrategyContext.cpp \
     src/Geometry/GeometryStrategyFunctionSmooth.cpp \
     src/Geometry/GeometryStrategyFunctionStraight.cpp \
     src/Geometry/GeometryStrategyRelationSmooth.cpp \
     src/Geometry/GeometryStrategyRelationStraight.cpp \
+    src/Geometry/GeometryThread.cpp \
     src/Geometry/GeometryWindow.cpp \
     src/Ghosts/GhostEllipse.cpp \
     src/Ghosts/GhostPath.cpp \
@@ -608,6 +655,7 @@ SOURCES += \
     src/Grid/GridLine.cpp \
     src/Grid/GridLineFactory.cpp \
     src/Grid/GridLineLimiter.cpp \
+    src/Grid/GridLineRasterizer.cpp \
     src/Grid/GridLines.cpp \
     src/Grid/GridRemoval.cpp \
     src/Help/HelpBrowser.cpp \
@@ -627,6 +675,8 @@ SOURCES += \
     src/Mime/MimePointsDetector.cpp \
     src/Mime/MimePointsExport.cpp \
     src/Mime/MimePointsImport.cpp \    
+    src/Mime/MimePointsParser.cpp \
+    src/Mime/MimePointsParserThread.cpp \
     src/util/mmsubs.cpp \
     src/NonPdf/NonPdf.cpp \
     src/NonPdf/NonPdfCropping.cpp \
@@ -641,6 +691,7 @@ SOURCES += \
     src/Point/PointShape.cpp \
     src/Point/PointStyle.cpp \
     src/util/QtToString.cpp \
+    src/util/RunnableBatch.cpp \
     src/ScaleBar/ScaleBarAxisPointsUnite.cpp \
     src/Segment/Segment.cpp \
     src/Segment/SegmentFactory.cpp \
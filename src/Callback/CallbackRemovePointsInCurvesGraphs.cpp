@@ -5,23 +5,21 @@
  ******************************************************************************************************/
 
 #include "CallbackRemovePointsInCurvesGraphs.h"
-#include "CoordSystem.h"
+#include "Point.h"
 
-extern const QString AXIS_CURVE_NAME;
-
-CallbackRemovePointsInCurvesGraphs::CallbackRemovePointsInCurvesGraphs(CoordSystem &coordSystem) :
-  m_coordSystem (coordSystem)
+CallbackRemovePointsInCurvesGraphs::CallbackRemovePointsInCurvesGraphs()
 {
 }
 
 CallbackSearchReturn CallbackRemovePointsInCurvesGraphs::callback (const QString &curveName,
                                                                    const Point &point)
 {
-  if (curveName == AXIS_CURVE_NAME) {
-    m_coordSystem.removePointAxis (point.identifier());
-  } else {
-    m_coordSystem.removePointGraph (point.identifier());
-  }
+  m_pointIdentifiers [curveName] << point.identifier();
 
   return CALLBACK_SEARCH_RETURN_CONTINUE;
 }
+
+const CurveNameToPointIdentifiers &CallbackRemovePointsInCurvesGraphs::pointIdentifiers () const
+{
+  return m_pointIdentifiers;
+}
@@ -8,26 +8,33 @@
 #define CALLBACK_REMOVE_POINTS_IN_CURVES_GRAPHS_H
 
 #include "CallbackSearchReturn.h"
+#include <QHash>
+#include <QString>
+#include <QStringList>
 
-class CoordSystem;
 class Point;
-class QString;
 
-/// Callback that is used when iterating through a read-only CurvesGraphs to remove corresponding points in Document.
+/// Point identifiers grouped by curve name
+typedef QHash<QString, QStringList> CurveNameToPointIdentifiers;
+
+/// Callback that is used when iterating through a read-only CurvesGraphs to collect the points that are to be removed from
+/// Document. The points are grouped by curve so each curve can remove all of its points in one pass
 class CallbackRemovePointsInCurvesGraphs
 {
 public:
   /// Single constructor.
-  CallbackRemovePointsInCurvesGraphs(CoordSystem &coordSystem);
+  CallbackRemovePointsInCurvesGraphs();
 
   /// Callback method.
   CallbackSearchReturn callback (const QString &curveName,
                                  const Point &point);
 
+  /// Identifiers of the collected points, grouped by curve name
+  const CurveNameToPointIdentifiers &pointIdentifiers () const;
+
 private:
-  CallbackRemovePointsInCurvesGraphs ();
 
-  CoordSystem &m_coordSystem;
+  CurveNameToPointIdentifiers m_pointIdentifiers;
 };
 
 #endif // CALLBACK_REMOVE_POINTS_IN_CURVES_GRAPHS_H
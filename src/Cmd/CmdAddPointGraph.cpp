@@ -81,7 +81,7 @@ void CmdAddPointGraph::cmdRedo ()
                                                    m_identifierAdded,
                                                    m_ordinal);
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (QStringList (m_identifierAdded));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -91,7 +91,7 @@ void CmdAddPointGraph::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (QStringList (m_identifierAdded));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
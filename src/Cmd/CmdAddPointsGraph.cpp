@@ -104,18 +104,21 @@ void CmdAddPointsGraph::cmdRedo ()
 
   saveOrCheckPreCommandDocumentStateHash (document ());
   saveDocumentState (document ());
-  for (int index = 0; index < m_points.count(); index++) {
 
-    QString identifierAdded;
-    document().addPointGraphWithGeneratedIdentifier (m_curveName,
-                                                     m_points.at (index),
-                                                     identifierAdded,
-                                                     m_ordinals.at (index));
-    m_identifiersAdded.push_back (identifierAdded);
+  // All points are added as one batch, so the curve is merged once instead of once per point
+  QList<QPointF> posScreens;
+  QList<QPoint>::const_iterator itr;
+  for (itr = m_points.begin(); itr != m_points.end(); itr++) {
+    posScreens << *itr;
   }
 
+  document().addPointsGraphWithGeneratedIdentifiers (m_curveName,
+                                                     posScreens,
+                                                     m_ordinals,
+                                                     m_identifiersAdded);
+
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_identifiersAdded);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -125,7 +128,7 @@ void CmdAddPointsGraph::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_identifiersAdded);
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
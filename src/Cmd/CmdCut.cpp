@@ -103,7 +103,7 @@ void CmdCut::cmdRedo ()
   document().removePointsInCurvesGraphs (m_curvesGraphsRemoved);
 
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (pointIdentifiers (m_curvesGraphsRemoved));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -113,7 +113,7 @@ void CmdCut::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (pointIdentifiers (m_curvesGraphsRemoved));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
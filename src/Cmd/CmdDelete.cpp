@@ -88,7 +88,7 @@ void CmdDelete::cmdRedo ()
   document().removePointsInCurvesGraphs (m_curvesGraphsRemoved);
 
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (pointIdentifiers (m_curvesGraphsRemoved));
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -98,7 +98,7 @@ void CmdDelete::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (pointIdentifiers (m_curvesGraphsRemoved));
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
@@ -124,7 +124,7 @@ void CmdEditPointGraph::cmdRedo ()
                              m_pointIdentifiers,
                              mainWindow().transformation());
   document().updatePointOrdinals (mainWindow().transformation());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_pointIdentifiers);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
 
@@ -134,7 +134,7 @@ void CmdEditPointGraph::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_pointIdentifiers);
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
 
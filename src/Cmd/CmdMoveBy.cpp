@@ -83,7 +83,7 @@ void CmdMoveBy::cmdRedo ()
   saveOrCheckPreCommandDocumentStateHash (document ());
   saveDocumentState (document ());
   moveBy (m_deltaScreen);
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_movedPoints.keys ());
   resetSelection(m_movedPoints);
   saveOrCheckPostCommandDocumentStateHash (document ());
 }
@@ -96,7 +96,7 @@ void CmdMoveBy::cmdUndo ()
 
   saveOrCheckPostCommandDocumentStateHash (document ());
   restoreDocumentState (document ());
-  mainWindow().updateAfterCommand();
+  mainWindow().updateAfterCommand (m_movedPoints.keys ());
   resetSelection(m_movedPoints);
   saveOrCheckPreCommandDocumentStateHash (document ());
 }
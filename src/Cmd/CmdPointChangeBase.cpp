@@ -10,6 +10,7 @@
 #include "Document.h"
 #include "EngaugeAssert.h"
 #include "Logger.h"
+#include "Point.h"
 
 CmdPointChangeBase::CmdPointChangeBase(MainWindow &mainWindow,
                                        Document &document,
@@ -27,6 +28,24 @@ CmdPointChangeBase::~CmdPointChangeBase()
 {
 }
 
+QStringList CmdPointChangeBase::pointIdentifiers (const CurvesGraphs &curvesGraphs) const
+{
+  QStringList identifiers;
+
+  QStringList curveNames = curvesGraphs.curvesGraphsNames ();
+  QStringList::const_iterator itrCurve;
+  for (itrCurve = curveNames.begin (); itrCurve != curveNames.end (); itrCurve++) {
+
+    const Points points = curvesGraphs.curveForCurveName (*itrCurve)->points ();
+    Points::const_iterator itrPoint;
+    for (itrPoint = points.begin (); itrPoint != points.end (); itrPoint++) {
+      identifiers << itrPoint->identifier ();
+    }
+  }
+
+  return identifiers;
+}
+
 void CmdPointChangeBase::restoreDocumentState (Document &document) const
 {
   LOG4CPP_INFO_S ((*mainCat)) << "CmdPointChangeBase::restoreDocumentState";
@@ -8,6 +8,7 @@
 #define CMD_POINT_CHANGE_BASE_H
 
 #include "CmdAbstract.h"
+#include <QStringList>
 
 class Curve;
 class CurvesGraphs;
@@ -31,6 +32,9 @@ public:
 
 protected:
 
+  /// Identifiers of the points in the specified curves, such as the points that a command removes
+  QStringList pointIdentifiers (const CurvesGraphs &curvesGraphs) const;
+
   /// Restore the document previously saved by saveDocumentState
   void restoreDocumentState (Document &document) const;
 
@@ -147,6 +147,35 @@ void CoordSystem::addPointGraphWithSpecifiedIdentifier (const QString &curveName
                               << " identifier=" << identifier.toLatin1 ().data ();
 }
 
+void CoordSystem::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                          const QList<QPointF> &posScreens,
+                                                          const QList<double> &ordinals,
+                                                          QStringList &generatedIdentifiers)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "CoordSystem::addPointsGraphWithGeneratedIdentifiers"
+                              << " curve=" << curveName.toLatin1 ().data ()
+                              << " count=" << posScreens.count ();
+
+  ENGAUGE_ASSERT (posScreens.count () == ordinals.count ());
+
+  Points points;
+  points.reserve (posScreens.count ());
+  generatedIdentifiers.clear ();
+
+  for (int index = 0; index < posScreens.count (); index++) {
+
+    Point point (curveName,
+                 posScreens.at (index),
+                 ordinals.at (index));
+    points.push_back (point);
+
+    generatedIdentifiers << point.identifier ();
+  }
+
+  m_curvesGraphs.addPoints (curveName,
+                            points);
+}
+
 void CoordSystem::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
   CallbackAddPointsInCurvesGraphs ftor (*this);
@@ -808,12 +837,31 @@ void CoordSystem::removePointGraph (const QString &identifier)
 
 void CoordSystem::removePointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
-  CallbackRemovePointsInCurvesGraphs ftor (*this);
+  CallbackRemovePointsInCurvesGraphs ftor;
 
   Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
                                                                                                      &CallbackRemovePointsInCurvesGraphs::callback);
 
   curvesGraphs.iterateThroughCurvesPoints (ftorWithCallback);
+
+  // Each curve removes all of its points in one pass, rather than one pass per point
+  const CurveNameToPointIdentifiers &pointIdentifiers = ftor.pointIdentifiers ();
+  CurveNameToPointIdentifiers::const_iterator itr;
+  for (itr = pointIdentifiers.begin(); itr != pointIdentifiers.end(); itr++) {
+
+    const QString &curveName = itr.key();
+
+    LOG4CPP_INFO_S ((*mainCat)) << "CoordSystem::removePointsInCurvesGraphs"
+                                << " curve=" << curveName.toLatin1 ().data ()
+                                << " count=" << itr.value().count();
+
+    if (curveName == AXIS_CURVE_NAME) {
+      m_curveAxes->removePoints (itr.value());
+    } else {
+      m_curvesGraphs.removePoints (curveName,
+                                   itr.value());
+    }
+  }
 }
 
 void CoordSystem::resetSelectedCurveNameIfNecessary ()
@@ -67,6 +67,10 @@ public:
                                                      const QPointF &posScreen,
                                                      const QString &identifier,
                                                      double ordinal);
+  virtual void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                       const QList<QPointF> &posScreens,
+                                                       const QList<double> &ordinals,
+                                                       QStringList &generatedIdentifiers);
   virtual void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
   virtual void checkAddPointAxis (const QPointF &posScreen,
                                   const QPointF &posGraph,
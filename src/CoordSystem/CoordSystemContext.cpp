@@ -103,6 +103,19 @@ void CoordSystemContext::addPointGraphWithSpecifiedIdentifier (const QString &cu
                                                                             ordinal);
 }
 
+void CoordSystemContext::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                                 const QList<QPointF> &posScreens,
+                                                                 const QList<double> &ordinals,
+                                                                 QStringList &generatedIdentifiers)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "CoordSystemContext::addPointsGraphWithGeneratedIdentifiers";
+
+  m_coordSystems [m_coordSystemIndex]->addPointsGraphWithGeneratedIdentifiers(curveName,
+                                                                              posScreens,
+                                                                              ordinals,
+                                                                              generatedIdentifiers);
+}
+
 void CoordSystemContext::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
   LOG4CPP_INFO_S ((*mainCat)) << "CoordSystemContext::addPointsInCurvesGraphs";
@@ -51,6 +51,10 @@ class CoordSystemContext : public CoordSystemInterface
                                                      const QPointF &posScreen,
                                                      const QString &identifier,
                                                      double ordinal);
+  virtual void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                       const QList<QPointF> &posScreens,
+                                                       const QList<double> &ordinals,
+                                                       QStringList &generatedIdentifiers);
   virtual void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
   virtual void checkAddPointAxis (const QPointF &posScreen,
                                   const QPointF &posGraph,
@@ -22,6 +22,7 @@
 #include "DocumentModelSegments.h"
 #include "functor.h"
 #include "Point.h"
+#include <QList>
 
 class Curve;
 class CurvesGraphs;
@@ -77,6 +78,17 @@ public:
                                                      const QString &identifier,
                                                      double ordinal) = 0;
 
+  /// Add a batch of graph points to one curve with generated point identifiers. This is much faster than adding the
+  /// points one at a time when there are many points, since the curve takes the whole batch in one call
+  /// \param curveName Graph curve receiving the points
+  /// \param posScreens Screen coordinates of the points
+  /// \param ordinals Ordinal of each point. There must be one ordinal per screen position
+  /// \param generatedIdentifiers Returned identifiers of the added points, in the same order as posScreens
+  virtual void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                       const QList<QPointF> &posScreens,
+                                                       const QList<double> &ordinals,
+                                                       QStringList &generatedIdentifiers) = 0;
+
   /// Add all points identified in the specified CurvesGraphs. See also removePointsInCurvesGraphs
   virtual void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs) = 0;
 
@@ -5,11 +5,24 @@
  ******************************************************************************************************/
 
 #include "Correlation.h"
+#include "CorrelationBatchWorker.h"
 #include "EngaugeAssert.h"
 #include "fftw3.h"
 #include "Logger.h"
 #include <QDebug>
 #include <qmath.h>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include "RunnableBatch.h"
+
+// The FFTW planner, which creates and destroys plans, is not thread safe so all access is serialized. Execution of
+// plans is thread safe, so correlations on separate instances can run concurrently
+static QMutex plannerMutex;
+
+// Number of live instances, whether pooled or not, guarded by plannerMutex. Global FFTW state cannot be released
+// while any of them still holds plans
+static int instanceCount = 0;
 
 Correlation::Correlation(int N) :
   m_N (N),
@@ -18,18 +31,34 @@ Correlation::Correlation(int N) :
   m_outShifted ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (2 * N - 1))),
   m_outA ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (2 * N - 1))),
   m_outB ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (2 * N - 1))),
-  m_out ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (2 * N - 1)))
+  m_out ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (2 * N - 1))),
+  m_realIn ((double *) fftw_malloc(sizeof(double) * (2 * N - 1))),
+  m_realOut ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * N)), // Real transform of length 2N-1 has N outputs
+  m_referenceSpectrum ((fftw_complex *) fftw_malloc(sizeof(fftw_complex) * N)),
+  m_referenceIsLoaded (false)
 {
+  QMutexLocker locker (&plannerMutex);
+
+  ++instanceCount;
+
   m_planA = fftw_plan_dft_1d(2 * N - 1, m_signalA, m_outA, FFTW_FORWARD, FFTW_ESTIMATE);
   m_planB = fftw_plan_dft_1d(2 * N - 1, m_signalB, m_outB, FFTW_FORWARD, FFTW_ESTIMATE);
   m_planX = fftw_plan_dft_1d(2 * N - 1, m_out, m_outShifted, FFTW_BACKWARD, FFTW_ESTIMATE);
+  m_planRealForward = fftw_plan_dft_r2c_1d(2 * N - 1, m_realIn, m_realOut, FFTW_ESTIMATE);
+  m_planRealBackward = fftw_plan_dft_c2r_1d(2 * N - 1, m_realOut, m_realIn, FFTW_ESTIMATE);
 }
 
 Correlation::~Correlation()
 {
+  QMutexLocker locker (&plannerMutex);
+
   fftw_destroy_plan(m_planA);
   fftw_destroy_plan(m_planB);
   fftw_destroy_plan(m_planX);
+  fftw_destroy_plan(m_planRealForward);
+  fftw_destroy_plan(m_planRealBackward);
+
+  --instanceCount;
 
   fftw_free(m_signalA);
   fftw_free(m_signalB);
@@ -37,8 +66,75 @@ Correlation::~Correlation()
   fftw_free(m_out);
   fftw_free(m_outA);
   fftw_free(m_outB);
+  fftw_free(m_realIn);
+  fftw_free(m_realOut);
+  fftw_free(m_referenceSpectrum);
+
+  // No fftw_cleanup here since that would tear down FFTW state for every other instance in the process.
+  // cleanupPlanner takes care of that once no instances remain
+}
+
+int Correlation::N () const
+{
+  return m_N;
+}
+
+void Correlation::cleanupPlanner ()
+{
+  QMutexLocker locker (&plannerMutex);
+
+  if (instanceCount == 0) {
+    fftw_cleanup();
+  } else {
+    LOG4CPP_INFO_S ((*mainCat)) << "Correlation::cleanupPlanner skipping cleanup since "
+                                << instanceCount << " instances remain";
+  }
+}
+
+void Correlation::correlateCandidateWithReference (const double candidate [],
+                                                   double *scratchReal,
+                                                   fftw_complex *scratchComplex,
+                                                   int &binStartMax,
+                                                   double &corrMax,
+                                                   double correlations []) const
+{
+  int i, N = m_N;
+
+  loadNormalizedPadded (candidate,
+                        0,
+                        scratchReal);
+
+  fftw_execute_dft_r2c(m_planRealForward, scratchReal, scratchComplex);
+
+  // Correlation in frequency space. Only the nonredundant half of the spectrum is needed for real functions
+  double scale = 1.0 / (2.0 * N - 1.0);
+  for (i = 0; i < N; i++) {
+    // Multiply m_referenceSpectrum [i] * conj (scratchComplex [i]) * scale
+    double re = m_referenceSpectrum [i] [0] * scratchComplex [i] [0] + m_referenceSpectrum [i] [1] * scratchComplex [i] [1];
+    double im = m_referenceSpectrum [i] [1] * scratchComplex [i] [0] - m_referenceSpectrum [i] [0] * scratchComplex [i] [1];
+    scratchComplex [i] [0] = re * scale;
+    scratchComplex [i] [1] = im * scale;
+  }
+
+  fftw_execute_dft_c2r(m_planRealBackward, scratchComplex, scratchReal);
+
+  // Search for highest correlation, with the same index shift as in correlateWithShift. The imaginary part
+  // is identically zero so the magnitude is just the absolute value
+  corrMax = 0.0;
+  for (int i0AtLeft = 0; i0AtLeft < N; i0AtLeft++) {
+
+    int i0AtCenter = (i0AtLeft + N) % (2 * N - 1);
+    double corr = qAbs (scratchReal [i0AtCenter]);
+
+    if ((i0AtLeft == 0) || (corr > corrMax)) {
+      binStartMax = i0AtLeft;
+      corrMax = corr;
+    }
 
-  fftw_cleanup();
+    if (correlations != 0) {
+      correlations [i0AtLeft] = corr;
+    }
+  }
 }
 
 void Correlation::correlateWithShift (int N,
@@ -141,3 +237,78 @@ void Correlation::correlateWithoutShift (int N,
     corrMax += function1 [i] * function2 [i];
   }
 }
+
+void Correlation::correlateWithShiftBatch (int N,
+                                           int count,
+                                           const double * const candidates [],
+                                           int binStartMax [],
+                                           double corrMax [],
+                                           double * const correlations []) const
+{
+  ENGAUGE_ASSERT (N == m_N);
+  ENGAUGE_ASSERT (m_referenceIsLoaded);
+
+  if (count <= 0) {
+    return;
+  }
+
+  // Split the candidates into one contiguous range per thread
+  int workerCount = qMax (1, qMin (QThread::idealThreadCount(), count));
+  int candidatesPerWorker = (count + workerCount - 1) / workerCount;
+
+  RunnableBatch batch;
+  for (int candidateStart = 0; candidateStart < count; candidateStart += candidatesPerWorker) {
+
+    batch.start (new CorrelationBatchWorker (*this,
+                                             candidateStart,
+                                             qMin (candidateStart + candidatesPerWorker, count),
+                                             candidates,
+                                             binStartMax,
+                                             corrMax,
+                                             correlations));
+  }
+
+  batch.waitForDone ();
+}
+
+void Correlation::loadNormalizedPadded (const double function [],
+                                        int offset,
+                                        double padded []) const
+{
+  int i, N = m_N;
+
+  // Same normalization as in correlateWithShift
+  double sumMean = 0, max = 0;
+  for (i = 0; i < N; i++) {
+    sumMean += function [i];
+    max = qMax (max, function [i]);
+  }
+
+  double additiveNormalization = sumMean / N;
+  double multiplicativeNormalization = 1.0 / max;
+
+  for (i = 0; i < 2 * N - 1; i++) {
+    padded [i] = 0.0;
+  }
+  for (i = 0; i < N; i++) {
+    padded [i + offset] = (function [i] - additiveNormalization) * multiplicativeNormalization;
+  }
+}
+
+void Correlation::loadReference (int N,
+                                 const double reference [])
+{
+  ENGAUGE_ASSERT (N == m_N);
+
+  loadNormalizedPadded (reference,
+                        N - 1,
+                        m_realIn);
+  fftw_execute(m_planRealForward);
+
+  for (int i = 0; i < N; i++) {
+    m_referenceSpectrum [i] [0] = m_realOut [i] [0];
+    m_referenceSpectrum [i] [1] = m_realOut [i] [1];
+  }
+
+  m_referenceIsLoaded = true;
+}
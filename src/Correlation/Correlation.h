@@ -9,15 +9,27 @@
 
 #include "fftw3.h"
 
+class CorrelationBatchWorker;
+
 /// Fast cross correlation between two functions. We do not use complex.h along with fftw3.h since then the
-/// complex numbers will be native, which would then require platform-dependent code
+/// complex numbers will be native, which would then require platform-dependent code.
+///
+/// Each instance may be used by one thread at a time, but separate instances can be used concurrently since
+/// access to the FFTW planner is serialized. Instances are best borrowed from CorrelationPool so the plans
+/// stay warm between uses
 class Correlation
 {
+  friend class CorrelationBatchWorker;
+  friend class CorrelationPool;
+
 public:
   /// Single constructor. Slow memory allocations are done once and then reused repeatedly.
   Correlation(int N);
   ~Correlation();
 
+  /// Size that this instance was created for
+  int N () const;
+
   /// Return the shift in function1 that best aligns that function with function2. The functions
   /// are normalized internally. The correlations vector, as a function of shift, is returned for logging
   void correlateWithShift (int N,
@@ -34,9 +46,44 @@ public:
                               const double function2 [],
                               double &corrMax) const;
 
+  /// Batch version of correlateWithShift, for correlating one reference function against many candidate functions.
+  /// The reference, which was transformed once by loadReference, plays the role of function1. Each of the count
+  /// candidates plays the role of function2. Since all functions are real, half-length real-to-complex transforms
+  /// are used, and the candidates are spread across threads. Results match correlateWithShift to within roundoff.
+  /// The correlations argument may be null, or else each candidate gets its own correlations vector for logging
+  void correlateWithShiftBatch (int N,
+                                int count,
+                                const double * const candidates [],
+                                int binStartMax [],
+                                double corrMax [],
+                                double * const correlations []) const;
+
+  /// Normalize and transform the reference function for correlateWithShiftBatch. The cached spectrum is reused
+  /// until the next call
+  void loadReference (int N,
+                      const double reference []);
+
 private:
   Correlation();
 
+  /// Release all global FFTW state, unless some instance, borrowed or created directly, still exists
+  static void cleanupPlanner ();
+
+  /// Correlate one candidate against the reference spectrum, using caller-supplied scratch arrays so this can
+  /// run concurrently in separate threads. Arrays of length 2N-1 (real) and N (complex) are required
+  void correlateCandidateWithReference (const double candidate [],
+                                        double *scratchReal,
+                                        fftw_complex *scratchComplex,
+                                        int &binStartMax,
+                                        double &corrMax,
+                                        double correlations []) const;
+
+  /// Normalize a function (zero mean and unit maximum) into padded array of length 2N-1, with the N values
+  /// starting at offset. Other entries are zeroed
+  void loadNormalizedPadded (const double function [],
+                             int offset,
+                             double padded []) const;
+
   int m_N;
 
   fftw_complex *m_signalA;
@@ -49,6 +96,17 @@ private:
   fftw_plan m_planA;
   fftw_plan m_planB;
   fftw_plan m_planX;
+
+  // Real-to-complex plans for correlateWithShiftBatch. These are executed with the new-array execute functions,
+  // which are thread safe, so only the arrays used for planning are kept here
+  double *m_realIn;
+  fftw_complex *m_realOut;
+  fftw_plan m_planRealForward;
+  fftw_plan m_planRealBackward;
+
+  // Cached spectrum of the reference from loadReference
+  fftw_complex *m_referenceSpectrum;
+  bool m_referenceIsLoaded;
 };
 
 #endif // CORRELATION_H
@@ -0,0 +1,47 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "Correlation.h"
+#include "CorrelationBatchWorker.h"
+
+CorrelationBatchWorker::CorrelationBatchWorker (const Correlation &correlation,
+                                                int candidateStart,
+                                                int candidateStop,
+                                                const double * const candidates [],
+                                                int binStartMax [],
+                                                double corrMax [],
+                                                double * const correlations []) :
+  m_correlation (correlation),
+  m_candidateStart (candidateStart),
+  m_candidateStop (candidateStop),
+  m_candidates (candidates),
+  m_binStartMax (binStartMax),
+  m_corrMax (corrMax),
+  m_correlations (correlations)
+{
+}
+
+void CorrelationBatchWorker::run ()
+{
+  int N = m_correlation.m_N;
+
+  // Scratch arrays must come from fftw_malloc so their alignment matches the arrays used for planning
+  double *scratchReal = (double *) fftw_malloc(sizeof(double) * (2 * N - 1));
+  fftw_complex *scratchComplex = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * N);
+
+  for (int candidate = m_candidateStart; candidate < m_candidateStop; candidate++) {
+
+    m_correlation.correlateCandidateWithReference (m_candidates [candidate],
+                                                   scratchReal,
+                                                   scratchComplex,
+                                                   m_binStartMax [candidate],
+                                                   m_corrMax [candidate],
+                                                   (m_correlations != 0 ? m_correlations [candidate] : 0));
+  }
+
+  fftw_free(scratchReal);
+  fftw_free(scratchComplex);
+}
@@ -0,0 +1,45 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef CORRELATION_BATCH_WORKER_H
+#define CORRELATION_BATCH_WORKER_H
+
+#include "fftw3.h"
+#include <QRunnable>
+
+class Correlation;
+
+/// Runnable that correlates a contiguous range of candidates against the reference spectrum for
+/// Correlation::correlateWithShiftBatch. Each worker has its own scratch arrays, and writes only the
+/// outputs for its own candidates, so any number of workers can run concurrently
+class CorrelationBatchWorker : public QRunnable
+{
+public:
+  /// Single constructor. Candidates candidateStart (inclusive) to candidateStop (exclusive) are processed
+  CorrelationBatchWorker (const Correlation &correlation,
+                          int candidateStart,
+                          int candidateStop,
+                          const double * const candidates [],
+                          int binStartMax [],
+                          double corrMax [],
+                          double * const correlations []);
+
+  /// Correlate the candidates in this range
+  virtual void run ();
+
+private:
+  CorrelationBatchWorker ();
+
+  const Correlation &m_correlation;
+  int m_candidateStart;
+  int m_candidateStop;
+  const double * const *m_candidates;
+  int *m_binStartMax;
+  double *m_corrMax;
+  double * const *m_correlations;
+};
+
+#endif // CORRELATION_BATCH_WORKER_H
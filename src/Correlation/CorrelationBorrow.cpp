@@ -0,0 +1,23 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "CorrelationBorrow.h"
+#include "CorrelationPool.h"
+
+CorrelationBorrow::CorrelationBorrow (int N) :
+  m_correlation (CorrelationPool::borrow (N))
+{
+}
+
+CorrelationBorrow::~CorrelationBorrow ()
+{
+  CorrelationPool::giveBack (m_correlation);
+}
+
+Correlation *CorrelationBorrow::operator-> () const
+{
+  return m_correlation;
+}
@@ -0,0 +1,32 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef CORRELATION_BORROW_H
+#define CORRELATION_BORROW_H
+
+class Correlation;
+
+/// Scoped borrowing of a Correlation instance from CorrelationPool. The instance is given back when this object
+/// goes out of scope, so an early return or exception cannot leak it
+class CorrelationBorrow
+{
+public:
+  /// Single constructor, which borrows an instance for functions of length N
+  CorrelationBorrow (int N);
+  ~CorrelationBorrow ();
+
+  /// Access to the borrowed instance
+  Correlation *operator-> () const;
+
+private:
+  CorrelationBorrow ();
+  CorrelationBorrow (const CorrelationBorrow &other);
+  CorrelationBorrow &operator= (const CorrelationBorrow &other);
+
+  Correlation *m_correlation;
+};
+
+#endif // CORRELATION_BORROW_H
@@ -0,0 +1,70 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "Correlation.h"
+#include "CorrelationPool.h"
+#include "EngaugeAssert.h"
+#include "Logger.h"
+#include <QMutexLocker>
+
+QMutex CorrelationPool::m_mutex;
+CorrelationPool::SizeToCorrelation CorrelationPool::m_idle;
+int CorrelationPool::m_borrowedCount = 0;
+
+Correlation *CorrelationPool::borrow (int N)
+{
+  Correlation *correlation = 0;
+
+  {
+    QMutexLocker locker (&m_mutex);
+
+    // Reuse warm instance if possible
+    SizeToCorrelation::iterator itr = m_idle.find (N);
+    if (itr != m_idle.end ()) {
+      correlation = itr.value ();
+      m_idle.erase (itr);
+    }
+
+    ++m_borrowedCount;
+  }
+
+  if (correlation == 0) {
+
+    // Created outside of the pool lock so other threads can keep borrowing and giving back. Planning inside
+    // the constructor is serialized by Correlation itself
+    LOG4CPP_INFO_S ((*mainCat)) << "CorrelationPool::borrow creating instance for N=" << N;
+
+    correlation = new Correlation (N);
+  }
+
+  return correlation;
+}
+
+void CorrelationPool::cleanup ()
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "CorrelationPool::cleanup";
+
+  QMutexLocker locker (&m_mutex);
+
+  qDeleteAll (m_idle);
+  m_idle.clear ();
+
+  // Skipped by Correlation itself while borrowed instances, or instances created outside of the pool, remain
+  Correlation::cleanupPlanner ();
+}
+
+void CorrelationPool::giveBack (Correlation *correlation)
+{
+  ENGAUGE_ASSERT (correlation != 0);
+
+  QMutexLocker locker (&m_mutex);
+
+  ENGAUGE_ASSERT (m_borrowedCount > 0);
+
+  m_idle.insert (correlation->N (),
+                 correlation);
+  --m_borrowedCount;
+}
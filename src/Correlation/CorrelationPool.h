@@ -0,0 +1,42 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef CORRELATION_POOL_H
+#define CORRELATION_POOL_H
+
+#include <QMultiMap>
+#include <QMutex>
+
+class Correlation;
+
+/// Thread safe pool of Correlation instances, keyed by size. Creating a Correlation allocates arrays and
+/// computes FFTW plans, so instances are kept warm for reuse rather than deleted after each use. Each borrowed
+/// instance belongs to the borrowing thread until it is given back, so correlations in separate threads run
+/// concurrently
+class CorrelationPool
+{
+public:
+  /// Borrow an instance for functions of length N. An idle instance is reused if one exists, otherwise a new
+  /// one is created. The instance must be returned with giveBack, which CorrelationBorrow does automatically
+  static Correlation *borrow (int N);
+
+  /// Release all idle instances, and then the global FFTW state if no other instances remain. Called at shutdown
+  static void cleanup ();
+
+  /// Return an instance that was obtained from borrow
+  static void giveBack (Correlation *correlation);
+
+private:
+  CorrelationPool();
+
+  typedef QMultiMap<int, Correlation*> SizeToCorrelation;
+
+  static QMutex m_mutex;
+  static SizeToCorrelation m_idle;
+  static int m_borrowedCount;
+};
+
+#endif // CORRELATION_POOL_H
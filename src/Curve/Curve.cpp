@@ -17,6 +17,7 @@
 #include <QDebug>
 #include <QMultiMap>
 #include <QTextStream>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include "Transformation.h"
@@ -44,6 +45,7 @@ Curve::Curve(const QString &curveName,
 Curve::Curve (const Curve &curve) :
   m_curveName (curve.curveName ()),
   m_points (curve.points ()),
+  m_pointIdentifierToIndex (curve.m_pointIdentifierToIndex),
   m_colorFilterSettings (curve.colorFilterSettings ()),
   m_curveStyle (curve.curveStyle ())
 {
@@ -124,6 +126,7 @@ Curve &Curve::operator=(const Curve &curve)
 {
   m_curveName = curve.curveName ();
   m_points = curve.points ();
+  m_pointIdentifierToIndex = curve.m_pointIdentifierToIndex;
   m_colorFilterSettings = curve.colorFilterSettings ();
   m_curveStyle = curve.curveStyle ();
 
@@ -132,9 +135,26 @@ Curve &Curve::operator=(const Curve &curve)
 
 void Curve::addPoint (Point point)
 {
+  m_pointIdentifierToIndex [point.identifier ()] = m_points.count ();
   m_points.push_back (point);
 }
 
+void Curve::addPoints (const Points &points)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "Curve::addPoints"
+                              << " curve=" << m_curveName.toLatin1().data()
+                              << " count=" << points.count ();
+
+  // Appending in batch order gives the same sequence as adding the points one at a time, which matters for relations
+  // since updatePointOrdinalsRelations numbers the points in sequence order
+  m_points.reserve (m_points.count () + points.count ());
+
+  Points::const_iterator itr;
+  for (itr = points.begin (); itr != points.end (); itr++) {
+    addPoint (*itr);
+  }
+}
+
 ColorFilterSettings Curve::colorFilterSettings () const
 {
   return m_colorFilterSettings;
@@ -154,16 +174,11 @@ void Curve::editPointAxis (const QPointF &posGraph,
                            const QString &identifier)
 {
   // Search for the point with matching identifier
-  QList<Point>::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
+  int index = m_pointIdentifierToIndex.value (identifier, -1);
+  if (index >= 0) {
 
-    Point &point = *itr;
-    if (point.identifier () == identifier) {
+    m_points [index].setPosGraph (posGraph);
 
-      point.setPosGraph (posGraph);
-      break;
-
-    }
   }
 }
 
@@ -179,13 +194,15 @@ void Curve::editPointGraph (bool isX,
 
   if (transformation.transformIsDefined()) {
 
-    // Search for the point with matching identifier
-    QList<Point>::iterator itr;
-    for (itr = m_points.begin(); itr != m_points.end(); itr++) {
+    // Look up each identifier, rather than searching the identifiers for each point, so the cost grows with the
+    // number of identifiers. Identifiers belonging to other curves are skipped
+    QStringList::const_iterator itr;
+    for (itr = identifiers.begin(); itr != identifiers.end(); itr++) {
 
-      Point &point = *itr;
+      int index = m_pointIdentifierToIndex.value (*itr, -1);
+      if (index >= 0) {
 
-      if (identifiers.contains (point.identifier ())) {
+        Point &point = m_points [index];
 
         // Although one or more graph coordinates are specified, it is the screen coordinates that must be
         // moved. This is because only the screen coordinates of the graph points are tracked (not the graph coordinates).
@@ -284,13 +301,9 @@ void Curve::exportToClipboard (const QHash<QString, bool> &selectedHash,
 bool Curve::isXOnly(const QString &pointIdentifier) const
 {
   // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      return point.isXOnly();
-      break;
-    }
+  int index = m_pointIdentifierToIndex.value (pointIdentifier, -1);
+  if (index >= 0) {
+    return m_points.at (index).isXOnly();
   }
 
   ENGAUGE_ASSERT (false);
@@ -358,7 +371,7 @@ void Curve::loadCurvePoints(QXmlStreamReader &reader)
       if (reader.name () == DOCUMENT_SERIALIZE_POINT) {
 
         Point point (reader);
-        m_points.push_back (point);
+        addPoint (point);
       }
     }
   }
@@ -436,12 +449,9 @@ int Curve::numPoints () const
 
 Point *Curve::pointForPointIdentifier (const QString pointIdentifier)
 {
-  Points::iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      return &point;
-    }
+  int index = m_pointIdentifierToIndex.value (pointIdentifier, -1);
+  if (index >= 0) {
+    return &m_points [index];
   }
 
   ENGAUGE_ASSERT (false);
@@ -453,18 +463,26 @@ const Points Curve::points () const
   return m_points;
 }
 
+bool Curve::pointsAreInOrdinalOrder () const
+{
+  PointComparator comparator;
+  for (int index = 1; index < m_points.count (); index++) {
+    if (comparator (m_points.at (index), m_points.at (index - 1))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 QPointF Curve::positionGraph (const QString &pointIdentifier) const
 {
   QPointF posGraph;
 
   // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      posGraph = point.posGraph ();
-      break;
-    }
+  int index = m_pointIdentifierToIndex.value (pointIdentifier, -1);
+  if (index >= 0) {
+    posGraph = m_points.at (index).posGraph ();
   }
 
   return posGraph;
@@ -475,13 +493,9 @@ QPointF Curve::positionScreen (const QString &pointIdentifier) const
   QPointF posScreen;
 
   // Search for point with matching identifier
-  Points::const_iterator itr;
-  for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    const Point &point = *itr;
-    if (pointIdentifier == point.identifier ()) {
-      posScreen = point.posScreen ();
-      break;
-    }
+  int index = m_pointIdentifierToIndex.value (pointIdentifier, -1);
+  if (index >= 0) {
+    posScreen = m_points.at (index).posScreen ();
   }
 
   return posScreen;
@@ -510,14 +524,44 @@ void Curve::printStream (QString indentation,
 void Curve::removePoint (const QString &identifier)
 {
   // Search for point with matching identifier
-  Points::iterator itr;
+  int index = m_pointIdentifierToIndex.value (identifier, -1);
+  if (index >= 0) {
+
+    m_points.removeAt (index);
+    m_pointIdentifierToIndex.remove (identifier);
+
+    // Points after the removed point each moved down by one
+    for (int i = index; i < m_points.count (); i++) {
+      m_pointIdentifierToIndex [m_points.at (i).identifier ()] = i;
+    }
+  }
+}
+
+void Curve::removePoints (const QStringList &identifiers)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "Curve::removePoints"
+                              << " curve=" << m_curveName.toLatin1().data()
+                              << " count=" << identifiers.count ();
+
+  // Single pass that keeps the points that are not being removed, so removing many points does not
+  // shift the remaining points once per removal
+  QHash<QString, bool> identifiersRemoved;
+  QStringList::const_iterator itrId;
+  for (itrId = identifiers.begin(); itrId != identifiers.end(); itrId++) {
+    identifiersRemoved [*itrId] = true;
+  }
+
+  Points pointsKept;
+  Points::const_iterator itr;
   for (itr = m_points.begin (); itr != m_points.end (); itr++) {
-    Point point = *itr;
-    if (point.identifier () == identifier) {
-      m_points.erase (itr);
-      break;
+    const Point &point = *itr;
+    if (!identifiersRemoved.contains (point.identifier ())) {
+      pointsKept.push_back (point);
     }
   }
+
+  m_points = pointsKept;
+  updatePointIdentifierToIndex ();
 }
 
 void Curve::saveXml(QXmlStreamWriter &writer) const
@@ -558,6 +602,9 @@ void Curve::setCurveName (const QString &curveName)
     Point &point = *itr;
     point.setCurveName (curveName);
   }
+
+  // Identifiers start with the curve name
+  updatePointIdentifierToIndex ();
 }
 
 void Curve::setCurveStyle (const CurveStyle &curveStyle)
@@ -592,9 +639,26 @@ void Curve::updatePointOrdinals (const Transformation &transformation)
 
   }
 
-  qSort (m_points.begin(),
-         m_points.end(),
-         PointComparator());
+  // Relations keep their order, and functions are usually still in x order after an edit, so sorting and reindexing
+  // are skipped when the points are already in ordinal order
+  if (!pointsAreInOrdinalOrder ()) {
+
+    qSort (m_points.begin(),
+           m_points.end(),
+           PointComparator());
+
+    updatePointIdentifierToIndex ();
+  }
+}
+
+void Curve::updatePointIdentifierToIndex ()
+{
+  m_pointIdentifierToIndex.clear ();
+  m_pointIdentifierToIndex.reserve (m_points.count ());
+
+  for (int index = 0; index < m_points.count (); index++) {
+    m_pointIdentifierToIndex [m_points.at (index).identifier ()] = index;
+  }
 }
 
 void Curve::updatePointOrdinalsFunctions (const Transformation &transformation)
@@ -605,10 +669,10 @@ void Curve::updatePointOrdinalsFunctions (const Transformation &transformation)
                               << " curve=" << m_curveName.toLatin1().data()
                               << " connectAs=" << curveConnectAsToString(curveConnectAs).toLatin1().data();
 
-  // Get a map of x/theta values as keys with point identifiers as the values. This has to be a multimap since
-  // some users will have two (or maybe more) points with the same x coordinate, even though true functions should
-  // never have that happen
-  XOrThetaToPointIdentifier xOrThetaToPointIdentifier;
+  // Get the x/theta value of each point, in the current point order
+  QVector<double> xOrThetas;
+  xOrThetas.reserve (m_points.count ());
+  bool isIncreasing = true;
   Points::iterator itr;
   for (itr = m_points.begin (); itr != m_points.end (); itr++) {
     Point &point = *itr;
@@ -626,8 +690,31 @@ void Curve::updatePointOrdinalsFunctions (const Transformation &transformation)
       posGraph= point.posScreen();
     }
 
-    xOrThetaToPointIdentifier.insert (posGraph.x(),
-                                      point.identifier());
+    if (!xOrThetas.isEmpty () && !(xOrThetas.last () < posGraph.x ())) {
+      isIncreasing = false;
+    }
+    xOrThetas.push_back (posGraph.x ());
+  }
+
+  if (isIncreasing) {
+
+    // Points are already in strictly increasing x/theta order, as they are after most edits, so each ordinal is just
+    // the point's index and the map below is not needed
+    int ordinal = 0;
+    for (itr = m_points.begin(); itr != m_points.end(); itr++) {
+      itr->setOrdinal (ordinal++);
+    }
+
+    return;
+  }
+
+  // Get a map of x/theta values as keys with point identifiers as the values. This has to be a multimap since
+  // some users will have two (or maybe more) points with the same x coordinate, even though true functions should
+  // never have that happen
+  XOrThetaToPointIdentifier xOrThetaToPointIdentifier;
+  for (int index = 0; index < m_points.count (); index++) {
+    xOrThetaToPointIdentifier.insert (xOrThetas.at (index),
+                                      m_points.at (index).identifier());
   }
 
   // Every point in m_points must be in the map. Failure to perform this check will probably result in the assert
@@ -636,7 +723,7 @@ void Curve::updatePointOrdinalsFunctions (const Transformation &transformation)
 
   // Since m_points is a list (and therefore does not provide direct access to elements), we build a temporary map of
   // point identifier to ordinal, by looping through the sorted x/theta values. Since QMap is used, the x/theta keys are sorted
-  QMap<QString, double> pointIdentifierToOrdinal;
+  QHash<QString, double> pointIdentifierToOrdinal;
   int ordinal = 0;
   XOrThetaToPointIdentifier::const_iterator itrX;
   for (itrX = xOrThetaToPointIdentifier.begin(); itrX != xOrThetaToPointIdentifier.end(); itrX++) {
@@ -16,6 +16,7 @@
 #include <QHash>
 #include <QList>
 #include <QString>
+#include <QStringList>
 
 extern const QString AXIS_CURVE_NAME;
 extern const QString DEFAULT_GRAPH_CURVE_NAME;
@@ -32,6 +33,9 @@ class Transformation;
 /// Container for one set of digitized Points
 class Curve
 {
+  // For unit testing
+  friend class TestCurve;
+
 public:
   /// Constructor from scratch.
   Curve(const QString &curveName,
@@ -53,6 +57,10 @@ public:
   /// Add Point to this Curve.
   void addPoint (Point point);
 
+  /// Add a batch of Points to this Curve, in batch order after the existing Points, just like calling addPoint for
+  /// each one. Storage is reserved once for the whole batch
+  void addPoints (const Points &points);
+
   /// Return the color filter.
   ColorFilterSettings colorFilterSettings () const;
 
@@ -113,6 +121,9 @@ public:
   /// Perform the opposite of addPointAtEnd.
   void removePoint (const QString &identifier);
 
+  /// Remove the specified Points in one pass. Identifiers of points in other Curves are ignored
+  void removePoints (const QStringList &identifiers);
+
   /// Serialize curve
   void saveXml(QXmlStreamWriter &writer) const;
 
@@ -135,12 +146,18 @@ private:
   void loadCurvePoints(QXmlStreamReader &reader);
   void loadXml(QXmlStreamReader &reader);
   Point *pointForPointIdentifier (const QString pointIdentifier);
+  bool pointsAreInOrdinalOrder () const;
+  void updatePointIdentifierToIndex ();
   void updatePointOrdinalsFunctions (const Transformation &transformation);
   void updatePointOrdinalsRelations ();
 
   QString m_curveName;
   Points m_points;
 
+  // Index of each point in m_points, keyed by point identifier, so lookups by identifier do not search the
+  // points. This must be updated whenever points are added, removed, reordered or renamed
+  QHash<QString, int> m_pointIdentifierToIndex;
+
   ColorFilterSettings m_colorFilterSettings;
   CurveStyle m_curveStyle;
 };
@@ -34,6 +34,14 @@ void CurvesGraphs::addPoint (const Point &point)
   curve->addPoint (point);
 }
 
+void CurvesGraphs::addPoints (const QString &curveName,
+                              const Points &points)
+{
+  Curve *curve = curveForCurveName (curveName);
+  ENGAUGE_ASSERT (curve != 0);
+  curve->addPoints (points);
+}
+
 Curve *CurvesGraphs::curveForCurveName (const QString &curveName)
 {
   // Search for curve with matching name
@@ -267,6 +275,14 @@ void CurvesGraphs::removePoint (const QString &pointIdentifier)
   curve->removePoint (pointIdentifier);
 }
 
+void CurvesGraphs::removePoints (const QString &curveName,
+                                 const QStringList &pointIdentifiers)
+{
+  Curve *curve = curveForCurveName (curveName);
+  ENGAUGE_ASSERT (curve != 0);
+  curve->removePoints (pointIdentifiers);
+}
+
 void CurvesGraphs::saveXml(QXmlStreamWriter &writer) const
 {
   LOG4CPP_INFO_S ((*mainCat)) << "CurvesGraphs::saveXml";
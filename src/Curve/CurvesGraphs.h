@@ -32,6 +32,10 @@ public:
   /// Append new Point to the specified Curve.
   void addPoint (const Point &point);
 
+  /// Add a batch of new Points to the specified Curve. See Curve::addPoints
+  void addPoints (const QString &curveName,
+                  const Points &points);
+
   /// Return the axis or graph curve for the specified curve name.
   Curve *curveForCurveName (const QString &curveName);
 
@@ -82,6 +86,10 @@ public:
   /// Remove the Point from its Curve.
   void removePoint (const QString &pointIdentifier);
 
+  /// Remove the specified Points from the specified Curve in one pass.
+  void removePoints (const QString &curveName,
+                     const QStringList &pointIdentifiers);
+
   /// Serialize curves
   void saveXml(QXmlStreamWriter &writer) const;
 
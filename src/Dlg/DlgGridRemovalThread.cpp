@@ -0,0 +1,85 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "DlgGridRemovalThread.h"
+#include "DlgSettingsGridRemoval.h"
+#include <QMutexLocker>
+
+DlgGridRemovalThread::DlgGridRemovalThread(const QPixmap &pixmapOriginal,
+                                           const Transformation &transformation,
+                                           const DocumentModelGridRemoval &modelGridRemovalInitial,
+                                           DlgSettingsGridRemoval &dlgSettingsGridRemoval) :
+  m_pixmapOriginal (pixmapOriginal),
+  m_transformation (transformation),
+  m_dlgSettingsGridRemoval (dlgSettingsGridRemoval),
+  m_cancelRequested (0),
+  m_isQueued (true),
+  m_modelGridRemovalQueued (modelGridRemovalInitial)
+{
+}
+
+const QAtomicInt &DlgGridRemovalThread::cancelRequested () const
+{
+  return m_cancelRequested;
+}
+
+void DlgGridRemovalThread::requestCancel ()
+{
+  QMutexLocker locker (&m_mutex);
+
+  m_cancelRequested.store (1);
+}
+
+void DlgGridRemovalThread::requestParameters (const DocumentModelGridRemoval &modelGridRemoval)
+{
+  {
+    QMutexLocker locker (&m_mutex);
+
+    m_modelGridRemovalQueued = modelGridRemoval;
+    m_isQueued = true;
+    m_cancelRequested.store (1);
+  }
+
+  emit signalParametersQueued ();
+}
+
+void DlgGridRemovalThread::run ()
+{
+  // Worker must be created here so it belongs to this thread rather than the GUI thread
+  DlgGridRemovalWorker *dlgGridRemovalWorker = new DlgGridRemovalWorker (m_pixmapOriginal,
+                                                                         m_transformation,
+                                                                         *this);
+
+  // Connect signal to start process. This thread object lives in the GUI thread, so the connection is queued
+  connect (this, SIGNAL (signalParametersQueued ()),
+           dlgGridRemovalWorker, SLOT (slotNewParameters ()));
+
+  // Connect signal to return each completed image
+  connect (dlgGridRemovalWorker, SIGNAL (signalTransferImage (QImage, double)),
+           &m_dlgSettingsGridRemoval, SLOT (slotTransferImage (QImage, double)));
+
+  // Initial parameters were queued by the constructor
+  dlgGridRemovalWorker->slotNewParameters ();
+
+  exec ();
+
+  delete dlgGridRemovalWorker;
+}
+
+bool DlgGridRemovalThread::takeParameters (DocumentModelGridRemoval &modelGridRemoval)
+{
+  QMutexLocker locker (&m_mutex);
+
+  if (!m_isQueued) {
+    return false;
+  }
+
+  modelGridRemoval = m_modelGridRemovalQueued;
+  m_isQueued = false;
+  m_cancelRequested.store (0);
+
+  return true;
+}
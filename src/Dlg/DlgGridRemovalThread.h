@@ -0,0 +1,73 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef DLG_GRID_REMOVAL_THREAD_H
+#define DLG_GRID_REMOVAL_THREAD_H
+
+#include "DlgGridRemovalWorker.h"
+#include "DocumentModelGridRemoval.h"
+#include <QAtomicInt>
+#include <QMutex>
+#include <QObject>
+#include <QPixmap>
+#include <QThread>
+#include "Transformation.h"
+
+class DlgSettingsGridRemoval;
+
+/// Class for processing new grid removal settings. This is based on DlgFilterThread
+class DlgGridRemovalThread : public QThread
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor. The initial settings are processed as soon as the thread starts, so they cannot be lost
+  /// before the signals are connected
+  DlgGridRemovalThread(const QPixmap &pixmapOriginal,
+                       const Transformation &transformation,
+                       const DocumentModelGridRemoval &modelGridRemovalInitial,
+                       DlgSettingsGridRemoval &dlgSettingsGridRemoval);
+
+  /// Flag that is nonzero while the processing under way has been superseded. See GridRemoval
+  const QAtomicInt &cancelRequested () const;
+
+  /// Abandon any ongoing processing, since the thread is about to be stopped. This is called from the GUI thread
+  void requestCancel ();
+
+  /// Abandon any ongoing processing and queue new parameters for DlgGridRemovalWorker. Only the latest parameters are
+  /// kept. This is called from the GUI thread
+  void requestParameters (const DocumentModelGridRemoval &modelGridRemoval);
+
+  /// Run this thread.
+  virtual void run();
+
+  /// Take the queued parameters, if there are any, and clear the cancel flag. This is called by DlgGridRemovalWorker.
+  /// The queue and the cancel flag are changed under one lock, so a cancel always belongs to parameters that have not
+  /// been taken yet
+  bool takeParameters (DocumentModelGridRemoval &modelGridRemoval);
+
+signals:
+  /// Wake up DlgGridRemovalWorker since parameters were queued
+  void signalParametersQueued ();
+
+private:
+  DlgGridRemovalThread();
+
+  QPixmap m_pixmapOriginal;
+  Transformation m_transformation;
+
+  DlgSettingsGridRemoval &m_dlgSettingsGridRemoval;
+
+  // Shared with the worker so the GUI thread can interrupt processing that is under way
+  QAtomicInt m_cancelRequested;
+
+  // Parameters waiting for the worker, guarded by m_mutex along with changes to m_cancelRequested
+  QMutex m_mutex;
+  bool m_isQueued;
+  DocumentModelGridRemoval m_modelGridRemovalQueued;
+};
+
+#endif // DLG_GRID_REMOVAL_THREAD_H
@@ -0,0 +1,111 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "DlgGridRemovalThread.h"
+#include "DlgGridRemovalWorker.h"
+#include "GridRemoval.h"
+#include "Logger.h"
+#include <qmath.h>
+
+const int NO_DELAY = 0;
+const int DOWNSAMPLED_MAX_DIMENSION = 800; // Larger images get a quick downsampled pass before the full resolution pass
+
+DlgGridRemovalWorker::DlgGridRemovalWorker(const QPixmap &pixmapOriginal,
+                                           const Transformation &transformation,
+                                           DlgGridRemovalThread &gridRemovalThread) :
+  m_imageOriginal (pixmapOriginal.toImage()),
+  m_downsampledScale (1.0),
+  m_transformation (transformation),
+  m_gridRemovalThread (gridRemovalThread),
+  m_downsampledPending (false),
+  m_fullResolutionPending (false)
+{
+  int maxDimension = qMax (m_imageOriginal.width(),
+                           m_imageOriginal.height());
+  if (maxDimension > DOWNSAMPLED_MAX_DIMENSION) {
+
+    // Downsampled image is computed once since it does not depend on the settings
+    m_downsampledScale = (double) DOWNSAMPLED_MAX_DIMENSION / (double) maxDimension;
+    m_imageDownsampled = m_imageOriginal.scaled (qMax (1, (int) (m_downsampledScale * m_imageOriginal.width())),
+                                                 qMax (1, (int) (m_downsampledScale * m_imageOriginal.height())),
+                                                 Qt::IgnoreAspectRatio,
+                                                 Qt::FastTransformation);
+  }
+
+  m_restartTimer.setSingleShot (false);
+  connect (&m_restartTimer, SIGNAL (timeout ()), this, SLOT (slotRestartTimeout()));
+}
+
+bool DlgGridRemovalWorker::processImage (const QImage &image,
+                                         double screenScale)
+{
+  GridRemoval gridRemoval (screenScale,
+                           m_gridRemovalThread.cancelRequested ());
+  QPixmap pixmap = gridRemoval.remove (m_transformation,
+                                       m_modelGridRemoval,
+                                       image);
+
+  // Null pixmap means the processing was cancelled. Results are also discarded if newer parameters arrived
+  // while the results were being computed
+  bool success = !pixmap.isNull () && (m_gridRemovalThread.cancelRequested ().load () == 0);
+  if (success) {
+    emit signalTransferImage (pixmap.toImage (),
+                              screenScale);
+  }
+
+  return success;
+}
+
+void DlgGridRemovalWorker::slotNewParameters ()
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "DlgGridRemovalWorker::slotNewParameters";
+
+  if (!m_restartTimer.isActive()) {
+
+    // Timer is not currently active so start it up
+    m_restartTimer.start (NO_DELAY);
+  }
+}
+
+void DlgGridRemovalWorker::slotRestartTimeout ()
+{
+  if (m_gridRemovalThread.takeParameters (m_modelGridRemoval)) {
+
+    // Only the latest settings are queued, and the cancel flag was cleared along with taking them
+
+    m_downsampledPending = !m_imageDownsampled.isNull ();
+    m_fullResolutionPending = true;
+
+    // Start timer to process first pass
+    m_restartTimer.start (NO_DELAY);
+
+  } else if (m_downsampledPending) {
+
+    m_downsampledPending = false;
+    if (processImage (m_imageDownsampled,
+                      m_downsampledScale)) {
+
+      // Restart timer to process full resolution pass, unless new parameters arrive first
+      m_restartTimer.start (NO_DELAY);
+
+    } else {
+
+      m_fullResolutionPending = false;
+
+    }
+
+  } else if (m_fullResolutionPending) {
+
+    m_fullResolutionPending = false;
+    processImage (m_imageOriginal,
+                  1.0);
+
+  } else {
+
+    m_restartTimer.stop ();
+
+  }
+}
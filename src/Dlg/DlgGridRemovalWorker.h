@@ -0,0 +1,65 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef DLG_GRID_REMOVAL_WORKER_H
+#define DLG_GRID_REMOVAL_WORKER_H
+
+#include "DocumentModelGridRemoval.h"
+#include <QImage>
+#include <QObject>
+#include <QPixmap>
+#include <QTimer>
+#include "Transformation.h"
+
+class DlgGridRemovalThread;
+
+/// Class for processing new grid removal settings for the preview in DlgSettingsGridRemoval. This follows the same
+/// approach as DlgFilterWorker. A downsampled result is sent first so the preview responds quickly even for huge
+/// images, then the full resolution result is sent. Work that has been superseded by newer settings is abandoned
+class DlgGridRemovalWorker : public QObject
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor. Parameters and the cancel flag are shared through the thread, which the GUI thread updates
+  DlgGridRemovalWorker(const QPixmap &pixmapOriginal,
+                       const Transformation &transformation,
+                       DlgGridRemovalThread &gridRemovalThread);
+
+public slots:
+  /// Start processing with the parameters queued in DlgGridRemovalThread. Any ongoing processing is abandoned
+  void slotNewParameters ();
+
+private slots:
+  void slotRestartTimeout ();
+
+signals:
+  /// Send processed image. The image is smaller than the original image by the factor screenScale, which is one for
+  /// the full resolution result
+  void signalTransferImage (QImage image,
+                            double screenScale);
+
+private:
+  DlgGridRemovalWorker();
+
+  // Returns true if the image was processed without being superseded by newer parameters
+  bool processImage (const QImage &image,
+                     double screenScale);
+
+  QImage m_imageOriginal;
+  QImage m_imageDownsampled;
+  double m_downsampledScale; // Less than one if m_imageDownsampled is smaller than m_imageOriginal
+  Transformation m_transformation;
+  DlgGridRemovalThread &m_gridRemovalThread;
+
+  DocumentModelGridRemoval m_modelGridRemoval; // Set when processing restarts
+
+  bool m_downsampledPending;
+  bool m_fullResolutionPending;
+  QTimer m_restartTimer; // Decouple slotRestartProcessing from the processing that this class performs
+};
+
+#endif // DLG_GRID_REMOVAL_WORKER_H
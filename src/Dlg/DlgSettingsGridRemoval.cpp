@@ -6,6 +6,7 @@
 
 #include "CmdMediator.h"
 #include "CmdSettingsGridRemoval.h"
+#include "DlgGridRemovalThread.h"
 #include "DlgSettingsGridRemoval.h"
 #include "EngaugeAssert.h"
 #include "Logger.h"
@@ -13,6 +14,7 @@
 #include <QCheckBox>
 #include <QComboBox>
 #include <QDoubleValidator>
+#include <QGraphicsPixmapItem>
 #include <QGraphicsScene>
 #include <QGridLayout>
 #include <QGroupBox>
@@ -35,6 +37,7 @@ DlgSettingsGridRemoval::DlgSettingsGridRemoval(MainWindow &mainWindow) :
                            mainWindow),
   m_scenePreview (0),
   m_viewPreview (0),
+  m_gridRemovalThread (0),
   m_modelGridRemovalBefore (0),
   m_modelGridRemovalAfter (0)
 {
@@ -47,6 +50,8 @@ DlgSettingsGridRemoval::DlgSettingsGridRemoval(MainWindow &mainWindow) :
 DlgSettingsGridRemoval::~DlgSettingsGridRemoval()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::~DlgSettingsGridRemoval";
+
+  deleteThread ();
 }
 
 void DlgSettingsGridRemoval::createOptionalSaveDefault (QHBoxLayout * /* layout */)
@@ -278,6 +283,34 @@ QWidget *DlgSettingsGridRemoval::createSubPanel ()
   return subPanel;
 }
 
+void DlgSettingsGridRemoval::createThread ()
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::createThread";
+
+  // Thread is recreated for each load since the image and transformation are specific to the document
+  deleteThread ();
+
+  m_gridRemovalThread = new DlgGridRemovalThread (cmdMediator().document().pixmap(),
+                                                  mainWindow().transformation(),
+                                                  *m_modelGridRemovalAfter,
+                                                  *this);
+  m_gridRemovalThread->start(); // Now that thread is started, we can use requestParameters
+}
+
+void DlgSettingsGridRemoval::deleteThread ()
+{
+  if (m_gridRemovalThread != 0) {
+
+    LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::deleteThread";
+
+    m_gridRemovalThread->requestCancel ();
+    m_gridRemovalThread->quit ();
+    m_gridRemovalThread->wait ();
+    delete m_gridRemovalThread;
+    m_gridRemovalThread = 0;
+  }
+}
+
 void DlgSettingsGridRemoval::handleOk ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::handleOk";
@@ -337,12 +370,16 @@ void DlgSettingsGridRemoval::load (CmdMediator &cmdMediator)
   m_editStepY->setText(QString::number(m_modelGridRemovalAfter->stepY()));
   m_editStopY->setText(QString::number(m_modelGridRemovalAfter->stopY()));
 
+  // Original image is shown until the first processed image arrives. Scene rectangle stays the same when
+  // downsampled images are shown
+  QPixmap pixmap = cmdMediator.document().pixmap();
   m_scenePreview->clear();
-  m_scenePreview->addPixmap (cmdMediator.document().pixmap());
+  m_scenePreview->addPixmap (pixmap);
+  m_scenePreview->setSceneRect (pixmap.rect ());
 
   updateControls ();
   enableOk (false); // Disable Ok button since there not yet any changes
-  updatePreview();
+  createThread (); // Initial settings are processed when the thread starts, so updatePreview is not needed
 }
 
 void DlgSettingsGridRemoval::setSmallDialogs(bool smallDialogs)
@@ -462,6 +499,21 @@ void DlgSettingsGridRemoval::slotStopY(const QString &stopY)
   updatePreview();
 }
 
+void DlgSettingsGridRemoval::slotTransferImage (QImage image,
+                                                 double screenScale)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::slotTransferImage"
+                              << " scale=" << screenScale;
+
+  // Replace old pixmap. A downsampled image is stretched to cover the original image
+  m_scenePreview->clear ();
+  QGraphicsPixmapItem *itemPixmap = m_scenePreview->addPixmap (QPixmap::fromImage (image));
+  if (screenScale > 0 && screenScale != 1.0) {
+    itemPixmap->setTransform (QTransform::fromScale (1.0 / screenScale,
+                                                     1.0 / screenScale));
+  }
+}
+
 void DlgSettingsGridRemoval::updateControls ()
 {
   m_editCloseDistance->setEnabled (m_chkRemoveGridLines->isChecked ());
@@ -507,5 +559,11 @@ void DlgSettingsGridRemoval::updateControls ()
 
 void DlgSettingsGridRemoval::updatePreview ()
 {
+  if (m_gridRemovalThread != 0) {
 
+    LOG4CPP_INFO_S ((*mainCat)) << "DlgSettingsGridRemoval::updatePreview";
+
+    // Interrupt superseded processing and send the latest settings
+    m_gridRemovalThread->requestParameters (*m_modelGridRemovalAfter);
+  }
 }
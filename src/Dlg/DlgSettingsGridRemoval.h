@@ -8,7 +8,9 @@
 #define DLG_SETTINGS_GRID_REMOVAL_H
 
 #include "DlgSettingsAbstractBase.h"
+#include <QImage>
 
+class DlgGridRemovalThread;
 class DocumentModelGridRemoval;
 class QCheckBox;
 class QComboBox;
@@ -50,6 +52,11 @@ private slots:
   void slotStepY(const QString &);
   void slotStopY(const QString &);
 
+  /// Receive processed preview image from DlgGridRemovalWorker. The image is smaller than the original image by
+  /// the factor screenScale
+  void slotTransferImage (QImage image,
+                          double screenScale);
+
 protected:
   virtual void handleOk ();
 
@@ -59,6 +66,8 @@ private:
   void createRemoveGridLinesX (QGridLayout *layoutGridLines, int &row);
   void createRemoveGridLinesY (QGridLayout *layoutGridLines, int &row);
   void createPreview (QGridLayout *layout, int &row);
+  void createThread ();
+  void deleteThread ();
   void updateControls ();
   void updatePreview();
 
@@ -89,6 +98,8 @@ private:
   QGraphicsScene *m_scenePreview;
   ViewPreview *m_viewPreview;
 
+  DlgGridRemovalThread *m_gridRemovalThread;
+
   DocumentModelGridRemoval *m_modelGridRemovalBefore;
   DocumentModelGridRemoval *m_modelGridRemovalAfter;
 };
@@ -215,6 +215,19 @@ void Document::addPointGraphWithSpecifiedIdentifier (const QString &curveName,
                                                             ordinal);
 }
 
+void Document::addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                                       const QList<QPointF> &posScreens,
+                                                       const QList<double> &ordinals,
+                                                       QStringList &generatedIdentifiers)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "Document::addPointsGraphWithGeneratedIdentifiers";
+
+  m_coordSystemContext.addPointsGraphWithGeneratedIdentifiers(curveName,
+                                                              posScreens,
+                                                              ordinals,
+                                                              generatedIdentifiers);
+}
+
 void Document::addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs)
 {
   LOG4CPP_INFO_S ((*mainCat)) << "Document::addPointsInCurvesGraphs";
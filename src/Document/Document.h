@@ -90,6 +90,12 @@ public:
                                              const QString &identifier,
                                              double ordinal);
 
+  /// Add a batch of graph points to one curve with generated point identifiers. See CoordSystemInterface
+  void addPointsGraphWithGeneratedIdentifiers (const QString &curveName,
+                                               const QList<QPointF> &posScreens,
+                                               const QList<double> &ordinals,
+                                               QStringList &generatedIdentifiers);
+
   /// Add all points identified in the specified CurvesGraphs. See also removePointsInCurvesGraphs
   void addPointsInCurvesGraphs (CurvesGraphs &curvesGraphs);
 
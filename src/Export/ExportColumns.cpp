@@ -0,0 +1,49 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "ExportColumns.h"
+
+ExportColumns::ExportColumns ()
+{
+}
+
+void ExportColumns::addColumn (const QString &name,
+                               const QVector<double> &values)
+{
+  m_names << name;
+  m_values << values;
+}
+
+int ExportColumns::columnCount () const
+{
+  return m_names.count ();
+}
+
+QString ExportColumns::name (int col) const
+{
+  ENGAUGE_ASSERT ((0 <= col) && (col < m_names.count ()));
+
+  return m_names.at (col);
+}
+
+int ExportColumns::rowCountMax () const
+{
+  int rowCount = 0;
+  for (int col = 0; col < m_values.count (); col++) {
+    rowCount = qMax (rowCount,
+                     m_values [col].count ());
+  }
+
+  return rowCount;
+}
+
+const QVector<double> &ExportColumns::values (int col) const
+{
+  ENGAUGE_ASSERT ((0 <= col) && (col < m_values.count ()));
+
+  return m_values [col];
+}
@@ -0,0 +1,44 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_COLUMNS_H
+#define EXPORT_COLUMNS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// Named columns of unformatted values for binary export. Columns may have different lengths since each relation
+/// curve has its own number of points. Missing values inside a column are stored as NaN
+class ExportColumns
+{
+public:
+  /// Single constructor. There are initially no columns
+  ExportColumns ();
+
+  /// Append a column
+  void addColumn (const QString &name,
+                  const QVector<double> &values);
+
+  /// Number of columns
+  int columnCount () const;
+
+  /// Name of the specified column
+  QString name (int col) const;
+
+  /// Number of rows in the longest column
+  int rowCountMax () const;
+
+  /// Values of the specified column
+  const QVector<double> &values (int col) const;
+
+private:
+
+  QStringList m_names;
+  QVector<QVector<double> > m_values;
+};
+
+#endif // EXPORT_COLUMNS_H
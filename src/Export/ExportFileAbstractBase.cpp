@@ -68,19 +68,6 @@ QStringList ExportFileAbstractBase::curvesToInclude (const DocumentModelExportFo
   return curvesToInclude;
 }
 
-void ExportFileAbstractBase::destroy2DArray (QVector<QVector<QString*> > &array) const
-{
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileAbstractBase::destroy2DArray";
-
-  int colCount = array.count();
-  int rowCount = array [0].count();
-  for (int row = 0; row < rowCount; row++) {
-    for (int col = 0; col < colCount; col++) {
-      delete array [col] [row];
-    }
-  }
-}
-
 QString ExportFileAbstractBase::gnuplotComment() const
 {
   return QString ("# ");
@@ -38,9 +38,6 @@ protected:
                                CurveConnectAs curveConnectAs1,
                                CurveConnectAs curveConnectAs2) const;
 
-  /// Deallocate memory for array
-  void destroy2DArray (QVector<QVector<QString*> > &array) const;
-
   /// Gnuplot comment delimiter
   QString gnuplotComment() const;
 
@@ -0,0 +1,304 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "ExportColumns.h"
+#include "ExportFileBinary.h"
+#include "Logger.h"
+#include <QDataStream>
+#include <QIODevice>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <qnumeric.h>
+
+const int FLOAT64_HEADER_ALIGNMENT = 8;
+const int NPY_HEADER_ALIGNMENT = 64;
+const int NPY_PREAMBLE_SIZE = 10; // Magic string, version and header length
+
+// Zip archive constants. Entries are stored without compression so only the crc needs to be computed
+const int ZIP_CENTRAL_DIRECTORY_ENTRY_SIZE = 46; // Bytes before the name
+const quint32 ZIP_CENTRAL_DIRECTORY_SIGNATURE = 0x02014b50;
+const quint16 ZIP_DOS_DATE_1980_01_01 = 0x0021;
+const quint32 ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+const int ZIP_END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+const quint16 ZIP_FLAG_UTF8_NAME = 0x0800;
+const quint32 ZIP_LOCAL_HEADER_SIGNATURE = 0x04034b50;
+const int ZIP_LOCAL_HEADER_SIZE = 30; // Bytes before the name
+const qint64 ZIP_MAX_ARCHIVE_SIZE = 0xffffffff; // Sizes and offsets are 32 bits since zip64 records are not written
+const int ZIP_MAX_ENTRIES = 0xffff;
+const quint16 ZIP_METHOD_STORED = 0;
+const quint16 ZIP_VERSION = 20;
+
+static QVector<quint32> crcTable ()
+{
+  // Reflected polynomial of the crc-32 used by zip
+  const quint32 POLYNOMIAL = 0xedb88320;
+
+  QVector<quint32> table (256);
+  for (quint32 n = 0; n < 256; n++) {
+    quint32 c = n;
+    for (int k = 0; k < 8; k++) {
+      c = (c & 1) ? (POLYNOMIAL ^ (c >> 1)) : (c >> 1);
+    }
+    table [n] = c;
+  }
+
+  return table;
+}
+
+static const QVector<quint32> CRC_TABLE = crcTable ();
+
+static quint32 crc32 (const QByteArray &bytes)
+{
+  quint32 c = 0xffffffff;
+  const uchar *data = (const uchar *) bytes.constData ();
+  for (int i = 0; i < bytes.size (); i++) {
+    c = CRC_TABLE [(c ^ data [i]) & 0xff] ^ (c >> 8);
+  }
+
+  return c ^ 0xffffffff;
+}
+
+ExportFileBinary::ExportFileBinary ()
+{
+}
+
+QByteArray ExportFileBinary::npyArray (const QString &shape,
+                                       const QVector<double> &values) const
+{
+  QByteArray bytes = npyHeader (shape);
+
+  QDataStream str (&bytes, QIODevice::WriteOnly | QIODevice::Append);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  for (int i = 0; i < values.count (); i++) {
+    str << values [i];
+  }
+
+  return bytes;
+}
+
+QByteArray ExportFileBinary::npyHeader (const QString &shape) const
+{
+  QByteArray dictionary = QString ("{'descr': '<f8', 'fortran_order': False, 'shape': %1, }")
+                          .arg (shape)
+                          .toLatin1 ();
+
+  // Spaces and a terminating newline pad the header so the data is aligned, as required by the npy format
+  int headerSize = NPY_PREAMBLE_SIZE + dictionary.size () + 1;
+  int padding = (NPY_HEADER_ALIGNMENT - headerSize % NPY_HEADER_ALIGNMENT) % NPY_HEADER_ALIGNMENT;
+  dictionary += QByteArray (padding, ' ');
+  dictionary += '\n';
+
+  QByteArray header ("\x93NUMPY", 6);
+  header += (char) 1; // Major version
+  header += (char) 0; // Minor version
+  header += (char) (dictionary.size () & 0xff);
+  header += (char) ((dictionary.size () >> 8) & 0xff);
+  header += dictionary;
+
+  return header;
+}
+
+QString ExportFileBinary::npzEntryName (const QString &columnName,
+                                        QStringList &entryNamesUsed) const
+{
+  QString base = columnName;
+  base.replace ('/', '_');
+  base.replace ('\\', '_');
+  if (base.isEmpty ()) {
+    base = "column";
+  }
+
+  QString name = base;
+  int suffix = 2;
+  while (entryNamesUsed.contains (name)) {
+    name = QString ("%1_%2")
+           .arg (base)
+           .arg (suffix++);
+  }
+
+  entryNamesUsed << name;
+
+  return name + ".npy";
+}
+
+void ExportFileBinary::writeFloat64 (const ExportColumns &columns,
+                                     QIODevice &device) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileBinary::writeFloat64"
+                              << " columns=" << columns.columnCount ();
+
+  const int BYTES_PER_VALUE = 8;
+
+  QJsonArray columnsJson;
+  qint64 offset = 0;
+  for (int col = 0; col < columns.columnCount (); col++) {
+
+    QJsonObject columnJson;
+    columnJson ["name"] = columns.name (col);
+    columnJson ["rows"] = columns.values (col).count ();
+    columnJson ["offset"] = (double) offset; // Byte offset from the start of the data
+    columnsJson.append (columnJson);
+
+    offset += BYTES_PER_VALUE * columns.values (col).count ();
+  }
+
+  QJsonObject headerJson;
+  headerJson ["format"] = QString ("engauge-float64");
+  headerJson ["byteOrder"] = QString ("little");
+  headerJson ["columns"] = columnsJson;
+
+  QByteArray header = QJsonDocument (headerJson).toJson (QJsonDocument::Compact);
+  int padding = (FLOAT64_HEADER_ALIGNMENT - header.size () % FLOAT64_HEADER_ALIGNMENT) % FLOAT64_HEADER_ALIGNMENT;
+  header += QByteArray (padding, ' ');
+
+  QDataStream str (&device);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  str << (quint64) header.size ();
+  str.writeRawData (header.constData (),
+                    header.size ());
+
+  for (int col = 0; col < columns.columnCount (); col++) {
+    const QVector<double> &values = columns.values (col);
+    for (int row = 0; row < values.count (); row++) {
+      str << values [row];
+    }
+  }
+}
+
+void ExportFileBinary::writeNpy (const ExportColumns &columns,
+                                 QIODevice &device) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileBinary::writeNpy"
+                              << " columns=" << columns.columnCount ();
+
+  int rowCount = columns.rowCountMax ();
+  int colCount = columns.columnCount ();
+
+  device.write (npyHeader (QString ("(%1, %2)")
+                           .arg (rowCount)
+                           .arg (colCount)));
+
+  QDataStream str (&device);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  // Values are streamed straight from the columns in C order, so the values of each row are adjacent
+  for (int row = 0; row < rowCount; row++) {
+    for (int col = 0; col < colCount; col++) {
+      const QVector<double> &column = columns.values (col);
+      str << (row < column.count () ? column [row] : qQNaN ());
+    }
+  }
+}
+
+bool ExportFileBinary::writeNpz (const ExportColumns &columns,
+                                 QIODevice &device) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileBinary::writeNpz"
+                              << " columns=" << columns.columnCount ();
+
+  // Archive size is computed first, since nothing should be written if the archive is beyond the 32 bit limits
+  QStringList entryNamesUsed;
+  qint64 archiveSize = ZIP_END_OF_CENTRAL_DIRECTORY_SIZE;
+  for (int col = 0; col < columns.columnCount (); col++) {
+
+    int nameSize = npzEntryName (columns.name (col),
+                                 entryNamesUsed).toUtf8 ().size ();
+    qint64 dataSize = npyHeader (QString ("(%1,)")
+                                 .arg (columns.values (col).count ())).size () +
+                      (qint64) sizeof (double) * columns.values (col).count ();
+
+    archiveSize += ZIP_LOCAL_HEADER_SIZE + nameSize + dataSize +
+                   ZIP_CENTRAL_DIRECTORY_ENTRY_SIZE + nameSize;
+  }
+
+  if (columns.columnCount () > ZIP_MAX_ENTRIES ||
+      archiveSize >= ZIP_MAX_ARCHIVE_SIZE) {
+
+    LOG4CPP_ERROR_S ((*mainCat)) << "ExportFileBinary::writeNpz"
+                                 << " archiveSize=" << archiveSize
+                                 << " is too large for zip without zip64";
+    return false;
+  }
+
+  QDataStream str (&device);
+  str.setByteOrder (QDataStream::LittleEndian);
+
+  entryNamesUsed.clear ();
+  QByteArray centralDirectory;
+  QDataStream strCentral (&centralDirectory, QIODevice::WriteOnly);
+  strCentral.setByteOrder (QDataStream::LittleEndian);
+
+  quint32 offset = 0;
+  for (int col = 0; col < columns.columnCount (); col++) {
+
+    QByteArray name = npzEntryName (columns.name (col),
+                                    entryNamesUsed).toUtf8 ();
+    QByteArray data = npyArray (QString ("(%1,)")
+                                .arg (columns.values (col).count ()),
+                                columns.values (col));
+    quint32 crc = crc32 (data);
+
+    // Local file header followed by the entry data
+    str << ZIP_LOCAL_HEADER_SIGNATURE
+        << ZIP_VERSION
+        << ZIP_FLAG_UTF8_NAME
+        << ZIP_METHOD_STORED
+        << (quint16) 0 // Time
+        << ZIP_DOS_DATE_1980_01_01
+        << crc
+        << (quint32) data.size () // Compressed size
+        << (quint32) data.size () // Uncompressed size
+        << (quint16) name.size ()
+        << (quint16) 0; // Extra field length
+    str.writeRawData (name.constData (),
+                      name.size ());
+    str.writeRawData (data.constData (),
+                      data.size ());
+
+    // Central directory entry, which points back to the local file header
+    strCentral << ZIP_CENTRAL_DIRECTORY_SIGNATURE
+               << ZIP_VERSION // Version made by
+               << ZIP_VERSION // Version needed
+               << ZIP_FLAG_UTF8_NAME
+               << ZIP_METHOD_STORED
+               << (quint16) 0 // Time
+               << ZIP_DOS_DATE_1980_01_01
+               << crc
+               << (quint32) data.size ()
+               << (quint32) data.size ()
+               << (quint16) name.size ()
+               << (quint16) 0 // Extra field length
+               << (quint16) 0 // Comment length
+               << (quint16) 0 // Disk number
+               << (quint16) 0 // Internal attributes
+               << (quint32) 0 // External attributes
+               << offset;
+    strCentral.writeRawData (name.constData (),
+                             name.size ());
+
+    offset += ZIP_LOCAL_HEADER_SIZE + name.size () + data.size ();
+  }
+
+  str.writeRawData (centralDirectory.constData (),
+                    centralDirectory.size ());
+
+  str << ZIP_END_OF_CENTRAL_DIRECTORY_SIGNATURE
+      << (quint16) 0 // Disk number
+      << (quint16) 0 // Disk with central directory
+      << (quint16) columns.columnCount () // Entries on this disk
+      << (quint16) columns.columnCount () // Entries total
+      << (quint32) centralDirectory.size ()
+      << offset // Central directory starts right after the last entry
+      << (quint16) 0; // Comment length
+
+  return true;
+}
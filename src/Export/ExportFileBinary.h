@@ -0,0 +1,60 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_FILE_BINARY_H
+#define EXPORT_FILE_BINARY_H
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class ExportColumns;
+class QIODevice;
+
+/// Writer for binary export files. Values are written as unformatted little-endian float64 numbers, so neither the
+/// number formatting of text export nor the parsing by downstream tools is needed. Supported formats are:
+/// -# NumPy npy file with one two dimensional array, with one array column per export column and NaN padding
+/// -# NumPy npz file, which is an uncompressed zip archive with one one dimensional npy array per export column
+/// -# Raw float64 file with the columns stored one after another, preceded by a JSON header that gives the name,
+///    row count and byte offset of each column
+class ExportFileBinary
+{
+public:
+  /// Single constructor
+  ExportFileBinary ();
+
+  /// Write raw float64 columns after a JSON header. The file starts with the header size as a little-endian 64 bit
+  /// integer, then the header, padded with spaces so the column data starts on an eight byte boundary
+  void writeFloat64 (const ExportColumns &columns,
+                     QIODevice &device) const;
+
+  /// Write NumPy npy file with a single rows by columns array. Shorter columns are padded with NaN
+  void writeNpy (const ExportColumns &columns,
+                 QIODevice &device) const;
+
+  /// Write NumPy npz file with one array per column. Array names are the column names, made unique if necessary.
+  /// Returns false, without writing anything, if the archive would reach 4 GiB or 65535 entries since zip64
+  /// records are not supported
+  bool writeNpz (const ExportColumns &columns,
+                 QIODevice &device) const;
+
+private:
+
+  // Npy array, given the shape as a python tuple and the values in C order
+  QByteArray npyArray (const QString &shape,
+                       const QVector<double> &values) const;
+
+  // Npy header for float64 values in C order, padded so the data starts on a 64 byte boundary
+  QByteArray npyHeader (const QString &shape) const;
+
+  // Name of the npz entry for a column. Characters that would be treated as directory separators are replaced, and
+  // a suffix is added if the name was already used
+  QString npzEntryName (const QString &columnName,
+                        QStringList &entryNamesUsed) const;
+};
+
+#endif // EXPORT_FILE_BINARY_H
@@ -9,15 +9,19 @@
 #include "Document.h"
 #include "DocumentModelGeneral.h"
 #include "EngaugeAssert.h"
+#include "ExportColumns.h"
 #include "ExportFileFunctions.h"
+#include "ExportFileFunctionsWorker.h"
 #include "ExportLayoutFunctions.h"
 #include "ExportOrdinalsSmooth.h"
 #include "ExportXThetaValuesMergedFunctions.h"
 #include "FormatCoordsUnits.h"
 #include "LinearToLog.h"
 #include "Logger.h"
+#include <qnumeric.h>
 #include <QTextStream>
 #include <QVector>
+#include "RunnableBatch.h"
 #include "Spline.h"
 #include "SplinePair.h"
 #include "Transformation.h"
@@ -42,15 +46,10 @@ void ExportFileFunctions::exportAllPerLineXThetaValuesMerged (const DocumentMode
 {
   LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::exportAllPerLineXThetaValuesMerged";
 
-  int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaValues.count();
-  QVector<QVector<QString*> > yRadiusValues (curveCount, QVector<QString*> (xThetaCount));
-  initializeYRadiusValues (curvesIncluded,
-                           xThetaValues,
-                           yRadiusValues);
+  ExportYRadiusValues yRadiusValues (curvesIncluded.count(),
+                                     xThetaValues.count());
   loadYRadiusValues (modelExportOverride,
                      document,
-                     modelMainWindow,
                      curvesIncluded,
                      transformation,
                      isLogXTheta,
@@ -68,7 +67,6 @@ void ExportFileFunctions::exportAllPerLineXThetaValuesMerged (const DocumentMode
                              yRadiusValues,
                              delimiter,
                              str);
-  destroy2DArray (yRadiusValues);
 }
 
 void ExportFileFunctions::exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
@@ -98,14 +96,10 @@ void ExportFileFunctions::exportOnePerLineXThetaValuesMerged (const DocumentMode
     QString curveIncluded = *itr;
     QStringList curvesIncluded (curveIncluded);
 
-    int xThetaCount = xThetaValues.count();
-    QVector<QVector<QString*> > yRadiusValues (CURVE_COUNT, QVector<QString*> (xThetaCount));
-    initializeYRadiusValues (curvesIncluded,
-                             xThetaValues,
-                             yRadiusValues);
+    ExportYRadiusValues yRadiusValues (CURVE_COUNT,
+                                       xThetaValues.count());
     loadYRadiusValues (modelExportOverride,
                        document,
-                       modelMainWindow,
                        curvesIncluded,
                        transformation,
                        isLogXTheta,
@@ -122,7 +116,68 @@ void ExportFileFunctions::exportOnePerLineXThetaValuesMerged (const DocumentMode
                                yRadiusValues,
                                delimiter,
                                str);
-    destroy2DArray (yRadiusValues);
+  }
+}
+
+void ExportFileFunctions::exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                           const Document &document,
+                                           const Transformation &transformation,
+                                           ExportColumns &columns) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::exportToColumns";
+
+  // Log coordinates must be temporarily transformed to linear coordinates
+  bool isLogXTheta = (document.modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogYRadius = (document.modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+
+  // Identify curves to be included
+  QStringList curvesIncluded = curvesToInclude (modelExportOverride,
+                                                document,
+                                                document.curvesGraphsNames(),
+                                                CONNECT_AS_FUNCTION_SMOOTH,
+                                                CONNECT_AS_FUNCTION_STRAIGHT);
+
+  // Get x/theta values to be used
+  ExportValuesXOrY xThetaValuesMerged = gatherXThetaValuesMerged (modelExportOverride,
+                                                                  document,
+                                                                  curvesIncluded,
+                                                                  transformation);
+
+  // Skip if every curve was a relation
+  if (xThetaValuesMerged.count() > 0) {
+
+    ExportYRadiusValues yRadiusValues (curvesIncluded.count(),
+                                       xThetaValuesMerged.count());
+    loadYRadiusValues (modelExportOverride,
+                       document,
+                       curvesIncluded,
+                       transformation,
+                       isLogXTheta,
+                       isLogYRadius,
+                       xThetaValuesMerged,
+                       yRadiusValues);
+
+    // Same rows as the all-per-line text layout, with NaN where a curve has no value. The layout setting only affects
+    // text, since one table with a shared x/theta column holds every curve
+    QVector<double> xThetaColumn;
+    QVector<QVector<double> > yRadiusColumns (curvesIncluded.count());
+    for (int row = 0; row < xThetaValuesMerged.count(); row++) {
+      if (yRadiusValues.rowHasAtLeastOneValue (row)) {
+        xThetaColumn << xThetaValuesMerged.at (row);
+        for (int col = 0; col < curvesIncluded.count(); col++) {
+          yRadiusColumns [col] << (yRadiusValues.hasValue (col, row) ?
+                                   yRadiusValues.yRadius (col, row) :
+                                   qQNaN ());
+        }
+      }
+    }
+
+    columns.addColumn (modelExportOverride.xLabel(),
+                       xThetaColumn);
+    for (int col = 0; col < curvesIncluded.count(); col++) {
+      columns.addColumn (curvesIncluded.at (col),
+                         yRadiusColumns [col]);
+    }
   }
 }
 
@@ -150,17 +205,10 @@ void ExportFileFunctions::exportToFile (const DocumentModelExportFormat &modelEx
                                                    modelExportOverride.header() == EXPORT_HEADER_GNUPLOT);
 
   // Get x/theta values to be used
-  CallbackGatherXThetaValuesFunctions ftor (modelExportOverride,
-                                            curvesIncluded,
-                                            transformation);
-  Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
-                                                                                                     &CallbackGatherXThetaValuesFunctions::callback);
-  document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
-
-  ExportXThetaValuesMergedFunctions exportXTheta (modelExportOverride,
-                                                  ftor.xThetaValuesRaw(),
-                                                  transformation);
-  ExportValuesXOrY xThetaValuesMerged = exportXTheta.xThetaValues ();
+  ExportValuesXOrY xThetaValuesMerged = gatherXThetaValuesMerged (modelExportOverride,
+                                                                  document,
+                                                                  curvesIncluded,
+                                                                  transformation);
 
   // Skip if every curve was a relation
   if (xThetaValuesMerged.count() > 0) {
@@ -192,163 +240,228 @@ void ExportFileFunctions::exportToFile (const DocumentModelExportFormat &modelEx
   }
 }
 
-void ExportFileFunctions::initializeYRadiusValues (const QStringList &curvesIncluded,
-                                                   const ExportValuesXOrY &xThetaValuesMerged,
-                                                   QVector<QVector<QString*> > &yRadiusValues) const
+ExportValuesXOrY ExportFileFunctions::gatherXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
+                                                                const Document &document,
+                                                                const QStringList &curvesIncluded,
+                                                                const Transformation &transformation) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::initializeYRadiusValues";
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::gatherXThetaValuesMerged";
 
-  // Initialize every entry with empty string
-  int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaValuesMerged.count();
-  for (int row = 0; row < xThetaCount; row++) {
-    for (int col = 0; col < curveCount; col++) {
-      yRadiusValues [col] [row] = new QString;
-    }
-  }
+  CallbackGatherXThetaValuesFunctions ftor (modelExportOverride,
+                                            curvesIncluded,
+                                            transformation);
+  Functor2wRet<const QString &, const Point &, CallbackSearchReturn> ftorWithCallback = functor_ret (ftor,
+                                                                                                     &CallbackGatherXThetaValuesFunctions::callback);
+  document.iterateThroughCurvesPointsGraphs(ftorWithCallback);
+
+  ExportXThetaValuesMergedFunctions exportXTheta (modelExportOverride,
+                                                  ftor.xThetaValuesRaw(),
+                                                  transformation);
+  return exportXTheta.xThetaValues ();
 }
 
-double ExportFileFunctions::linearlyInterpolate (const Points &points,
-                                                 double xThetaValue,
-                                                 const Transformation &transformation) const
+void ExportFileFunctions::linearlyInterpolate (const Points &points,
+                                               const ExportValuesXOrY &xThetaValues,
+                                               const Transformation &transformation,
+                                               QVector<double> &yRadiusValues) const
 {
-  //  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::linearlyInterpolate";
-
-  // If point is within the range of the function points then interpolation will be used, otherwise
-  // extrapolation will be used
-  double yRadius = 0;
-  QPointF posGraphBefore; // Not set until ip=1
-  bool foundIt = false;
-  for (int ip = 0; !foundIt && (ip < points.count()); ip++) {
-
-    const Point &point = points.at (ip);
-    QPointF posGraph;
-    transformation.transformScreenToRawGraph (point.posScreen(),
-                                              posGraph);
-
-    // Cases where we have found it at this point in the code
-    // (1) interpolation case where (xBefore < xThetaValue < xAfter)
-    // (2) extrapolation case where (xThetaValue < xBefore < xAfter and ip=0) for which we delay finding it until ip=1 so we have
-    //     two points for extrapolating. This case is why we have the subtle test for ip>0 in the next line
-    if (xThetaValue <= posGraph.x() && (ip > 0)) {
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::linearlyInterpolate";
 
-      foundIt = true;
+  int N = points.count();
+  if (N == 0) {
 
-      // Case 1 comments: xThetaValue is between posGraphBefore and posGraph. Note that if posGraph.x()=posGraphBefore.x() then
-      // previous iteration of loop would have been used for interpolation, and then the loop was exited. Range of s is 0<s<1
-      // Case 2 comments: Range of s is s<0
-      double s = (xThetaValue - posGraphBefore.x()) / (posGraph.x() - posGraphBefore.x());
-      yRadius = (1.0 -s) * posGraphBefore.y() + s * posGraph.y();
+    // Nothing to interpolate. Not asserted since this can run in a worker thread
+    yRadiusValues.clear ();
+    return;
+  }
 
-      break;
-    }
+  yRadiusValues.resize (xThetaValues.count());
 
-    posGraphBefore = posGraph;
+  // Every point is transformed once, rather than once per x/theta value
+  QVector<double> xGraph (N), yGraph (N);
+  for (int ip = 0; ip < N; ip++) {
+    const QPointF &posScreen = points.at (ip).posScreen();
+    xGraph [ip] = posScreen.x();
+    yGraph [ip] = posScreen.y();
   }
+  transformation.transformScreenToRawGraph (N,
+                                            xGraph.constData (),
+                                            yGraph.constData (),
+                                            xGraph.data (),
+                                            yGraph.data ());
+
+  // For each x/theta value the segment ending at the first point ip>0 with xThetaValue <= x(ip) is used. Point ip=0 is
+  // skipped so there are two points for extrapolating when xThetaValue is before the first point. That ip never decreases
+  // as xThetaValue increases, so sorted x/theta values are handled by one merge walk through the points. The walk
+  // restarts if a value is out of order
+  int ip = 1;
+  for (int row = 0; row < xThetaValues.count(); row++) {
 
-  if (!foundIt) {
+    double xThetaValue = xThetaValues.at (row);
 
-    if (points.count() > 1) {
+    if ((row > 0) &&
+        !(xThetaValue >= xThetaValues.at (row - 1))) {
+      ip = 1;
+    }
 
-      // Extrapolation will be used since point is out of the range of the function points. Specifically, it is greater than the
-      // last x value in the function. Range of s is 1<s
-      int N = points.count();
-      const Point &pointLast = points.at (N - 1);
-      const Point &pointBefore = points.at (N - 2);
-      QPointF posGraphLast;
-      transformation.transformScreenToRawGraph (pointLast.posScreen(),
-                                                posGraphLast);
-      transformation.transformScreenToRawGraph (pointBefore.posScreen(),
-                                                posGraphBefore);
-      double s = (xThetaValue - posGraphBefore.x()) / (posGraphLast.x() - posGraphBefore.x());
-      yRadius = (1.0 - s) * posGraphBefore.y() + s * posGraphLast.y();
+    while ((ip < N) &&
+           !(xThetaValue <= xGraph [ip])) {
+      ++ip;
+    }
 
-    } else if (points.count() == 1) {
+    double yRadius;
+    if (N == 1) {
 
       // Just use the single point
-      yRadius = posGraphBefore.y();
+      yRadius = yGraph [0];
 
     } else {
 
-      ENGAUGE_ASSERT (false);
+      // If xThetaValue is greater than every point then extrapolation uses the last two points. The range of s is s<0
+      // when extrapolating before the first point, 0<s<1 when interpolating, and 1<s when extrapolating after the last point
+      int ipAfter = qMin (ip, N - 1);
+      double s = (xThetaValue - xGraph [ipAfter - 1]) / (xGraph [ipAfter] - xGraph [ipAfter - 1]);
+      yRadius = (1.0 - s) * yGraph [ipAfter - 1] + s * yGraph [ipAfter];
 
     }
-  }
 
-  return yRadius;
+    yRadiusValues [row] = yRadius;
+  }
 }
 
 void ExportFileFunctions::loadYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
                                              const Document &document,
-                                             const MainWindowModel &modelMainWindow,
                                              const QStringList &curvesIncluded,
                                              const Transformation &transformation,
                                              bool isLogXTheta,
                                              bool isLogYRadius,
                                              const ExportValuesXOrY &xThetaValues,
-                                             QVector<QVector<QString*> > &yRadiusValues) const
+                                             ExportYRadiusValues &yRadiusValues) const
 {
   LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValues";
 
-  // Loop through curves
   int curveCount = curvesIncluded.count();
+
+  // Preconditions are checked here in the GUI thread since the per-curve computations, which may run in worker threads,
+  // cannot assert or log
+  ENGAUGE_ASSERT (yRadiusValues.curveCount() == curveCount);
+  ENGAUGE_ASSERT (yRadiusValues.xThetaCount() == xThetaValues.count());
   for (int col = 0; col < curveCount; col++) {
+    ENGAUGE_CHECK_PTR (document.curveForCurveName (curvesIncluded.at (col)));
+  }
 
-    const QString curveName = curvesIncluded.at (col);
+  QList<bool> successes;
+  if (curveCount == 1) {
 
-    const Curve *curve = document.curveForCurveName (curveName);
-    Points points = curve->points (); // These points will be linearized below if either coordinate is log
+    // No benefit from another thread
+    successes << loadYRadiusValuesForCurve (modelExportOverride,
+                                            document,
+                                            curvesIncluded.at (0),
+                                            transformation,
+                                            isLogXTheta,
+                                            isLogYRadius,
+                                            xThetaValues,
+                                            0,
+                                            yRadiusValues);
 
-    if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_RAW) {
+  } else {
 
-      // No interpolation. Raw points
-      loadYRadiusValuesForCurveRaw (document.modelCoords(),
-                                    document.modelGeneral(),
-                                    modelMainWindow,
-                                    points,
-                                    xThetaValues,
-                                    transformation,
-                                    yRadiusValues [col]);
-    } else {
+    // Curves are computed concurrently. Each curve has its own column, and the computations are the same as
+    // when done one curve at a time, so the output is the same
+    RunnableBatch batch;
+    QList<ExportFileFunctionsWorker*> workers;
+    for (int col = 0; col < curveCount; col++) {
 
-      // Interpolation
-      if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_FUNCTION_SMOOTH) {
+      ExportFileFunctionsWorker *worker = new ExportFileFunctionsWorker (*this,
+                                                                         modelExportOverride,
+                                                                         document,
+                                                                         curvesIncluded.at (col),
+                                                                         transformation,
+                                                                         isLogXTheta,
+                                                                         isLogYRadius,
+                                                                         xThetaValues,
+                                                                         col,
+                                                                         yRadiusValues);
+      workers << worker;
+      batch.start (worker);
+    }
 
-        loadYRadiusValuesForCurveInterpolatedSmooth (document.modelCoords(),
-                                                     document.modelGeneral(),
-                                                     modelMainWindow,
-                                                     points,
-                                                     xThetaValues,
-                                                     transformation,
-                                                     isLogXTheta,
-                                                     isLogYRadius,
-                                                     yRadiusValues [col]);
+    batch.waitForDone ();
 
-      } else {
+    for (int col = 0; col < curveCount; col++) {
+      successes << workers.at (col)->success ();
+    }
+  }
 
-        loadYRadiusValuesForCurveInterpolatedStraight (document.modelCoords(),
-                                                       document.modelGeneral(),
-                                                       modelMainWindow,
-                                                       points,
-                                                       xThetaValues,
-                                                       transformation,
-                                                       yRadiusValues [col]);
-      }
+  // Failures are reported here rather than in the worker threads
+  for (int col = 0; col < curveCount; col++) {
+    if (!successes.at (col)) {
+      LOG4CPP_ERROR_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValues failed for curve="
+                                   << curvesIncluded.at (col).toLatin1().data();
+    }
+  }
+}
+
+bool ExportFileFunctions::loadYRadiusValuesForCurve (const DocumentModelExportFormat &modelExportOverride,
+                                                     const Document &document,
+                                                     const QString &curveName,
+                                                     const Transformation &transformation,
+                                                     bool isLogXTheta,
+                                                     bool isLogYRadius,
+                                                     const ExportValuesXOrY &xThetaValues,
+                                                     int col,
+                                                     ExportYRadiusValues &yRadiusValues) const
+{
+  const Curve *curve = document.curveForCurveName (curveName);
+  if (curve == 0) {
+    return false;
+  }
+
+  Points points = curve->points (); // These points will be linearized below if either coordinate is log
+
+  if (modelExportOverride.pointsSelectionFunctions() == EXPORT_POINTS_SELECTION_FUNCTIONS_RAW) {
+
+    // No interpolation. Raw points
+    loadYRadiusValuesForCurveRaw (points,
+                                  xThetaValues,
+                                  transformation,
+                                  col,
+                                  yRadiusValues);
+  } else {
+
+    // Interpolation
+    if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_FUNCTION_SMOOTH) {
+
+      loadYRadiusValuesForCurveInterpolatedSmooth (points,
+                                                   xThetaValues,
+                                                   transformation,
+                                                   isLogXTheta,
+                                                   isLogYRadius,
+                                                   col,
+                                                   yRadiusValues);
+
+    } else {
+
+      loadYRadiusValuesForCurveInterpolatedStraight (points,
+                                                     xThetaValues,
+                                                     transformation,
+                                                     col,
+                                                     yRadiusValues);
     }
   }
+
+  return true;
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                                       const DocumentModelGeneral &modelGeneral,
-                                                                       const MainWindowModel &modelMainWindow,
-                                                                       const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Points &points,
                                                                        const ExportValuesXOrY &xThetaValues,
                                                                        const Transformation &transformation,
                                                                        bool isLogXTheta,
                                                                        bool isLogYRadius,
-                                                                       QVector<QString*> &yRadiusValues) const
+                                                                       int col,
+                                                                       ExportYRadiusValues &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth";
 
   // Convert screen coordinates to graph coordinates, in vectors suitable for spline fitting
   vector<double> t;
@@ -362,19 +475,9 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Doc
                                                     t,
                                                     xy);
 
-  // Formatting
-  FormatCoordsUnits format;
-  QString dummyXThetaOut;
-
-  if (points.count() == 0) {
-
-    // Since there are no values, leave the field empty
-    for (int row = 0; row < xThetaValues.count(); row++) {
-      *(yRadiusValues [row]) = "";
-    }
-
-  } else if (points.count() == 1 ||
-             points.count() == 2) {
+  // If there are no points then there are no values, so the fields are left empty
+  if (points.count() == 1 ||
+      points.count() == 2) {
 
     // Apply the single value everywhere (N=1) or do linear interpolation (N=2)
     for (int row = 0; row < xThetaValues.count(); row++) {
@@ -396,24 +499,14 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Doc
           yRadius = (1.0 - s) * y0 + s * y1;
         }
       }
-      format.unformattedToFormatted (xTheta,
-                                     yRadius,
-                                     modelCoords,
-                                     modelGeneral,
-                                     modelMainWindow,
-                                     dummyXThetaOut,
-                                     *(yRadiusValues [row]),
-                                     transformation);
+      yRadiusValues.setValue (col,
+                              row,
+                              xTheta,
+                              yRadius);
     }
 
   } else {
 
-    // Iteration accuracy versus number of iterations 8->256, 10->1024, 12->4096. Single pixel accuracy out of
-    // typical image size of 1024x1024 means around 10 iterations gives decent accuracy for numbers much bigger
-    // than 1. A value of 12 gave some differences in the least significant figures of numbers like 10^-3 in
-    // the regression tests. Toggling between 30 and 32 made no difference in the regression tests.
-    const int MAX_ITERATIONS = 32;
-
     // Spline class requires at least one point
     if (xy.size() > 0) {
 
@@ -421,78 +514,74 @@ void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedSmooth (const Doc
       Spline spline (t,
                      xy);
 
-      // Get value at desired points
+      LinearToLog linearToLog;
+
+      // Get values at desired points. The x/theta values are sorted, so all of them are found in one pass
+      vector<double> xLinear (xThetaValues.count());
       for (int row = 0; row < xThetaValues.count(); row++) {
+        xLinear [row] = linearToLog.linearize (xThetaValues.at (row), isLogXTheta);
+      }
 
-        double xTheta = xThetaValues.at (row);
+      vector<SplinePair> splinePairsFound;
+      spline.findSplinePairsForFunctionX (xLinear,
+                                          splinePairsFound);
 
-        LinearToLog linearToLog;
+      for (int row = 0; row < xThetaValues.count(); row++) {
 
-        SplinePair splinePairFound = spline.findSplinePairForFunctionX (linearToLog.linearize (xTheta, isLogXTheta),
-                                                                        MAX_ITERATIONS);
-        double yRadius = linearToLog.delinearize (splinePairFound.y (),
+        double xTheta = xThetaValues.at (row);
+        double yRadius = linearToLog.delinearize (splinePairsFound [row].y (),
                                                   isLogYRadius);
 
-        // Save y/radius value for this row into yRadiusValues, after appropriate formatting
-        QString dummyXThetaOut;
-        format.unformattedToFormatted (xTheta,
-                                       yRadius,
-                                       modelCoords,
-                                       modelGeneral,
-                                       modelMainWindow,
-                                       dummyXThetaOut,
-                                       *(yRadiusValues [row]),
-                                       transformation);
+        // Save y/radius value for this row into yRadiusValues. Formatting is delayed until output
+        yRadiusValues.setValue (col,
+                                row,
+                                xTheta,
+                                yRadius);
       }
     }
   }
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                                         const DocumentModelGeneral &modelGeneral,
-                                                                         const MainWindowModel &modelMainWindow,
-                                                                         const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight (const Points &points,
                                                                          const ExportValuesXOrY &xThetaValues,
                                                                          const Transformation &transformation,
-                                                                         QVector<QString*> &yRadiusValues) const
+                                                                         int col,
+                                                                         ExportYRadiusValues &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveInterpolatedStraight";
 
-  FormatCoordsUnits format;
-
-  // Get value at desired points
-  for (int row = 0; row < xThetaValues.count(); row++) {
+  // If there are no points then there are no values, so the fields are left empty
+  if (points.count() == 0) {
+    return;
+  }
 
-    double xThetaValue = xThetaValues.at (row);
+  QVector<double> yRadiusInterpolated;
+  linearlyInterpolate (points,
+                       xThetaValues,
+                       transformation,
+                       yRadiusInterpolated);
 
-    double yRadius = linearlyInterpolate (points,
-                                          xThetaValue,
-                                          transformation);
-
-    // Save y/radius value for this row into yRadiusValues, after appropriate formatting
-    QString dummyXThetaOut;
-    format.unformattedToFormatted (xThetaValue,
-                                   yRadius,
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   dummyXThetaOut,
-                                   *(yRadiusValues [row]),
-                                   transformation);
+  // Save y/radius value for each row into yRadiusValues. Formatting is delayed until output
+  for (int row = 0; row < xThetaValues.count(); row++) {
+    yRadiusValues.setValue (col,
+                            row,
+                            xThetaValues.at (row),
+                            yRadiusInterpolated [row]);
   }
 }
 
-void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                                        const DocumentModelGeneral &modelGeneral,
-                                                        const MainWindowModel &modelMainWindow,
-                                                        const Points &points,
+void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const Points &points,
                                                         const ExportValuesXOrY &xThetaValues,
                                                         const Transformation &transformation,
-                                                        QVector<QString*> &yRadiusValues) const
+                                                        int col,
+                                                        ExportYRadiusValues &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveRaw";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileFunctions::loadYRadiusValuesForCurveRaw";
 
-  FormatCoordsUnits format;
+  // No row can receive a value
+  if (xThetaValues.count() == 0) {
+    return;
+  }
 
   // Since the curve points may be a subset of xThetaValues (in which case the non-applicable xThetaValues will have
   // blanks for the yRadiusValues), we iterate over the smaller set
@@ -523,16 +612,11 @@ void ExportFileFunctions::loadYRadiusValuesForCurveRaw (const DocumentModelCoord
       }
     }
 
-    // Save y/radius value for this row into yRadiusValues, after appropriate formatting
-    QString dummyXThetaOut;
-    format.unformattedToFormatted (posGraph.x(),
-                                   posGraph.y(),
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   dummyXThetaOut,
-                                   *(yRadiusValues [rowClosest]),
-                                   transformation);
+    // Save y/radius value for this row into yRadiusValues. Formatting is delayed until output
+    yRadiusValues.setValue (col,
+                            rowClosest,
+                            posGraph.x(),
+                            posGraph.y());
   }
 }
 
@@ -543,7 +627,7 @@ void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFo
                                                      const QStringList &curvesIncluded,
                                                      const ExportValuesXOrY &xThetaValuesMerged,
                                                      const Transformation &transformation,
-                                                     QVector<QVector<QString*> > &yRadiusValues,
+                                                     const ExportYRadiusValues &yRadiusValues,
                                                      const QString &delimiter,
                                                      QTextStream &str) const
 {
@@ -567,50 +651,45 @@ void ExportFileFunctions::outputXThetaYRadiusValues (const DocumentModelExportFo
   FormatCoordsUnits format;
   const double DUMMY_Y_RADIUS = 1.0;
 
+  // Each row is formatted into the same buffers and then streamed, so only one row of strings exists at a time
+  QString line, xThetaString, yRadiusString, dummyString;
+
   for (int row = 0; row < xThetaValuesMerged.count(); row++) {
 
-    if (rowHasAtLeastOneYRadiusEntry (yRadiusValues,
-                                      row)) {
+    if (yRadiusValues.rowHasAtLeastOneValue (row)) {
 
       double xTheta = xThetaValuesMerged.at (row);
 
       // Output x/theta value for this row
-      QString xThetaString, yRadiusString;
       format.unformattedToFormatted (xTheta,
                                      DUMMY_Y_RADIUS,
                                      modelCoords,
                                      modelGeneral,
                                      modelMainWindow,
                                      xThetaString,
-                                     yRadiusString,
+                                     dummyString,
                                      transformation);
-      str << xThetaString;
-
-      for (int col = 0; col < yRadiusValues.count(); col++) {
-
-        str << delimiter << *(yRadiusValues [col] [row]);
+      line = xThetaString;
+
+      for (int col = 0; col < yRadiusValues.curveCount(); col++) {
+
+        line += delimiter;
+
+        if (yRadiusValues.hasValue (col, row)) {
+          format.unformattedToFormatted (yRadiusValues.xTheta (col, row),
+                                         yRadiusValues.yRadius (col, row),
+                                         modelCoords,
+                                         modelGeneral,
+                                         modelMainWindow,
+                                         dummyString,
+                                         yRadiusString,
+                                         transformation);
+          line += yRadiusString;
+        }
       }
 
-      str << "\n";
-    }
-  }
-}
-
-bool ExportFileFunctions::rowHasAtLeastOneYRadiusEntry (const QVector<QVector<QString*> > &yRadiusValues,
-                                                        int row) const
-{
-  bool hasEntry = false;
-
-  for (int col = 0; col < yRadiusValues.count(); col++) {
-
-    QString entry = *(yRadiusValues [col] [row]);
-    if (!entry.isEmpty()) {
-
-      hasEntry = true;
-      break;
-
+      line += "\n";
+      str << line;
     }
   }
-
-  return hasEntry;
 }
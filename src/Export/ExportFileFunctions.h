@@ -9,6 +9,7 @@
 
 #include "ExportFileAbstractBase.h"
 #include "ExportValuesXOrY.h"
+#include "ExportYRadiusValues.h"
 #include <QStringList>
 #include <QVector>
 
@@ -16,6 +17,7 @@ class Document;
 class DocumentModelCoords;
 class DocumentModelExportFormat;
 class DocumentModelGeneral;
+class ExportColumns;
 class MainWindowModel;
 class QTextStream;
 class Transformation;
@@ -26,10 +28,20 @@ class ExportFileFunctions : public ExportFileAbstractBase
   // For unit testing
   friend class TestExport;
 
+  // Computes one curve in loadYRadiusValues
+  friend class ExportFileFunctionsWorker;
+
 public:
   /// Single constructor.
   ExportFileFunctions();
 
+  /// Export the unformatted values of the function curves as columns, for binary export. The first column has the
+  /// x/theta values, followed by one y/radius column per curve, using the same x/theta values as exportToFile
+  void exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                        const Document &document,
+                        const Transformation &transformation,
+                        ExportColumns &columns) const;
+
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
   /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
   void exportToFile (const DocumentModelExportFormat &modelExportOverride,
@@ -61,50 +73,58 @@ private:
                                            bool isLogYRadius,
                                            QTextStream &str) const;
 
-  /// Allocate a 2D y/radius array indexed by (included) curve and x/theta.
-  /// Array rows and columns are set up so yRadiusValues[N] gives vector for Nth curve. Values are strings
-  /// so non-applicable entries can be blank
-  void initializeYRadiusValues (const QStringList &curvesIncluded,
-                                const ExportValuesXOrY &xThetaValuesMerged,
-                                QVector<QVector<QString*> > &yRadiusValues) const;
+  /// Union of the x/theta values of the included curves, or the values at the configured interval, depending on the
+  /// settings
+  ExportValuesXOrY gatherXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
+                                             const Document &document,
+                                             const QStringList &curvesIncluded,
+                                             const Transformation &transformation) const;
 
-  double linearlyInterpolate (const Points &points,
-                              double xThetaValue,
-                              const Transformation &transformation) const;
+  /// Linearly interpolate, or extrapolate, the y/radius value of the points at each x/theta value. This is fastest when
+  /// the x/theta values are sorted. No values are returned if there are no points
+  void linearlyInterpolate (const Points &points,
+                            const ExportValuesXOrY &xThetaValues,
+                            const Transformation &transformation,
+                            QVector<double> &yRadiusValues) const;
+  /// Load the y/radius values of every curve. Curves are computed concurrently
   void loadYRadiusValues (const DocumentModelExportFormat &modelExport,
                           const Document &document,
-                          const MainWindowModel &modelMainWindow,
                           const QStringList &curvesIncluded,
                           const Transformation &transformation,
                           bool isLogXTheta,
                           bool isLogYRadius,
                           const ExportValuesXOrY &xThetaValues,
-                          QVector<QVector<QString*> > &yRadiusValues) const;
-  void loadYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                    const DocumentModelGeneral &modelGeneral,
-                                                    const MainWindowModel &modelMainWindow,
-                                                    const Points &points,
+                          ExportYRadiusValues &yRadiusValues) const;
+  /// Load the y/radius values of one curve. This can run in a worker thread, so it neither asserts nor logs. Returns
+  /// false if the curve does not exist
+  bool loadYRadiusValuesForCurve (const DocumentModelExportFormat &modelExport,
+                                  const Document &document,
+                                  const QString &curveName,
+                                  const Transformation &transformation,
+                                  bool isLogXTheta,
+                                  bool isLogYRadius,
+                                  const ExportValuesXOrY &xThetaValues,
+                                  int col,
+                                  ExportYRadiusValues &yRadiusValues) const;
+  void loadYRadiusValuesForCurveInterpolatedSmooth (const Points &points,
                                                     const ExportValuesXOrY &xThetaValues,
                                                     const Transformation &transformation,
                                                     bool isLogXTheta,
                                                     bool isLogYRadius,
-                                                    QVector<QString*> &yRadiusValues) const;
-  void loadYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                      const DocumentModelGeneral &modelGeneral,
-                                                      const MainWindowModel &modelMainWindow,
-                                                      const Points &points,
+                                                    int col,
+                                                    ExportYRadiusValues &yRadiusValues) const;
+  void loadYRadiusValuesForCurveInterpolatedStraight (const Points &points,
                                                       const ExportValuesXOrY &xThetaValues,
                                                       const Transformation &transformation,
-                                                      QVector<QString*> &yRadiusValues) const;
-  void loadYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                     const DocumentModelGeneral &modelGeneral,
-                                     const MainWindowModel &modelMainWindow,
-                                     const Points &points,
+                                                      int col,
+                                                      ExportYRadiusValues &yRadiusValues) const;
+  void loadYRadiusValuesForCurveRaw (const Points &points,
                                      const ExportValuesXOrY &xThetaValues,
                                      const Transformation &transformation,
-                                     QVector<QString*> &yRadiusValues) const;
+                                     int col,
+                                     ExportYRadiusValues &yRadiusValues) const;
 
-  /// Output 2D y/radius array along with x/theta vector in first column
+  /// Output y/radius table along with x/theta vector in first column. Values are formatted one row at a time
   void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
                                   const DocumentModelCoords &modelCoords,
                                   const DocumentModelGeneral &modelGeneral,
@@ -112,13 +132,9 @@ private:
                                   const QStringList &curvesIncluded,
                                   const ExportValuesXOrY &xThetaValuesMerged,
                                   const Transformation &transformation,
-                                  QVector<QVector<QString*> > &yRadiusValues,
+                                  const ExportYRadiusValues &yRadiusValues,
                                   const QString &delimiter,
                                   QTextStream &str) const;
-  // Only include rows that have at least one y/radius entry. This check is required when outputing one curve per row
-  // since the union of all x/theta values is applied to each curve
-  bool rowHasAtLeastOneYRadiusEntry (const QVector<QVector<QString*> > &yRadiusValues,
-                                     int row) const;
 };
 
 #endif // EXPORT_FILE_FUNCTIONS_H
@@ -0,0 +1,60 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_FILE_FUNCTIONS_WORKER_H
+#define EXPORT_FILE_FUNCTIONS_WORKER_H
+
+#include "ExportValuesXOrY.h"
+#include <QRunnable>
+#include <QString>
+
+class Document;
+class DocumentModelExportFormat;
+class ExportFileFunctions;
+class ExportYRadiusValues;
+class Transformation;
+
+/// Runnable that computes the y/radius values of one curve for ExportFileFunctions::loadYRadiusValues. Each worker
+/// writes only the column of its own curve, so the workers for all curves can run concurrently. Since this runs outside
+/// of the GUI thread, failures are reported through success rather than asserted
+class ExportFileFunctionsWorker : public QRunnable
+{
+public:
+  /// Single constructor
+  ExportFileFunctionsWorker (const ExportFileFunctions &exportFile,
+                             const DocumentModelExportFormat &modelExportOverride,
+                             const Document &document,
+                             const QString &curveName,
+                             const Transformation &transformation,
+                             bool isLogXTheta,
+                             bool isLogYRadius,
+                             const ExportValuesXOrY &xThetaValues,
+                             int col,
+                             ExportYRadiusValues &yRadiusValues);
+
+  /// Compute the values of this curve
+  virtual void run ();
+
+  /// True if run computed the values. Only valid after run has finished
+  bool success () const;
+
+private:
+  ExportFileFunctionsWorker ();
+
+  const ExportFileFunctions &m_exportFile;
+  const DocumentModelExportFormat &m_modelExportOverride;
+  const Document &m_document;
+  QString m_curveName;
+  const Transformation &m_transformation;
+  bool m_isLogXTheta;
+  bool m_isLogYRadius;
+  const ExportValuesXOrY &m_xThetaValues;
+  int m_col;
+  ExportYRadiusValues &m_yRadiusValues;
+  bool m_success;
+};
+
+#endif // EXPORT_FILE_FUNCTIONS_WORKER_H
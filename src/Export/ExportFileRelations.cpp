@@ -8,7 +8,9 @@
 #include "Document.h"
 #include "DocumentModelGeneral.h"
 #include "EngaugeAssert.h"
+#include "ExportColumns.h"
 #include "ExportFileRelations.h"
+#include "ExportFileRelationsWorker.h"
 #include "ExportLayoutFunctions.h"
 #include "ExportOrdinalsSmooth.h"
 #include "ExportOrdinalsStraight.h"
@@ -18,6 +20,7 @@
 #include <qmath.h>
 #include <QTextStream>
 #include <QVector>
+#include "RunnableBatch.h"
 #include "Spline.h"
 #include "SplinePair.h"
 #include "Transformation.h"
@@ -43,143 +46,32 @@ void ExportFileRelations::exportAllPerLineXThetaValuesMerged (const DocumentMode
 {
   LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::exportAllPerLineXThetaValuesMerged";
 
-  int maxColumnSize = maxColumnSizeAllocation (modelExportOverride,
-                                               document,
-                                               transformation,
-                                               isLogXTheta,
-                                               isLogYRadius,
-                                               curvesIncluded);
-
-  // Skip if every curve was a function
-  if (maxColumnSize > 0) {
-
-    if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_INTERPOLATE) {
-
-      exportAllPerLineXThetaValuesMergedMultiplePass (maxColumnSize,
-                                                      modelExportOverride,
-                                                      document,
-                                                      modelMainWindow,
-                                                      curvesIncluded,
-                                                      delimiter,
-                                                      transformation,
-                                                      isLogXTheta,
-                                                      isLogYRadius,
-                                                      str);
-
-    } else {
-
-      exportAllPerLineXThetaValuesMergedOnePass (maxColumnSize,
-                                                 modelExportOverride,
-                                                 document,
-                                                 modelMainWindow,
-                                                 curvesIncluded,
-                                                 delimiter,
-                                                 transformation,
-                                                 isLogXTheta,
-                                                 isLogYRadius,
-                                                 str);
-    }
-  }
-}
-
-void ExportFileRelations::exportAllPerLineXThetaValuesMergedMultiplePass (int maxColumnSize,
-                                                                          const DocumentModelExportFormat &modelExportOverride,
-                                                                          const Document &document,
-                                                                          const MainWindowModel &modelMainWindow,
-                                                                          const QStringList &curvesIncluded,
-                                                                          const QString &delimiter,
-                                                                          const Transformation &transformation,
-                                                                          bool isLogXTheta,
-                                                                          bool isLogYRadius,
-                                                                          QTextStream &str) const
-{
   // For interpolation of relations in general a single set of x/theta values cannot be created that work for every
   // relation curve, since one curve may have M y/radius values for a specific x/radius while another curve has
-  // N y/radius values for that same x/radius value. So we export each curve into memory separately and then merge
-  // the results. Why? Since the methods called from this method all assume a single set of x/theta values can be
-  // used for all curves
-
-  const int CURVE_COUNT_PER_PASS = 1;
-
-  int curveCount = curvesIncluded.count ();
-
-  QVector<QVector<QString*> > xThetaYRadiusValuesAll (COLUMNS_PER_CURVE * curveCount, QVector<QString*> (maxColumnSize));
-
-  initializeXThetaYRadiusValues (curvesIncluded,
-                                 xThetaYRadiusValuesAll);
-
-  // One pass per curve
-  int colX = 0, colY = colX + 1;
-  for (int c = 0; c < curvesIncluded.count (); c++) {
-    QString curve = curvesIncluded [c];
-
-    QStringList curvesIncludedInPass;
-    curvesIncludedInPass << curve;
-    ENGAUGE_ASSERT (curvesIncludedInPass.count () == CURVE_COUNT_PER_PASS);
-
-    QVector<QVector<QString*> > xThetaYRadiusValuesOne (COLUMNS_PER_CURVE * CURVE_COUNT_PER_PASS, QVector<QString*> (maxColumnSize));
-
-    initializeXThetaYRadiusValues (curvesIncludedInPass,
-                                   xThetaYRadiusValuesOne);
-    loadXThetaYRadiusValues (modelExportOverride,
-                             document,
-                             modelMainWindow,
-                             curvesIncludedInPass,
-                             transformation,
-                             isLogXTheta,
-                             isLogYRadius,
-                             xThetaYRadiusValuesOne);
-
-    // Merge one curve array into all curves array
-    for (int row = 0; row < maxColumnSize; row++) {
-      *(xThetaYRadiusValuesAll [colX] [row]) = *(xThetaYRadiusValuesOne [0] [row]);
-      *(xThetaYRadiusValuesAll [colY] [row]) = *(xThetaYRadiusValuesOne [1] [row]);
-    }
-
-    destroy2DArray (xThetaYRadiusValuesOne);
-
-    colX += 2;
-    colY += 2;
-  }
-
-  outputXThetaYRadiusValues (modelExportOverride,
-                             curvesIncluded,
-                             xThetaYRadiusValuesAll,
-                             delimiter,
-                             str);
-  destroy2DArray (xThetaYRadiusValuesAll);
-}
-
-void ExportFileRelations::exportAllPerLineXThetaValuesMergedOnePass (int maxColumnSize,
-                                                                     const DocumentModelExportFormat &modelExportOverride,
-                                                                     const Document &document,
-                                                                     const MainWindowModel &modelMainWindow,
-                                                                     const QStringList &curvesIncluded,
-                                                                     const QString &delimiter,
-                                                                     const Transformation &transformation,
-                                                                     bool isLogXTheta,
-                                                                     bool isLogYRadius,
-                                                                     QTextStream &str) const
-{
-  int curveCount = curvesIncluded.count ();
-
-  QVector<QVector<QString*> > xThetaYRadiusValues (COLUMNS_PER_CURVE * curveCount, QVector<QString*> (maxColumnSize));
-  initializeXThetaYRadiusValues (curvesIncluded,
-                                 xThetaYRadiusValues);
+  // N y/radius values for that same x/radius value. So each curve is exported into its own pair of columns,
+  // independently of the other curves
+  QVector<QVector<double> > xThetaYRadiusValues (COLUMNS_PER_CURVE * curvesIncluded.count ());
   loadXThetaYRadiusValues (modelExportOverride,
                            document,
-                           modelMainWindow,
                            curvesIncluded,
                            transformation,
                            isLogXTheta,
                            isLogYRadius,
                            xThetaYRadiusValues);
-  outputXThetaYRadiusValues (modelExportOverride,
-                             curvesIncluded,
-                             xThetaYRadiusValues,
-                             delimiter,
-                             str);
-  destroy2DArray (xThetaYRadiusValues);
+
+  // Skip if every curve was a function
+  if (maxColumnSize (xThetaYRadiusValues) > 0) {
+
+    outputXThetaYRadiusValues (modelExportOverride,
+                               document.modelCoords(),
+                               document.modelGeneral(),
+                               modelMainWindow,
+                               curvesIncluded,
+                               transformation,
+                               xThetaYRadiusValues,
+                               delimiter,
+                               str);
+  }
 }
 
 void ExportFileRelations::exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
@@ -211,6 +103,46 @@ void ExportFileRelations::exportOnePerLineXThetaValuesMerged (const DocumentMode
   }
 }
 
+void ExportFileRelations::exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                                           const Document &document,
+                                           const Transformation &transformation,
+                                           ExportColumns &columns) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::exportToColumns";
+
+  // Log coordinates must be temporarily transformed to linear coordinates
+  bool isLogXTheta = (document.modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogYRadius = (document.modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+
+  // Identify curves to be included
+  QStringList curvesIncluded = curvesToInclude (modelExportOverride,
+                                                document,
+                                                document.curvesGraphsNames(),
+                                                CONNECT_AS_RELATION_SMOOTH,
+                                                CONNECT_AS_RELATION_STRAIGHT);
+
+  // Same values as the text export, except unformatted. The layout setting only affects text, since each curve
+  // already has its own pair of columns
+  QVector<QVector<double> > xThetaYRadiusValues (COLUMNS_PER_CURVE * curvesIncluded.count ());
+  loadXThetaYRadiusValues (modelExportOverride,
+                           document,
+                           curvesIncluded,
+                           transformation,
+                           isLogXTheta,
+                           isLogYRadius,
+                           xThetaYRadiusValues);
+
+  for (int ic = 0; ic < curvesIncluded.count (); ic++) {
+    QString curveName = curvesIncluded.at (ic);
+    columns.addColumn (QString ("%1 %2")
+                       .arg (curveName)
+                       .arg (modelExportOverride.xLabel ()),
+                       xThetaYRadiusValues [COLUMNS_PER_CURVE * ic]);
+    columns.addColumn (curveName,
+                       xThetaYRadiusValues [COLUMNS_PER_CURVE * ic + 1]);
+  }
+}
+
 void ExportFileRelations::exportToFile (const DocumentModelExportFormat &modelExportOverride,
                                         const Document &document,
                                         const MainWindowModel &modelMainWindow,
@@ -258,21 +190,6 @@ void ExportFileRelations::exportToFile (const DocumentModelExportFormat &modelEx
   }
 }
 
-void ExportFileRelations::initializeXThetaYRadiusValues (const QStringList &curvesIncluded,
-                                                         QVector<QVector<QString*> > &xThetaYRadiusValues) const
-{
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::initializeXThetaYRadiusValues";
-
-  // Initialize every entry with empty string
-  int curveCount = curvesIncluded.count();
-  int xThetaCount = xThetaYRadiusValues [0].count();
-  for (int row = 0; row < xThetaCount; row++) {
-    for (int col = 0; col < COLUMNS_PER_CURVE * curveCount; col++) {
-      xThetaYRadiusValues [col] [row] = new QString;
-    }
-  }
-}
-
 QPointF ExportFileRelations::linearlyInterpolate (const Points &points,
                                                   double ordinal,
                                                   const Transformation &transformation) const
@@ -329,89 +246,145 @@ QPointF ExportFileRelations::linearlyInterpolate (const Points &points,
 
 void ExportFileRelations::loadXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
                                                    const Document &document,
-                                                   const MainWindowModel &modelMainWindow,
                                                    const QStringList &curvesIncluded,
                                                    const Transformation &transformation,
                                                    bool isLogXTheta,
                                                    bool isLogYRadius,
-                                                   QVector<QVector<QString*> > &xThetaYRadiusValues) const
+                                                   QVector<QVector<double> > &xThetaYRadiusValues) const
 {
   LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValues";
 
-  // The curve processing logic here is mirrored in maxColumnSizeAllocation so the array allocations are in sync
-  for (int ic = 0; ic < curvesIncluded.count(); ic++) {
+  int curveCount = curvesIncluded.count();
 
-    int colXTheta = 2 * ic;
-    int colYRadius = 2 * ic + 1;
+  // Preconditions are checked here in the GUI thread since the per-curve computations, which may run in worker threads,
+  // cannot assert or log
+  ENGAUGE_ASSERT (xThetaYRadiusValues.count() == 2 * curveCount);
+  for (int ic = 0; ic < curveCount; ic++) {
+    ENGAUGE_CHECK_PTR (document.curveForCurveName (curvesIncluded.at (ic)));
+  }
 
-    const QString curveName = curvesIncluded.at (ic);
+  QList<bool> successes;
+  if (curveCount == 1) {
 
-    const Curve *curve = document.curveForCurveName (curveName);
-    const Points points = curve->points ();
+    // No benefit from another thread
+    successes << loadXThetaYRadiusValuesForCurve (modelExportOverride,
+                                                  document,
+                                                  curvesIncluded.at (0),
+                                                  transformation,
+                                                  isLogXTheta,
+                                                  isLogYRadius,
+                                                  xThetaYRadiusValues [0],
+                                                  xThetaYRadiusValues [1]);
 
-    if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
+  } else {
 
-      // No interpolation. Raw points
-      loadXThetaYRadiusValuesForCurveRaw (document.modelCoords(),
-                                          document.modelGeneral(),
-                                          modelMainWindow,
-                                          points,
-                                          xThetaYRadiusValues [colXTheta],
-                                          xThetaYRadiusValues [colYRadius],
-                                          transformation);
-    } else {
+    // Curves are computed concurrently. Each curve has its own pair of columns, and the computations are the same as
+    // when done one curve at a time, so the output is the same
+    RunnableBatch batch;
+    QList<ExportFileRelationsWorker*> workers;
+
+    for (int ic = 0; ic < curveCount; ic++) {
+
+      int colXTheta = 2 * ic;
+      int colYRadius = 2 * ic + 1;
+
+      ExportFileRelationsWorker *worker = new ExportFileRelationsWorker (*this,
+                                                                         modelExportOverride,
+                                                                         document,
+                                                                         curvesIncluded.at (ic),
+                                                                         transformation,
+                                                                         isLogXTheta,
+                                                                         isLogYRadius,
+                                                                         xThetaYRadiusValues [colXTheta],
+                                                                         xThetaYRadiusValues [colYRadius]);
+      workers << worker;
+      batch.start (worker);
+    }
 
-      const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
+    batch.waitForDone ();
 
-      // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
-      ExportValuesOrdinal ordinals = ordinalsAtIntervals (modelExportOverride.pointsIntervalRelations(),
-                                                          modelExportOverride.pointsIntervalUnitsRelations(),
-                                                          lineStyle.curveConnectAs(),
-                                                          transformation,
-                                                          isLogXTheta,
-                                                          isLogYRadius,
-                                                          points);
+    for (int ic = 0; ic < curveCount; ic++) {
+      successes << workers.at (ic)->success ();
+    }
+  }
 
-      if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_RELATION_SMOOTH) {
+  // Failures are reported here rather than in the worker threads
+  for (int ic = 0; ic < curveCount; ic++) {
+    if (!successes.at (ic)) {
+      LOG4CPP_ERROR_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValues failed for curve="
+                                   << curvesIncluded.at (ic).toLatin1().data();
+    }
+  }
+}
 
-        loadXThetaYRadiusValuesForCurveInterpolatedSmooth (document.modelCoords(),
-                                                           document.modelGeneral(),
-                                                           modelMainWindow,
-                                                           points,
-                                                           ordinals,
-                                                           xThetaYRadiusValues [colXTheta],
-                                                           xThetaYRadiusValues [colYRadius],
-                                                           transformation,
-                                                           isLogXTheta,
-                                                           isLogYRadius);
+bool ExportFileRelations::loadXThetaYRadiusValuesForCurve (const DocumentModelExportFormat &modelExportOverride,
+                                                           const Document &document,
+                                                           const QString &curveName,
+                                                           const Transformation &transformation,
+                                                           bool isLogXTheta,
+                                                           bool isLogYRadius,
+                                                           QVector<double> &xThetaValues,
+                                                           QVector<double> &yRadiusValues) const
+{
+  const Curve *curve = document.curveForCurveName (curveName);
+  if (curve == 0) {
+    return false;
+  }
 
-      } else {
+  const Points points = curve->points ();
 
-        loadXThetaYRadiusValuesForCurveInterpolatedStraight (document.modelCoords(),
-                                                             document.modelGeneral(),
-                                                             modelMainWindow,
-                                                             points,
-                                                             ordinals,
-                                                             xThetaYRadiusValues [colXTheta],
-                                                             xThetaYRadiusValues [colYRadius],
-                                                             transformation);
-      }
+  if (modelExportOverride.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
+
+    // No interpolation. Raw points
+    loadXThetaYRadiusValuesForCurveRaw (points,
+                                        transformation,
+                                        xThetaValues,
+                                        yRadiusValues);
+  } else {
+
+    const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
+
+    // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
+    ExportValuesOrdinal ordinals = ordinalsAtIntervals (modelExportOverride.pointsIntervalRelations(),
+                                                        modelExportOverride.pointsIntervalUnitsRelations(),
+                                                        lineStyle.curveConnectAs(),
+                                                        transformation,
+                                                        isLogXTheta,
+                                                        isLogYRadius,
+                                                        points);
+
+    if (curve->curveStyle().lineStyle().curveConnectAs() == CONNECT_AS_RELATION_SMOOTH) {
+
+      loadXThetaYRadiusValuesForCurveInterpolatedSmooth (points,
+                                                         ordinals,
+                                                         transformation,
+                                                         isLogXTheta,
+                                                         isLogYRadius,
+                                                         xThetaValues,
+                                                         yRadiusValues);
+
+    } else {
+
+      loadXThetaYRadiusValuesForCurveInterpolatedStraight (points,
+                                                           ordinals,
+                                                           transformation,
+                                                           xThetaValues,
+                                                           yRadiusValues);
     }
   }
+
+  return true;
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                                             const DocumentModelGeneral &modelGeneral,
-                                                                             const MainWindowModel &modelMainWindow,
-                                                                             const Points &points,
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const Points &points,
                                                                              const ExportValuesOrdinal &ordinals,
-                                                                             QVector<QString*> &xThetaValues,
-                                                                             QVector<QString*> &yRadiusValues,
                                                                              const Transformation &transformation,
                                                                              bool isLogXTheta,
-                                                                             bool isLogYRadius) const
+                                                                             bool isLogYRadius,
+                                                                             QVector<double> &xThetaValues,
+                                                                             QVector<double> &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth";
 
   vector<double> t;
   vector<SplinePair> xy;
@@ -431,41 +404,31 @@ void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedSmooth (con
     Spline spline (t,
                    xy);
 
-    FormatCoordsUnits format;
+    // Extract the points. The ordinals are sorted, so all of them are found in one pass
+    vector<double> ordinalsVector (ordinals.begin(), ordinals.end());
+    vector<SplinePair> splinePairsFound;
+    spline.interpolateCoeffs (ordinalsVector,
+                              splinePairsFound);
 
-    // Extract the points
+    xThetaValues.resize (ordinals.count());
+    yRadiusValues.resize (ordinals.count());
     for (int row = 0; row < ordinals.count(); row++) {
-
-      double ordinal = ordinals.at (row);
-      SplinePair splinePairFound = spline.interpolateCoeff(ordinal);
-      double xTheta = splinePairFound.x ();
-      double yRadius = splinePairFound.y ();
-
-      // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-      format.unformattedToFormatted (xTheta,
-                                     yRadius,
-                                     modelCoords,
-                                     modelGeneral,
-                                     modelMainWindow,
-                                     *(xThetaValues [row]),
-                                     *(yRadiusValues [row]),
-                                     transformation);
+      xThetaValues [row] = splinePairsFound [row].x ();
+      yRadiusValues [row] = splinePairsFound [row].y ();
     }
   }
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                                               const DocumentModelGeneral &modelGeneral,
-                                                                               const MainWindowModel &modelMainWindow,
-                                                                               const Points &points,
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight (const Points &points,
                                                                                const ExportValuesOrdinal &ordinals,
-                                                                               QVector<QString*> &xThetaValues,
-                                                                               QVector<QString*> &yRadiusValues,
-                                                                               const Transformation &transformation) const
+                                                                               const Transformation &transformation,
+                                                                               QVector<double> &xThetaValues,
+                                                                               QVector<double> &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight";
 
-  FormatCoordsUnits format;
+  xThetaValues.resize (ordinals.count());
+  yRadiusValues.resize (ordinals.count());
 
   // Get value at desired points
   for (int row = 0; row < ordinals.count(); row++) {
@@ -476,29 +439,20 @@ void ExportFileRelations::loadXThetaYRadiusValuesForCurveInterpolatedStraight (c
                                                      ordinal,
                                                      transformation);
 
-    // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-    format.unformattedToFormatted (pointInterpolated.x(),
-                                   pointInterpolated.y(),
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   *(xThetaValues [row]),
-                                   *(yRadiusValues [row]),
-                                   transformation);
+    xThetaValues [row] = pointInterpolated.x();
+    yRadiusValues [row] = pointInterpolated.y();
   }
 }
 
-void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                                              const DocumentModelGeneral &modelGeneral,
-                                                              const MainWindowModel &modelMainWindow,
-                                                              const Points &points,
-                                                              QVector<QString*> &xThetaValues,
-                                                              QVector<QString*> &yRadiusValues,
-                                                              const Transformation &transformation) const
+void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const Points &points,
+                                                              const Transformation &transformation,
+                                                              QVector<double> &xThetaValues,
+                                                              QVector<double> &yRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw";
 
-  FormatCoordsUnits format;
+  xThetaValues.resize (points.count());
+  yRadiusValues.resize (points.count());
 
   for (int pt = 0; pt < points.count(); pt++) {
 
@@ -508,60 +462,17 @@ void ExportFileRelations::loadXThetaYRadiusValuesForCurveRaw (const DocumentMode
     transformation.transformScreenToRawGraph (point.posScreen(),
                                               posGraph);
 
-    // Save values for this row into xThetaValues and yRadiusValues, after appropriate formatting
-    format.unformattedToFormatted (posGraph.x(),
-                                   posGraph.y(),
-                                   modelCoords,
-                                   modelGeneral,
-                                   modelMainWindow,
-                                   *(xThetaValues [pt]),
-                                   *(yRadiusValues [pt]),
-                                   transformation);
+    xThetaValues [pt] = posGraph.x();
+    yRadiusValues [pt] = posGraph.y();
   }
 }
 
-int ExportFileRelations::maxColumnSizeAllocation (const DocumentModelExportFormat &modelExport,
-                                                  const Document &document,
-                                                  const Transformation &transformation,
-                                                  bool isLogXTheta,
-                                                  bool isLogYRadius,
-                                                  const QStringList &curvesIncluded) const
+int ExportFileRelations::maxColumnSize (const QVector<QVector<double> > &xThetaYRadiusValues) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::maxColumnSizeAllocation";
-
   int maxColumnSize = 0;
-
-  // The curve processing logic here is mirrored in loadXThetaYRadiusValues so the array allocations are in sync
-  for (int ic = 0; ic < curvesIncluded.count(); ic++) {
-
-    const QString curveName = curvesIncluded.at (ic);
-
-    const Curve *curve = document.curveForCurveName (curveName);
-    const Points points = curve->points ();
-
-    if (modelExport.pointsSelectionRelations() == EXPORT_POINTS_SELECTION_RELATIONS_RAW) {
-
-      // No interpolation. Raw points
-      maxColumnSize = qMax (maxColumnSize,
-                            points.count());
-
-    } else {
-
-      const LineStyle &lineStyle = document.modelCurveStyles().lineStyle(curveName);
-
-
-      // Interpolation. Points are taken approximately every every modelExport.pointsIntervalRelations
-      ExportValuesOrdinal ordinals = ordinalsAtIntervals (modelExport.pointsIntervalRelations(),
-                                                          modelExport.pointsIntervalUnitsRelations(),
-                                                          lineStyle.curveConnectAs(),
-                                                          transformation,
-                                                          isLogXTheta,
-                                                          isLogYRadius,
-                                                          points);
-
-      maxColumnSize = qMax (maxColumnSize,
-                            ordinals.count());
-    }
+  for (int col = 0; col < xThetaYRadiusValues.count(); col++) {
+    maxColumnSize = qMax (maxColumnSize,
+                          xThetaYRadiusValues [col].count());
   }
 
   return maxColumnSize;
@@ -575,7 +486,7 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervals (double pointsInter
                                                               bool isLogYRadius,
                                                               const Points &points) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervals";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervals";
 
   if (pointsIntervalUnits == EXPORT_POINTS_INTERVAL_UNITS_GRAPH) {
     if (curveConnectAs == CONNECT_AS_RELATION_SMOOTH) {
@@ -615,7 +526,7 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (double
                                                                          bool isLogYRadius,
                                                                          const Points &points) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsSmoothGraph";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsSmoothGraph";
 
   ExportValuesOrdinal ordinals;
 
@@ -645,8 +556,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothGraph (double
 ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsSmoothScreen (double pointsIntervalRelations,
                                                                           const Points &points) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsSmoothScreen"
-                              << " pointCount=" << points.count();
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsSmoothScreen"
+//                              << " pointCount=" << points.count();
 
   // Results
   ExportValuesOrdinal ordinals;
@@ -675,7 +586,7 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsStraightGraph (doubl
                                                                            const Transformation &transformation,
                                                                            const Points &points) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsStraightGraph";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsStraightGraph";
 
   ExportValuesOrdinal ordinals;
 
@@ -696,8 +607,8 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsStraightGraph (doubl
 ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsStraightScreen (double pointsIntervalRelations,
                                                                             const Points &points) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsStraightScreen"
-                              << " pointCount=" << points.count();
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportFileRelations::ordinalsAtIntervalsStraightScreen"
+//                              << " pointCount=" << points.count();
 
   // Results
   ExportValuesOrdinal ordinals;
@@ -716,8 +627,12 @@ ExportValuesOrdinal ExportFileRelations::ordinalsAtIntervalsStraightScreen (doub
 }
 
 void ExportFileRelations::outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
+                                                     const DocumentModelCoords &modelCoords,
+                                                     const DocumentModelGeneral &modelGeneral,
+                                                     const MainWindowModel &modelMainWindow,
                                                      const QStringList &curvesIncluded,
-                                                     QVector<QVector<QString*> > &xThetaYRadiusValues,
+                                                     const Transformation &transformation,
+                                                     const QVector<QVector<double> > &xThetaYRadiusValues,
                                                      const QString &delimiter,
                                                      QTextStream &str) const
 {
@@ -740,15 +655,43 @@ void ExportFileRelations::outputXThetaYRadiusValues (const DocumentModelExportFo
     str << "\n";
   }
 
-  for (int row = 0; row < xThetaYRadiusValues [0].count(); row++) {
+  FormatCoordsUnits format;
 
-    QString delimiterForRow;
-    for (int col = 0; col < xThetaYRadiusValues.count(); col++) {
+  // Each row is formatted into the same buffers and then streamed. Curves with fewer rows than the longest curve get
+  // blanks in their columns
+  QString line, xThetaString, yRadiusString;
 
-      str << delimiterForRow << *(xThetaYRadiusValues [col] [row]);
-      delimiterForRow = delimiter;
+  int rowCount = maxColumnSize (xThetaYRadiusValues);
+  for (int row = 0; row < rowCount; row++) {
+
+    line.clear ();
+    for (int col = 0; col < xThetaYRadiusValues.count(); col += COLUMNS_PER_CURVE) {
+
+      if (col > 0) {
+        line += delimiter;
+      }
+
+      const QVector<double> &xThetaValues = xThetaYRadiusValues [col];
+      const QVector<double> &yRadiusValues = xThetaYRadiusValues [col + 1];
+
+      if (row < xThetaValues.count()) {
+        format.unformattedToFormatted (xThetaValues [row],
+                                       yRadiusValues [row],
+                                       modelCoords,
+                                       modelGeneral,
+                                       modelMainWindow,
+                                       xThetaString,
+                                       yRadiusString,
+                                       transformation);
+        line += xThetaString;
+        line += delimiter;
+        line += yRadiusString;
+      } else {
+        line += delimiter;
+      }
     }
 
-    str << "\n";
+    line += "\n";
+    str << line;
   }
 }
@@ -17,6 +17,7 @@ class Document;
 class DocumentModelCoords;
 class DocumentModelExportFormat;
 class DocumentModelGeneral;
+class ExportColumns;
 class MainWindowModel;
 class QTextStream;
 class Transformation;
@@ -24,10 +25,20 @@ class Transformation;
 /// Strategy class for exporting to a file. This strategy is external to the Document class so that class is simpler.
 class ExportFileRelations : public ExportFileAbstractBase
 {
+  // Computes one curve in loadXThetaYRadiusValues
+  friend class ExportFileRelationsWorker;
+
 public:
   /// Single constructor.
   ExportFileRelations();
 
+  /// Export the unformatted values of the relation curves as columns, for binary export. Each curve contributes an
+  /// x/theta column and a y/radius column, using the same point selection as exportToFile
+  void exportToColumns (const DocumentModelExportFormat &modelExportOverride,
+                        const Document &document,
+                        const Transformation &transformation,
+                        ExportColumns &columns) const;
+
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
   /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
   void exportToFile (const DocumentModelExportFormat &modelExportOverride,
@@ -46,26 +57,6 @@ private:
                                            bool isLogXTheta,
                                            bool isLogYRadius,
                                            QTextStream &str) const;
-  void exportAllPerLineXThetaValuesMergedMultiplePass (int maxColumnSize,
-                                                       const DocumentModelExportFormat &modelExportOverride,
-                                                       const Document &document,
-                                                       const MainWindowModel &modelMainWindow,
-                                                       const QStringList &curvesIncluded,
-                                                       const QString &delimiter,
-                                                       const Transformation &transformation,
-                                                       bool isLogXTheta,
-                                                       bool isLogYRadius,
-                                                       QTextStream &str) const;
-  void exportAllPerLineXThetaValuesMergedOnePass (int maxColumnSize,
-                                                  const DocumentModelExportFormat &modelExportOverride,
-                                                  const Document &document,
-                                                  const MainWindowModel &modelMainWindow,
-                                                  const QStringList &curvesIncluded,
-                                                  const QString &delimiter,
-                                                  const Transformation &transformation,
-                                                  bool isLogXTheta,
-                                                  bool isLogYRadius,
-                                                  QTextStream &str) const;
   void exportOnePerLineXThetaValuesMerged (const DocumentModelExportFormat &modelExportOverride,
                                            const Document &document,
                                            const MainWindowModel &modelMainWindow,
@@ -75,50 +66,45 @@ private:
                                            bool isLogXTheta,
                                            bool isLogYRadius,
                                            QTextStream &str) const;
-  void initializeXThetaYRadiusValues (const QStringList &curvesIncluded,
-                                      QVector<QVector<QString*> > &xThetaYRadiusValues) const;
   QPointF linearlyInterpolate (const Points &points,
                                double ordinal,
                                const Transformation &transformation) const;
+  /// Load the unformatted x/theta and y/radius values of every curve, with one pair of columns per curve. Each column
+  /// is sized to the number of values of its curve. Curves are computed concurrently
   void loadXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
                                 const Document &document,
-                                const MainWindowModel &modelMainWindow,
                                 const QStringList &curvesIncluded,
                                 const Transformation &transformation,
                                 bool isLogXTheta,
                                 bool isLogYRadius,
-                                QVector<QVector<QString*> > &xThetaYRadiusValues) const;
-  void loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const DocumentModelCoords &modelCoords,
-                                                          const DocumentModelGeneral  &modelGeneral,
-                                                          const MainWindowModel &modelMainWindow,
-                                                          const Points &points,
+                                QVector<QVector<double> > &xThetaYRadiusValues) const;
+  /// Load the x/theta and y/radius values of one curve. This can run in a worker thread, so it neither asserts nor logs.
+  /// Returns false if the curve does not exist
+  bool loadXThetaYRadiusValuesForCurve (const DocumentModelExportFormat &modelExportOverride,
+                                        const Document &document,
+                                        const QString &curveName,
+                                        const Transformation &transformation,
+                                        bool isLogXTheta,
+                                        bool isLogYRadius,
+                                        QVector<double> &xThetaValues,
+                                        QVector<double> &yRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveInterpolatedSmooth (const Points &points,
                                                           const ExportValuesOrdinal &ordinals,
-                                                          QVector<QString*> &xThetaValues,
-                                                          QVector<QString*> &yRadiusValues,
                                                           const Transformation &transformation,
                                                           bool isLogXTheta,
-                                                          bool isLogYRadius) const;
-  void loadXThetaYRadiusValuesForCurveInterpolatedStraight (const DocumentModelCoords &modelCoords,
-                                                            const DocumentModelGeneral &modelGeneral,
-                                                            const MainWindowModel &modelMainWindow,
-                                                            const Points &points,
+                                                          bool isLogYRadius,
+                                                          QVector<double> &xThetaValues,
+                                                          QVector<double> &yRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveInterpolatedStraight (const Points &points,
                                                             const ExportValuesOrdinal &ordinals,
-                                                            QVector<QString*> &xThetaValues,
-                                                            QVector<QString*> &yRadiusValues,
-                                                            const Transformation &transformation) const;
-  void loadXThetaYRadiusValuesForCurveRaw (const DocumentModelCoords &modelCoords,
-                                           const DocumentModelGeneral &modelGeneral,
-                                           const MainWindowModel &modelMainWindow,
-                                           const Points &points,
-                                           QVector<QString*> &xThetaValues,
-                                           QVector<QString*> &yRadiusValues,
-                                           const Transformation &transformation) const;
-  int maxColumnSizeAllocation (const DocumentModelExportFormat &modelExportOverride,
-                               const Document &document,
-                               const Transformation &transformation,
-                               bool isLogXTheta,
-                               bool isLogYRadius,
-                               const QStringList &curvesIncluded) const;
+                                                            const Transformation &transformation,
+                                                            QVector<double> &xThetaValues,
+                                                            QVector<double> &yRadiusValues) const;
+  void loadXThetaYRadiusValuesForCurveRaw (const Points &points,
+                                           const Transformation &transformation,
+                                           QVector<double> &xThetaValues,
+                                           QVector<double> &yRadiusValues) const;
+  int maxColumnSize (const QVector<QVector<double> > &xThetaYRadiusValues) const;
   ExportValuesOrdinal ordinalsAtIntervals (double pointsIntervalRelations,
                                            ExportPointsIntervalUnits pointsIntervalUnits,
                                            CurveConnectAs curveConnectAs,
@@ -139,10 +125,14 @@ private:
   ExportValuesOrdinal ordinalsAtIntervalsStraightScreen (double pointsIntervalRelations,
                                                          const Points &points) const;
 
-  /// Output 2D array with alternating x/theta and y/radius columns
-  void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExport,
+  /// Output x/theta and y/radius columns of every curve side by side. Values are formatted one row at a time
+  void outputXThetaYRadiusValues (const DocumentModelExportFormat &modelExportOverride,
+                                  const DocumentModelCoords &modelCoords,
+                                  const DocumentModelGeneral &modelGeneral,
+                                  const MainWindowModel &modelMainWindow,
                                   const QStringList &curvesIncluded,
-                                  QVector<QVector<QString*> > &xThetaYRadiusValues,
+                                  const Transformation &transformation,
+                                  const QVector<QVector<double> > &xThetaYRadiusValues,
                                   const QString &delimiter,
                                   QTextStream &str) const;
 };
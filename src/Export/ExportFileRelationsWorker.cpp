@@ -0,0 +1,47 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "ExportFileRelations.h"
+#include "ExportFileRelationsWorker.h"
+
+ExportFileRelationsWorker::ExportFileRelationsWorker (const ExportFileRelations &exportFile,
+                                                      const DocumentModelExportFormat &modelExportOverride,
+                                                      const Document &document,
+                                                      const QString &curveName,
+                                                      const Transformation &transformation,
+                                                      bool isLogXTheta,
+                                                      bool isLogYRadius,
+                                                      QVector<double> &xThetaValues,
+                                                      QVector<double> &yRadiusValues) :
+  m_exportFile (exportFile),
+  m_modelExportOverride (modelExportOverride),
+  m_document (document),
+  m_curveName (curveName),
+  m_transformation (transformation),
+  m_isLogXTheta (isLogXTheta),
+  m_isLogYRadius (isLogYRadius),
+  m_xThetaValues (xThetaValues),
+  m_yRadiusValues (yRadiusValues),
+  m_success (false)
+{
+}
+
+void ExportFileRelationsWorker::run ()
+{
+  m_success = m_exportFile.loadXThetaYRadiusValuesForCurve (m_modelExportOverride,
+                                                            m_document,
+                                                            m_curveName,
+                                                            m_transformation,
+                                                            m_isLogXTheta,
+                                                            m_isLogYRadius,
+                                                            m_xThetaValues,
+                                                            m_yRadiusValues);
+}
+
+bool ExportFileRelationsWorker::success () const
+{
+  return m_success;
+}
@@ -0,0 +1,57 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_FILE_RELATIONS_WORKER_H
+#define EXPORT_FILE_RELATIONS_WORKER_H
+
+#include <QRunnable>
+#include <QString>
+#include <QVector>
+
+class Document;
+class DocumentModelExportFormat;
+class ExportFileRelations;
+class Transformation;
+
+/// Runnable that computes the x/theta and y/radius values of one curve for ExportFileRelations::loadXThetaYRadiusValues.
+/// Each worker writes only the pair of columns of its own curve, so the workers for all curves can run concurrently.
+/// Since this runs outside of the GUI thread, failures are reported through success rather than asserted
+class ExportFileRelationsWorker : public QRunnable
+{
+public:
+  /// Single constructor
+  ExportFileRelationsWorker (const ExportFileRelations &exportFile,
+                             const DocumentModelExportFormat &modelExportOverride,
+                             const Document &document,
+                             const QString &curveName,
+                             const Transformation &transformation,
+                             bool isLogXTheta,
+                             bool isLogYRadius,
+                             QVector<double> &xThetaValues,
+                             QVector<double> &yRadiusValues);
+
+  /// Compute the values of this curve
+  virtual void run ();
+
+  /// True if run computed the values. Only valid after run has finished
+  bool success () const;
+
+private:
+  ExportFileRelationsWorker ();
+
+  const ExportFileRelations &m_exportFile;
+  const DocumentModelExportFormat &m_modelExportOverride;
+  const Document &m_document;
+  QString m_curveName;
+  const Transformation &m_transformation;
+  bool m_isLogXTheta;
+  bool m_isLogYRadius;
+  QVector<double> &m_xThetaValues;
+  QVector<double> &m_yRadiusValues;
+  bool m_success;
+};
+
+#endif // EXPORT_FILE_RELATIONS_WORKER_H
@@ -4,6 +4,7 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include <algorithm>
 #include "ExportOrdinalsSmooth.h"
 #include "LinearToLog.h"
 #include "Logger.h"
@@ -19,11 +20,103 @@ ExportOrdinalsSmooth::ExportOrdinalsSmooth ()
 {
 }
 
+void ExportOrdinalsSmooth::arcLengthAdaptive (const Spline &spline,
+                                              double tLow,
+                                              double tHigh,
+                                              double arcLengthWhole,
+                                              double tolerance,
+                                              int depth,
+                                              vector<double> &tTable,
+                                              vector<double> &sTable) const
+{
+  const int MAX_DEPTH = 16;
+
+  double tMid = (tLow + tHigh) / 2.0;
+  double arcLengthLeft = arcLengthGaussLegendre (spline, tLow, tMid);
+  double arcLengthRight = arcLengthGaussLegendre (spline, tMid, tHigh);
+
+  if ((depth >= MAX_DEPTH) ||
+      (qAbs (arcLengthLeft + arcLengthRight - arcLengthWhole) <= tolerance)) {
+
+    // Converged. Both halves go into the table so later inversions start from a close bracket
+    double sLow = sTable.back ();
+    tTable.push_back (tMid);
+    sTable.push_back (sLow + arcLengthLeft);
+    tTable.push_back (tHigh);
+    sTable.push_back (sLow + arcLengthLeft + arcLengthRight);
+
+  } else {
+
+    arcLengthAdaptive (spline,
+                       tLow,
+                       tMid,
+                       arcLengthLeft,
+                       tolerance / 2.0,
+                       depth + 1,
+                       tTable,
+                       sTable);
+    arcLengthAdaptive (spline,
+                       tMid,
+                       tHigh,
+                       arcLengthRight,
+                       tolerance / 2.0,
+                       depth + 1,
+                       tTable,
+                       sTable);
+  }
+}
+
+double ExportOrdinalsSmooth::arcLengthGaussLegendre (const Spline &spline,
+                                                     double tLow,
+                                                     double tHigh) const
+{
+  // Five point Gauss-Legendre abscissas and weights on -1 to +1, which integrate polynomials up to ninth order exactly
+  const int NUM_NODES = 5;
+  const double NODES [NUM_NODES] = {-0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640};
+  const double WEIGHTS [NUM_NODES] = {0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891};
+
+  double tCenter = (tHigh + tLow) / 2.0;
+  double tHalfWidth = (tHigh - tLow) / 2.0;
+
+  double sum = 0;
+  for (int i = 0; i < NUM_NODES; i++) {
+    SplinePair derivative = spline.interpolateDerivativeCoeff (tCenter + tHalfWidth * NODES [i]);
+    sum += WEIGHTS [i] * qSqrt (derivative.x() * derivative.x() + derivative.y() * derivative.y());
+  }
+
+  return tHalfWidth * sum;
+}
+
+void ExportOrdinalsSmooth::loadArcLengthTable (const Spline &spline,
+                                               const vector<double> &t,
+                                               vector<double> &tTable,
+                                               vector<double> &sTable) const
+{
+  // Tolerance is relative so results do not depend on the units of the coordinates
+  const double RELATIVE_TOLERANCE = 1e-10;
+
+  tTable.push_back (t.front ());
+  sTable.push_back (0.0);
+
+  // Each spline interval is integrated separately since the speed is only smooth within an interval
+  for (unsigned int i = 1; i < t.size (); i++) {
+    double arcLengthWhole = arcLengthGaussLegendre (spline, t [i - 1], t [i]);
+    arcLengthAdaptive (spline,
+                       t [i - 1],
+                       t [i],
+                       arcLengthWhole,
+                       RELATIVE_TOLERANCE * arcLengthWhole,
+                       0,
+                       tTable,
+                       sTable);
+  }
+}
+
 void ExportOrdinalsSmooth::loadSplinePairsWithoutTransformation (const Points &points,
                                                                  vector<double> &t,
                                                                  vector<SplinePair> &xy) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::loadSplinePairsWithoutTransformation";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::loadSplinePairsWithoutTransformation";
 
   Points::const_iterator itrP;
   for (itrP = points.begin(); itrP != points.end(); itrP++) {
@@ -43,7 +136,7 @@ void ExportOrdinalsSmooth::loadSplinePairsWithTransformation (const Points &poin
                                                               vector<double> &t,
                                                               vector<SplinePair> &xy) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::loadSplinePairsWithTransformation";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::loadSplinePairsWithTransformation";
 
   LinearToLog linearToLog;
 
@@ -65,11 +158,12 @@ ExportValuesOrdinal ExportOrdinalsSmooth::ordinalsAtIntervalsGraph (const vector
                                                                     const vector<SplinePair> &xy,
                                                                     double pointsInterval) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::ordinalsAtIntervalsGraph";
+//  LOG4CPP_INFO_S ((*mainCat)) << "ExportOrdinalsSmooth::ordinalsAtIntervalsGraph";
 
-  const double NUM_SMALLER_INTERVALS = 1000;
+  // Fraction of the interval below which the last ordinal is considered to already be at the end of the curve
+  const double END_FRACTION = 0.000001;
 
-  // Results. Initially empty, but at the end it will have tMin, ..., tMax
+  // Results. Initially empty, but at the end it will have one ordinal per multiple of pointsInterval, then tMax
   ExportValuesOrdinal ordinals;
 
   // Spline class requires at least one point
@@ -79,62 +173,96 @@ ExportValuesOrdinal ExportOrdinalsSmooth::ordinalsAtIntervalsGraph (const vector
     Spline spline (t,
                    xy);
 
-    // Integrate the distances for the subintervals
-    double integratedSeparation = 0;
-    QPointF posLast (xy [0].x(),
-                     xy [0].y());
+    // The arc length table is computed once, with its cost depending on the curvature of the spline rather than on
+    // pointsInterval. Each ordinal is then found by inverting the table
+    vector<double> tTable, sTable;
+    loadArcLengthTable (spline,
+                        t,
+                        tTable,
+                        sTable);
 
-    // Simplest method to find the intervals is to break up the curve into many smaller intervals, and then aggregate them
-    // into intervals that, as much as possible, have the desired length. Simplicity wins out over accuracy in this
-    // approach - accuracy is sacrificed to achieve simplicity
-    double tMin = t.front();
-    double tMax = t.back();
+    double arcLengthTotal = sTable.back ();
+    double sLast = 0.0;
+    int count = 1;
+    double s = pointsInterval;
+    while (s <= arcLengthTotal) {
 
-    double tLast = 0.0;
-    int iTLastInterval = 0;
-    for (int iT = 0; iT < NUM_SMALLER_INTERVALS; iT++) {
+      ordinals.push_back (tAtArcLength (spline,
+                                        tTable,
+                                        sTable,
+                                        s));
 
-      double t = tMin + ((tMax - tMin) * iT) / (NUM_SMALLER_INTERVALS - 1.0);
+      sLast = s;
+      s = ++count * pointsInterval; // Multiplication rather than accumulation prevents roundoff buildup
+    }
 
-      SplinePair pairNew = spline.interpolateCoeff(t);
+    if (ordinals.isEmpty () ||
+        (arcLengthTotal - sLast > END_FRACTION * pointsInterval)) {
 
-      QPointF posNew = QPointF (pairNew.x(),
-                                pairNew.y());
+      // Add last point so we end up at tMax
+      ordinals.push_back (t.back ());
 
-      QPointF posDelta = posNew - posLast;
-      double integratedSeparationDelta = qSqrt (posDelta.x() * posDelta.x() + posDelta.y() * posDelta.y());
-      integratedSeparation += integratedSeparationDelta;
+    }
+  }
 
-      while (integratedSeparation >= pointsInterval) {
+  return ordinals;
+}
 
-        // End of current interval, and start of next interval. For better accuracy without having to crank up
-        // the number of points by orders of magnitude, we use linear interpolation
-        double sInterp;
-        if (iT == 0) {
-          sInterp = 0.0;
-        } else {
-          sInterp = (double) pointsInterval / (double) integratedSeparation;
-        }
-        double tInterp = (1.0 - sInterp) * tLast + sInterp * t;
+double ExportOrdinalsSmooth::tAtArcLength (const Spline &spline,
+                                           const vector<double> &tTable,
+                                           const vector<double> &sTable,
+                                           double s) const
+{
+  const int MAX_ITERATIONS = 64;
+  const double EPSILON_T = 1e-12; // Relative to the unit spacing of t values
 
-        integratedSeparation -= pointsInterval; // Part of delta that was not used gets applied to next interval
+  if (tTable.size () < 2) {
+    return tTable [0];
+  }
 
-        tLast = tInterp;
-        ordinals.push_back (tInterp);
-        iTLastInterval = iT;
-      }
+  // Binary search for the table entry at or just before s
+  int j = (int) (upper_bound (sTable.begin(), sTable.end(), s) - sTable.begin()) - 1;
+  j = qMax (0, qMin (j, (int) sTable.size () - 2));
 
-      tLast = t;
-      posLast = posNew;
-    }
+  double tStart = tTable [j];
+  double sStart = sTable [j];
+  double tLow = tStart;
+  double tHigh = tTable [j + 1];
+  double sHigh = sTable [j + 1];
+  if (sHigh <= sStart) {
 
-    if (iTLastInterval < NUM_SMALLER_INTERVALS - 1) {
+    // Zero length entry, so every t in the entry has the same arc length
+    return tStart;
+  }
 
-      // Add last point so we end up at tMax
-      ordinals.push_back (tMax);
+  // Linear interpolation within the table entry is the starting point for Newton steps, which use the speed as the
+  // derivative of arc length. Bisection is the fallback if a step leaves the bracket
+  double tCurrent = tLow + (tHigh - tLow) * (s - sStart) / (sHigh - sStart);
+  tCurrent = qMax (tLow, qMin (tCurrent, tHigh));
+  for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
 
+    double error = sStart + arcLengthGaussLegendre (spline, tStart, tCurrent) - s;
+    if (error > 0) {
+      tHigh = tCurrent;
+    } else if (error < 0) {
+      tLow = tCurrent;
+    } else {
+      break;
+    }
+
+    SplinePair derivative = spline.interpolateDerivativeCoeff (tCurrent);
+    double speed = qSqrt (derivative.x() * derivative.x() + derivative.y() * derivative.y());
+    double tNext = (speed > 0 ? tCurrent - error / speed : tLow);
+    if (!(tLow < tNext && tNext < tHigh)) {
+      tNext = (tLow + tHigh) / 2.0;
+    }
+
+    bool converged = (qAbs (tNext - tCurrent) < EPSILON_T);
+    tCurrent = tNext;
+    if (converged) {
+      break;
     }
   }
 
-  return ordinals;
+  return tCurrent;
 }
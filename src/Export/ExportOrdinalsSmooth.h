@@ -14,11 +14,15 @@
 #include <QList>
 #include <vector>
 
+class Spline;
 class Transformation;
 
 /// Utility class to interpolate points spaced evenly along a piecewise defined curve with fitted spline
 class ExportOrdinalsSmooth 
 {
+  // For unit testing
+  friend class TestExport;
+
  public:
   /// Single constructor
   ExportOrdinalsSmooth ();
@@ -40,6 +44,36 @@ class ExportOrdinalsSmooth
   ExportValuesOrdinal ordinalsAtIntervalsGraph (const std::vector<double> &t,
                                                 const std::vector<SplinePair> &xy,
                                                 double pointsInterval) const;
+
+ private:
+
+  // Add breakpoints to the arc length table for tLow to tHigh, subdividing until the Gauss-Legendre estimate for the
+  // two halves agrees with the estimate for the whole
+  void arcLengthAdaptive (const Spline &spline,
+                          double tLow,
+                          double tHigh,
+                          double arcLengthWhole,
+                          double tolerance,
+                          int depth,
+                          std::vector<double> &tTable,
+                          std::vector<double> &sTable) const;
+
+  // Arc length from tLow to tHigh using fixed order Gauss-Legendre quadrature of the speed
+  double arcLengthGaussLegendre (const Spline &spline,
+                                 double tLow,
+                                 double tHigh) const;
+
+  // Build a table of cumulative arc length s versus t, with one or more entries per spline interval
+  void loadArcLengthTable (const Spline &spline,
+                           const std::vector<double> &t,
+                           std::vector<double> &tTable,
+                           std::vector<double> &sTable) const;
+
+  // Invert the arc length table to get t at arc length s
+  double tAtArcLength (const Spline &spline,
+                       const std::vector<double> &tTable,
+                       const std::vector<double> &sTable,
+                       double s) const;
 };
 
 #endif // EXPORT_ORDINALS_SMOOTH_H
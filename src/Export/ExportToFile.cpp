@@ -5,21 +5,67 @@
  ******************************************************************************************************/
 
 #include "Document.h"
+#include "ExportColumns.h"
+#include "ExportFileBinary.h"
 #include "ExportFileFunctions.h"
 #include "ExportFileRelations.h"
 #include "ExportToFile.h"
 #include "Logger.h"
 #include "MainWindowModel.h"
+#include <QFileInfo>
+#include <QIODevice>
 #include <QTextStream>
 #include "Transformation.h"
 
 const QString CSV_FILENAME_EXTENSION ("csv");
+const QString FLOAT64_FILENAME_EXTENSION ("f64");
+const QString NPY_FILENAME_EXTENSION ("npy");
+const QString NPZ_FILENAME_EXTENSION ("npz");
 const QString TSV_FILENAME_EXTENSION ("tsv");
 
 ExportToFile::ExportToFile()
 {
 }
 
+bool ExportToFile::exportToBinaryFile (const DocumentModelExportFormat &modelExport,
+                                       const Document &document,
+                                       const Transformation &transformation,
+                                       const QString &fileName,
+                                       QIODevice &device) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "ExportToFile::exportToBinaryFile";
+
+  // Functions come first, then relations, which matches the order of the text export
+  ExportColumns columns;
+
+  ExportFileFunctions exportFunctions;
+  exportFunctions.exportToColumns (modelExport,
+                                   document,
+                                   transformation,
+                                   columns);
+
+  ExportFileRelations exportRelations;
+  exportRelations.exportToColumns (modelExport,
+                                   document,
+                                   transformation,
+                                   columns);
+
+  ExportFileBinary exportBinary;
+  QString suffix = QFileInfo (fileName).suffix ();
+  if (suffix.compare (NPY_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0) {
+    exportBinary.writeNpy (columns,
+                           device);
+  } else if (suffix.compare (NPZ_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0) {
+    return exportBinary.writeNpz (columns,
+                                  device);
+  } else {
+    exportBinary.writeFloat64 (columns,
+                               device);
+  }
+
+  return true;
+}
+
 void ExportToFile::exportToFile (const DocumentModelExportFormat &modelExport,
                                  const Document &document,
                                  const MainWindowModel &modelMainWindow,
@@ -48,6 +94,21 @@ QString ExportToFile::fileExtensionCsv () const
   return CSV_FILENAME_EXTENSION;
 }
 
+QString ExportToFile::fileExtensionFloat64 () const
+{
+  return FLOAT64_FILENAME_EXTENSION;
+}
+
+QString ExportToFile::fileExtensionNpy () const
+{
+  return NPY_FILENAME_EXTENSION;
+}
+
+QString ExportToFile::fileExtensionNpz () const
+{
+  return NPZ_FILENAME_EXTENSION;
+}
+
 QString ExportToFile::fileExtensionTsv () const
 {
   return TSV_FILENAME_EXTENSION;
@@ -59,8 +120,35 @@ QString ExportToFile::filterCsv () const
       .arg (CSV_FILENAME_EXTENSION);
 }
 
+QString ExportToFile::filterFloat64 () const
+{
+  return QString ("Binary float64 (*.%1)")
+      .arg (FLOAT64_FILENAME_EXTENSION);
+}
+
+QString ExportToFile::filterNpy () const
+{
+  return QString ("NumPy NPY (*.%1)")
+      .arg (NPY_FILENAME_EXTENSION);
+}
+
+QString ExportToFile::filterNpz () const
+{
+  return QString ("NumPy NPZ (*.%1)")
+      .arg (NPZ_FILENAME_EXTENSION);
+}
+
 QString ExportToFile::filterTsv () const
 {
   return QString ("Text TSV (*.%1)")
       .arg (TSV_FILENAME_EXTENSION);
 }
+
+bool ExportToFile::isBinaryFileName (const QString &fileName) const
+{
+  QString suffix = QFileInfo (fileName).suffix ();
+
+  return (suffix.compare (FLOAT64_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0 ||
+          suffix.compare (NPY_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0 ||
+          suffix.compare (NPZ_FILENAME_EXTENSION, Qt::CaseInsensitive) == 0);
+}
@@ -12,6 +12,7 @@
 class Document;
 class DocumentModelExportFormat;
 class MainWindowModel;
+class QIODevice;
 class QTextStream;
 class Transformation;
 
@@ -28,6 +29,15 @@ public:
   /// Single constructor.
   ExportToFile();
 
+  /// Export unformatted Document values to a binary file, in the format selected by the file extension. Curves and
+  /// points are selected as for text export, but there is no number formatting. Returns false if the values do not fit
+  /// in the selected format
+  bool exportToBinaryFile (const DocumentModelExportFormat &modelExport,
+                           const Document &document,
+                           const Transformation &transformation,
+                           const QString &fileName,
+                           QIODevice &device) const;
+
   /// Export Document points according to the settings. The DocumentModelExportFormat inside the Document is ignored so
   /// DlgSettingsExport can supply its own DocumentModelExportFormat when previewing what would be exported.
   void exportToFile (const DocumentModelExportFormat &modelExport,
@@ -39,15 +49,36 @@ public:
   /// File extension for csv export files
   QString fileExtensionCsv () const;
 
+  /// File extension for raw float64 export files
+  QString fileExtensionFloat64 () const;
+
+  /// File extension for NumPy npy export files
+  QString fileExtensionNpy () const;
+
+  /// File extension for NumPy npz export files
+  QString fileExtensionNpz () const;
+
   /// File extension for tsv export files
   QString fileExtensionTsv () const;
 
   /// QFileDialog filter for CSV files
   QString filterCsv () const;
 
+  /// QFileDialog filter for raw float64 files
+  QString filterFloat64 () const;
+
+  /// QFileDialog filter for NumPy npy files
+  QString filterNpy () const;
+
+  /// QFileDialog filter for NumPy npz files
+  QString filterNpz () const;
+
   /// QFileDialog filter for TSV files
   QString filterTsv () const;
 
+  /// True if the file extension selects one of the binary formats rather than text
+  bool isBinaryFileName (const QString &fileName) const;
+
 };
 
 #endif // EXPORT_TO_FILE_H
@@ -0,0 +1,78 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "ExportYRadiusValues.h"
+
+ExportYRadiusValues::ExportYRadiusValues (int curveCount,
+                                          int xThetaCount) :
+  m_curveCount (curveCount),
+  m_xThetaCount (xThetaCount),
+  m_xTheta (curveCount * xThetaCount),
+  m_yRadius (curveCount * xThetaCount),
+  m_hasValue (curveCount * xThetaCount, false)
+{
+}
+
+int ExportYRadiusValues::curveCount () const
+{
+  return m_curveCount;
+}
+
+bool ExportYRadiusValues::hasValue (int col,
+                                    int row) const
+{
+  return m_hasValue [index (col, row)];
+}
+
+int ExportYRadiusValues::index (int col,
+                                int row) const
+{
+  ENGAUGE_ASSERT ((0 <= col) && (col < m_curveCount));
+  ENGAUGE_ASSERT ((0 <= row) && (row < m_xThetaCount));
+
+  return col * m_xThetaCount + row;
+}
+
+bool ExportYRadiusValues::rowHasAtLeastOneValue (int row) const
+{
+  for (int col = 0; col < m_curveCount; col++) {
+    if (m_hasValue [index (col, row)]) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void ExportYRadiusValues::setValue (int col,
+                                    int row,
+                                    double xTheta,
+                                    double yRadius)
+{
+  int i = col * m_xThetaCount + row;
+
+  m_xTheta [i] = xTheta;
+  m_yRadius [i] = yRadius;
+  m_hasValue [i] = true;
+}
+
+double ExportYRadiusValues::xTheta (int col,
+                                    int row) const
+{
+  return m_xTheta [index (col, row)];
+}
+
+int ExportYRadiusValues::xThetaCount () const
+{
+  return m_xThetaCount;
+}
+
+double ExportYRadiusValues::yRadius (int col,
+                                     int row) const
+{
+  return m_yRadius [index (col, row)];
+}
@@ -0,0 +1,69 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef EXPORT_Y_RADIUS_VALUES_H
+#define EXPORT_Y_RADIUS_VALUES_H
+
+#include <QVector>
+
+/// Compact table of unformatted y/radius values indexed by (included) curve and x/theta row. Values are kept as
+/// numbers, rather than as formatted strings, until each row is output. Cells without a value are output as blanks.
+/// Each cell also keeps the x/theta value that goes with its y/radius value, since that affects the formatting.
+///
+/// Cells of different curves may be set concurrently from separate threads
+class ExportYRadiusValues
+{
+public:
+  /// Single constructor. Every cell starts out without a value
+  ExportYRadiusValues (int curveCount,
+                       int xThetaCount);
+
+  /// Number of curves, which is the number of columns
+  int curveCount () const;
+
+  /// True if the cell has a value
+  bool hasValue (int col,
+                 int row) const;
+
+  /// True if at least one curve has a value in the row. Rows without values are not output since the union of all
+  /// x/theta values is applied to each curve
+  bool rowHasAtLeastOneValue (int row) const;
+
+  /// Set the value of a cell. Since this is called from worker threads the bounds are not asserted here, so callers
+  /// check the table size before dispatching the workers
+  void setValue (int col,
+                 int row,
+                 double xTheta,
+                 double yRadius);
+
+  /// X/theta value that goes with the y/radius value of the cell
+  double xTheta (int col,
+                 int row) const;
+
+  /// Number of x/theta values, which is the number of rows
+  int xThetaCount () const;
+
+  /// Y/radius value of the cell
+  double yRadius (int col,
+                  int row) const;
+
+private:
+  ExportYRadiusValues ();
+
+  int index (int col,
+             int row) const;
+
+  int m_curveCount;
+  int m_xThetaCount;
+
+  // Stored curve by curve so threads that fill separate curves write to separate memory. Output, which is row by row,
+  // strides across the curves instead
+  QVector<double> m_xTheta;
+  QVector<double> m_yRadius;
+  QVector<bool> m_hasValue;
+};
+
+#endif // EXPORT_Y_RADIUS_VALUES_H
@@ -0,0 +1,109 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "FittingIncremental.h"
+#include "FittingStatistics.h"
+#include "Logger.h"
+
+FittingIncremental::FittingIncremental () :
+  m_leastSquares (MAX_POLYNOMIAL_ORDER),
+  m_downdates (0)
+{
+}
+
+void FittingIncremental::clear ()
+{
+  m_identifierToPoint.clear ();
+  m_leastSquares = FittingLeastSquares (MAX_POLYNOMIAL_ORDER);
+  m_downdates = 0;
+}
+
+void FittingIncremental::downdate (const QPointF &point)
+{
+  // Downdates are the costly and less accurate part, so starting over is better once there have been many
+  if (++m_downdates > m_identifierToPoint.count () ||
+      !m_leastSquares.removePoint (point.x (),
+                                   point.y ())) {
+
+    rebuildFromPoints ();
+  }
+}
+
+FittingLeastSquares &FittingIncremental::leastSquares ()
+{
+  return m_leastSquares;
+}
+
+int FittingIncremental::numPoints () const
+{
+  return m_identifierToPoint.count ();
+}
+
+void FittingIncremental::rebuild (const QStringList &identifiers,
+                                  const FittingPointsConvenient &points)
+{
+  ENGAUGE_ASSERT (identifiers.count () == points.count ());
+
+  m_identifierToPoint.clear ();
+  m_identifierToPoint.reserve (points.count ());
+  for (int i = 0; i < points.count (); i++) {
+    m_identifierToPoint [identifiers.at (i)] = points.at (i);
+  }
+
+  rebuildFromPoints ();
+}
+
+void FittingIncremental::rebuildFromPoints ()
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "FittingIncremental::rebuildFromPoints"
+                              << " points=" << m_identifierToPoint.count ();
+
+  m_leastSquares = FittingLeastSquares (MAX_POLYNOMIAL_ORDER);
+  m_downdates = 0;
+
+  IdentifierToPoint::const_iterator itr;
+  for (itr = m_identifierToPoint.begin (); itr != m_identifierToPoint.end (); itr++) {
+    m_leastSquares.addPoint (itr.value ().x (),
+                             itr.value ().y ());
+  }
+}
+
+void FittingIncremental::removePoint (const QString &identifier)
+{
+  IdentifierToPoint::iterator itr = m_identifierToPoint.find (identifier);
+  if (itr != m_identifierToPoint.end ()) {
+
+    QPointF pointOld = itr.value ();
+    m_identifierToPoint.erase (itr);
+
+    downdate (pointOld);
+  }
+}
+
+void FittingIncremental::setPoint (const QString &identifier,
+                                   const QPointF &point)
+{
+  IdentifierToPoint::iterator itr = m_identifierToPoint.find (identifier);
+  if (itr == m_identifierToPoint.end ()) {
+
+    m_identifierToPoint [identifier] = point;
+    m_leastSquares.addPoint (point.x (),
+                             point.y ());
+
+  } else if (itr.value () != point) {
+
+    // Moved point is removed and then added back at its new position. Whether the downdate succeeded or fell back
+    // to a rebuild, the factor then holds every point except this one
+    QPointF pointOld = itr.value ();
+    m_identifierToPoint.erase (itr);
+    downdate (pointOld);
+
+    m_identifierToPoint [identifier] = point;
+    m_leastSquares.addPoint (point.x (),
+                             point.y ());
+  }
+}
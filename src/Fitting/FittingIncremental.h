@@ -0,0 +1,63 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FITTING_INCREMENTAL_H
+#define FITTING_INCREMENTAL_H
+
+#include "FittingLeastSquares.h"
+#include "FittingPointsConvenient.h"
+#include <QHash>
+#include <QPointF>
+#include <QString>
+#include <QStringList>
+
+/// Least squares state of the curve shown by FittingWindow, kept between commands so the fit is not recomputed from
+/// all points after every command. The command reports which points it added, removed or moved, and only those points
+/// are applied to the QR factor, as updates, downdates, or both. The factor is rebuilt from the stored points when a
+/// downdate is not possible, or once the downdates since the last rebuild outnumber the points, which bounds the drift
+/// from rounding
+class FittingIncremental
+{
+public:
+  /// Single constructor
+  FittingIncremental ();
+
+  /// Discard all points
+  void clear ();
+
+  /// Least squares engine holding the current points. Its order is MAX_POLYNOMIAL_ORDER, which can solve every
+  /// lower order too
+  FittingLeastSquares &leastSquares ();
+
+  /// Number of points
+  int numPoints () const;
+
+  /// Replace all points. Points are in graph coordinates
+  void rebuild (const QStringList &identifiers,
+                const FittingPointsConvenient &points);
+
+  /// Remove the point, if present
+  void removePoint (const QString &identifier);
+
+  /// Add the point, or move it if it is already present
+  void setPoint (const QString &identifier,
+                 const QPointF &point);
+
+private:
+
+  typedef QHash<QString, QPointF> IdentifierToPoint;
+
+  // Downdate the point out of the factor, falling back to a rebuild from m_identifierToPoint, which must
+  // already exclude the point, if that fails or the downdates have piled up
+  void downdate (const QPointF &point);
+  void rebuildFromPoints ();
+
+  IdentifierToPoint m_identifierToPoint;
+  FittingLeastSquares m_leastSquares;
+  int m_downdates; // Downdates since the last rebuild
+};
+
+#endif // FITTING_INCREMENTAL_H
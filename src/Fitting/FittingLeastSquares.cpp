@@ -0,0 +1,236 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "FittingLeastSquares.h"
+#include <qmath.h>
+
+// Rows per block. Each fold costs about (BLOCK_ROWS + m_cols) * m_cols^2 operations on data that fits in cache
+const int BLOCK_ROWS = 256;
+
+// Diagonal entries of R below this fraction of the norm of their own column of R are treated as zero
+const double RELATIVE_RANK_TOLERANCE = 1e-13;
+
+FittingLeastSquares::FittingLeastSquares (int order) :
+  m_order (order),
+  m_cols (order + 2),
+  m_block (BLOCK_ROWS * (order + 2)),
+  m_blockRows (0),
+  m_r ((order + 2) * (order + 2), 0.0),
+  m_rRows (0)
+{
+  ENGAUGE_ASSERT (order >= 0);
+}
+
+void FittingLeastSquares::addPoint (double x,
+                                    double y)
+{
+  loadRow (x,
+           y,
+           m_block.data () + m_blockRows,
+           BLOCK_ROWS);
+
+  if (++m_blockRows == BLOCK_ROWS) {
+    foldBlock ();
+  }
+}
+
+void FittingLeastSquares::foldBlock ()
+{
+  if (m_blockRows == 0) {
+    return;
+  }
+
+  // Work matrix is R stacked on top of the block, stored column by column
+  int rows = m_rRows + m_blockRows;
+  QVector<double> work (rows * m_cols);
+  int row, col;
+  for (col = 0; col < m_cols; col++) {
+    double *workCol = work.data () + col * rows;
+    for (row = 0; row < m_rRows; row++) {
+      workCol [row] = m_r [col * m_cols + row];
+    }
+    for (row = 0; row < m_blockRows; row++) {
+      workCol [m_rRows + row] = m_block [col * BLOCK_ROWS + row];
+    }
+  }
+
+  // Householder reflections zero out each column below the diagonal
+  int steps = qMin (rows, m_cols);
+  for (int k = 0; k < steps; k++) {
+
+    double *colK = work.data () + k * rows;
+
+    double norm = 0;
+    for (row = k; row < rows; row++) {
+      norm += colK [row] * colK [row];
+    }
+    norm = qSqrt (norm);
+
+    if (norm == 0) {
+      continue; // Column is already zero below the diagonal
+    }
+
+    // Reflection vector v = x - alpha * e1 is kept in place of the column, with alpha chosen to avoid cancellation
+    double alpha = (colK [k] > 0 ? -norm : norm);
+    colK [k] -= alpha;
+    double vNormSquared = 0;
+    for (row = k; row < rows; row++) {
+      vNormSquared += colK [row] * colK [row];
+    }
+
+    // Apply I - 2 v vT / (vT v) to the remaining columns
+    for (col = k + 1; col < m_cols; col++) {
+      double *colJ = work.data () + col * rows;
+      double dot = 0;
+      for (row = k; row < rows; row++) {
+        dot += colK [row] * colJ [row];
+      }
+      double factor = 2.0 * dot / vNormSquared;
+      for (row = k; row < rows; row++) {
+        colJ [row] -= factor * colK [row];
+      }
+    }
+
+    // Column k becomes alpha on the diagonal and zero below
+    colK [k] = alpha;
+    for (row = k + 1; row < rows; row++) {
+      colK [row] = 0;
+    }
+  }
+
+  // Keep the upper triangle
+  m_rRows = steps;
+  for (col = 0; col < m_cols; col++) {
+    for (row = 0; row < m_cols; row++) {
+      m_r [col * m_cols + row] = (row < m_rRows && row <= col ?
+                                  work [col * rows + row] :
+                                  0.0);
+    }
+  }
+
+  m_blockRows = 0;
+}
+
+void FittingLeastSquares::loadRow (double x,
+                                   double y,
+                                   double *row,
+                                   int stride) const
+{
+  // Powers by successive multiplication rather than qPow
+  double power = 1.0;
+  for (int col = 0; col <= m_order; col++) {
+    row [col * stride] = power;
+    power *= x;
+  }
+  row [(m_cols - 1) * stride] = y;
+}
+
+int FittingLeastSquares::order () const
+{
+  return m_order;
+}
+
+bool FittingLeastSquares::removePoint (double x,
+                                       double y)
+{
+  foldBlock ();
+
+  if (m_rRows < m_cols) {
+    return false; // R is not square so the downdate below does not apply
+  }
+
+  // Downdate of R so that RT R loses z zT, as done by LINPACK dchdd. Solve RT p = z by forward substitution
+  QVector<double> p (m_cols);
+  loadRow (x,
+           y,
+           p.data (),
+           1);
+
+  int row, col;
+  double norm = 0;
+  for (row = 0; row < m_cols; row++) {
+    double sum = p [row];
+    for (int k = 0; k < row; k++) {
+      sum -= m_r [row * m_cols + k] * p [k];
+    }
+    if (m_r [row * m_cols + row] == 0) {
+      return false;
+    }
+    p [row] = sum / m_r [row * m_cols + row];
+    norm += p [row] * p [row];
+  }
+
+  // Point is not representable by the remaining points if p has unit length or more. The negated comparison also
+  // catches non-finite values
+  if (!(norm < 1.0)) {
+    return false;
+  }
+
+  // Rotations that zero p from the bottom up, against alpha
+  QVector<double> cosines (m_cols), sines (m_cols);
+  double alpha = qSqrt (1.0 - norm);
+  for (row = m_cols - 1; row >= 0; row--) {
+    double scale = alpha + qAbs (p [row]);
+    double a = alpha / scale;
+    double b = p [row] / scale;
+    double hypotenuse = qSqrt (a * a + b * b);
+    cosines [row] = a / hypotenuse;
+    sines [row] = b / hypotenuse;
+    alpha = scale * hypotenuse;
+  }
+
+  // Apply the rotations to each column of R
+  for (col = 0; col < m_cols; col++) {
+    double *rCol = m_r.data () + col * m_cols;
+    double carry = 0;
+    for (row = col; row >= 0; row--) {
+      double value = cosines [row] * carry + sines [row] * rCol [row];
+      rCol [row] = cosines [row] * rCol [row] - sines [row] * carry;
+      carry = value;
+    }
+  }
+
+  return true;
+}
+
+void FittingLeastSquares::solve (int order,
+                                 QVector<double> &coefficients)
+{
+  ENGAUGE_ASSERT (order <= m_order);
+
+  foldBlock ();
+
+  int n = order + 1;
+  coefficients.resize (n);
+
+  // Back substitution in R a = QT y, where QT y is the last column of R
+  for (int k = n - 1; k >= 0; k--) {
+
+    // Column k of R has the same norm as column k of X, and the diagonal entry over that norm is the sine of the angle
+    // between column k and the previous columns. Unlike a comparison against the other diagonal entries, this test
+    // does not depend on the scale of x, which multiplies column k by scale^k
+    double columnNormSquared = 0;
+    for (int row = 0; row <= k && row < m_rRows; row++) {
+      columnNormSquared += m_r [k * m_cols + row] * m_r [k * m_cols + row];
+    }
+    double diagonalMin = RELATIVE_RANK_TOLERANCE * qSqrt (columnNormSquared);
+
+    double diagonal = (k < m_rRows ? m_r [k * m_cols + k] : 0.0);
+    if (qAbs (diagonal) <= diagonalMin) {
+
+      coefficients [k] = 0;
+
+    } else {
+
+      double sum = m_r [(m_cols - 1) * m_cols + k];
+      for (int col = k + 1; col < n; col++) {
+        sum -= m_r [col * m_cols + k] * coefficients [col];
+      }
+      coefficients [k] = sum / diagonal;
+    }
+  }
+}
@@ -0,0 +1,72 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FITTING_LEAST_SQUARES_H
+#define FITTING_LEAST_SQUARES_H
+
+#include <QVector>
+
+/// Least squares solver for the polynomial y = a0 + a1 * x + ... + an * x^n, used by FittingStatistics.
+///
+/// Points are streamed in. They are buffered in small blocks which are folded, by Householder QR, into the upper
+/// triangular factor R of the augmented matrix [X y]. The full X matrix is never built, so memory does not grow
+/// with the number of points, and the normal equations, which square the condition number, are never formed. The
+/// coefficients come from back substitution on R.
+///
+/// Points can also be removed, by downdating R, so a fit can be kept up to date as points are added, removed and
+/// moved. Since the leading columns of R are the factor for the leading columns of X, one instance also solves for every
+/// lower order
+class FittingLeastSquares
+{
+public:
+  /// Single constructor for polynomials of the specified order
+  FittingLeastSquares (int order);
+
+  /// Add one point
+  void addPoint (double x,
+                 double y);
+
+  /// Order given to the constructor
+  int order () const;
+
+  /// Remove a point that was added earlier. Returns false, leaving this instance unusable, if the downdate is not
+  /// possible. That happens when too few points would remain to define R, or when rounding makes the downdated
+  /// matrix appear indefinite. The caller should then start over with a new instance
+  bool removePoint (double x,
+                    double y);
+
+  /// Solve for the coefficients a0 through a(order) of the points so far, with order not above the constructor order.
+  /// A coefficient whose column of X is not independent of the previous columns, which happens when there are too
+  /// few distinct x values, is set to zero
+  void solve (int order,
+              QVector<double> &coefficients);
+
+private:
+  FittingLeastSquares ();
+
+  // Fold the buffered block of points into R
+  void foldBlock ();
+
+  // Load one row of [X y] into the specified array, with the specified stride between columns
+  void loadRow (double x,
+                double y,
+                double *row,
+                int stride) const;
+
+  int m_order;
+  int m_cols; // Columns in augmented matrix [X y], which is m_order + 2
+
+  // Buffered points that have not been folded into R yet, stored column by column with BLOCK_ROWS entries per column
+  QVector<double> m_block;
+  int m_blockRows;
+
+  // Upper triangular factor of [X y], stored column by column with m_cols entries per column. Only the first
+  // m_rRows rows are meaningful, with fewer than m_cols rows when fewer than m_cols points have been added
+  QVector<double> m_r;
+  int m_rRows;
+};
+
+#endif // FITTING_LEAST_SQUARES_H
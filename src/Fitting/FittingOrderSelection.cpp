@@ -0,0 +1,152 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "FittingOrderSelection.h"
+#include "FittingOrderSelectionWorker.h"
+#include "FittingStatistics.h"
+#include <qmath.h>
+#include <qnumeric.h>
+#include "RunnableBatch.h"
+
+// Mean square errors are floored at this fraction of the mean square of y. Smaller residuals are rounding rather than
+// fit, and without the floor exact fits would have logarithms going to minus infinity
+const double MSE_FLOOR_RELATIVE = 1e-20;
+
+FittingOrderSelection::FittingOrderSelection () :
+  m_orderBest (-1)
+{
+}
+
+FittingOrderSelection::FittingOrderSelection (int maxOrder,
+                                              const FittingPointsConvenient &pointsConvenient,
+                                              FittingLeastSquares &leastSquares) :
+  m_orderBest (-1)
+{
+  // Same reduction as FittingStatistics so every fit is determined
+  int orderMax = qMin (maxOrder,
+                       pointsConvenient.count () - 1);
+  if (orderMax < 0) {
+    return;
+  }
+
+  int numOrders = orderMax + 1;
+  m_coefficients.resize (numOrders);
+  m_criterion.resize (numOrders);
+  m_mse.resize (numOrders);
+  m_rms.resize (numOrders);
+  m_rSquared.resize (numOrders);
+
+  // Coefficients of every order come from the one decomposition. Back substitution is cheap, and the engine is not
+  // thread safe, so this is done before the workers start
+  FittingStatistics fittingStatistics;
+  int order;
+  for (order = 0; order <= orderMax; order++) {
+
+    m_coefficients [order].resize (MAX_POLYNOMIAL_ORDER + 1);
+    fittingStatistics.calculateCurveFit (order,
+                                         leastSquares,
+                                         m_coefficients [order]);
+  }
+
+  // Each order needs a pass over all points for its statistics, so the orders are computed concurrently
+  RunnableBatch batch;
+  for (order = 0; order <= orderMax; order++) {
+
+    batch.start (new FittingOrderSelectionWorker (pointsConvenient,
+                                                  m_coefficients.at (order),
+                                                  m_mse [order],
+                                                  m_rms [order],
+                                                  m_rSquared [order]));
+  }
+
+  batch.waitForDone ();
+
+  double ySquaredSum = 0;
+  FittingPointsConvenient::const_iterator itr;
+  for (itr = pointsConvenient.begin (); itr != pointsConvenient.end (); itr++) {
+    ySquaredSum += itr->y () * itr->y ();
+  }
+  double mseFloor = MSE_FLOOR_RELATIVE * ySquaredSum / pointsConvenient.count ();
+
+  // Without a finite criterion, such as with very few points, the exact fit is used just like in the manual mode
+  m_orderBest = orderMax;
+  double criterionBest = qInf ();
+  for (order = 0; order <= orderMax; order++) {
+
+    m_criterion [order] = criterionFromMse (order,
+                                            pointsConvenient.count (),
+                                            m_mse.at (order),
+                                            mseFloor);
+    if (m_criterion.at (order) < criterionBest) {
+      criterionBest = m_criterion.at (order);
+      m_orderBest = order;
+    }
+  }
+}
+
+FittingCurveCoefficients FittingOrderSelection::coefficients (int order) const
+{
+  ENGAUGE_ASSERT (0 <= order && order < m_coefficients.count ());
+
+  return m_coefficients.at (order);
+}
+
+double FittingOrderSelection::criterion (int order) const
+{
+  ENGAUGE_ASSERT (0 <= order && order < m_criterion.count ());
+
+  return m_criterion.at (order);
+}
+
+double FittingOrderSelection::criterionFromMse (int order,
+                                                int numPoints,
+                                                double mse,
+                                                double mseFloor) const
+{
+  // Corrected Akaike information criterion for least squares with normally distributed residuals. The parameters
+  // are the coefficients plus the variance of the residuals
+  int numParameters = order + 2;
+  int denominator = numPoints - numParameters - 1;
+  if (denominator <= 0) {
+    return qInf ();
+  }
+
+  return numPoints * qLn (qMax (mse, mseFloor)) +
+      2.0 * numParameters +
+      2.0 * numParameters * (numParameters + 1) / denominator;
+}
+
+double FittingOrderSelection::mse (int order) const
+{
+  ENGAUGE_ASSERT (0 <= order && order < m_mse.count ());
+
+  return m_mse.at (order);
+}
+
+int FittingOrderSelection::orderBest () const
+{
+  return m_orderBest;
+}
+
+int FittingOrderSelection::orderMax () const
+{
+  return m_coefficients.count () - 1;
+}
+
+double FittingOrderSelection::rms (int order) const
+{
+  ENGAUGE_ASSERT (0 <= order && order < m_rms.count ());
+
+  return m_rms.at (order);
+}
+
+double FittingOrderSelection::rSquared (int order) const
+{
+  ENGAUGE_ASSERT (0 <= order && order < m_rSquared.count ());
+
+  return m_rSquared.at (order);
+}
@@ -0,0 +1,73 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FITTING_ORDER_SELECTION_H
+#define FITTING_ORDER_SELECTION_H
+
+#include "FittingCurveCoefficients.h"
+#include "FittingPointsConvenient.h"
+#include <QVector>
+
+class FittingLeastSquares;
+
+/// Curve fits of every order from zero up to the highest order that the points support, with their statistics, and
+/// the order that is best according to an information criterion. This is used by the automatic order mode of
+/// FittingWindow.
+///
+/// The coefficients of all orders come from one shared QR decomposition, since the leading block of the highest order
+/// factor is the factor of each lower order. The statistics of the orders, which each need a pass over all points,
+/// are computed concurrently. The criterion is the corrected Akaike information criterion (AICc), which balances the
+/// mean square error against the number of coefficients and stays conservative when there are few points
+class FittingOrderSelection
+{
+public:
+  /// Default constructor, with no orders evaluated, for the Qt metatype system
+  FittingOrderSelection ();
+
+  /// Evaluate every order up to maxOrder, reduced if there are too few points, using a least squares engine that holds
+  /// exactly the specified points and whose order is at least maxOrder. This runs outside the GUI thread
+  FittingOrderSelection (int maxOrder,
+                         const FittingPointsConvenient &pointsConvenient,
+                         FittingLeastSquares &leastSquares);
+
+  /// Coefficients of the fit of the specified order
+  FittingCurveCoefficients coefficients (int order) const;
+
+  /// Information criterion of the specified order. Lower is better. Infinite if there are too few points for the
+  /// criterion to be defined, in which case the order is never selected unless no order has a finite criterion
+  double criterion (int order) const;
+
+  /// Mean square error of the specified order
+  double mse (int order) const;
+
+  /// Selected order, or -1 if there are no points
+  int orderBest () const;
+
+  /// Highest order that was evaluated, or -1 if there are no points
+  int orderMax () const;
+
+  /// Root mean square error of the specified order
+  double rms (int order) const;
+
+  /// R squared of the specified order
+  double rSquared (int order) const;
+
+private:
+
+  double criterionFromMse (int order,
+                           int numPoints,
+                           double mse,
+                           double mseFloor) const;
+
+  int m_orderBest;
+  QVector<FittingCurveCoefficients> m_coefficients;
+  QVector<double> m_criterion;
+  QVector<double> m_mse;
+  QVector<double> m_rms;
+  QVector<double> m_rSquared;
+};
+
+#endif // FITTING_ORDER_SELECTION_H
@@ -0,0 +1,61 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "FittingOrderSelectionThread.h"
+#include "FittingStatistics.h"
+#include "Logger.h"
+
+FittingOrderSelectionThread::FittingOrderSelectionThread () :
+  m_requestId (0),
+  m_maxOrder (0),
+  m_leastSquares (MAX_POLYNOMIAL_ORDER),
+  m_requestIdTaken (0),
+  m_maxOrderTaken (0),
+  m_leastSquaresTaken (MAX_POLYNOMIAL_ORDER)
+{
+}
+
+void FittingOrderSelectionThread::processRequest ()
+{
+  // No logging here, since this is not the GUI thread
+  FittingOrderSelection orderSelection (m_maxOrderTaken,
+                                        m_pointsConvenientTaken,
+                                        m_leastSquaresTaken);
+
+  emit signalOrderSelection (m_requestIdTaken,
+                             orderSelection);
+}
+
+void FittingOrderSelectionThread::request (int requestId,
+                                           int maxOrder,
+                                           const FittingPointsConvenient &pointsConvenient,
+                                           const FittingLeastSquares &leastSquares)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "FittingOrderSelectionThread::request"
+                              << " request=" << requestId
+                              << " points=" << pointsConvenient.count ();
+
+  // Checked here since a failure cannot be reported from the thread. FittingLeastSquares::solve asserts the same
+  ENGAUGE_ASSERT (maxOrder <= leastSquares.order ());
+
+  beginRequest ();
+
+  m_requestId = requestId;
+  m_maxOrder = maxOrder;
+  m_pointsConvenient = pointsConvenient;
+  m_leastSquares = leastSquares;
+
+  endRequest ();
+}
+
+void FittingOrderSelectionThread::takeRequest ()
+{
+  m_requestIdTaken = m_requestId;
+  m_maxOrderTaken = m_maxOrder;
+  m_pointsConvenientTaken = m_pointsConvenient;
+  m_leastSquaresTaken = m_leastSquares;
+}
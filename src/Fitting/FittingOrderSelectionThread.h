@@ -0,0 +1,61 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FITTING_ORDER_SELECTION_THREAD_H
+#define FITTING_ORDER_SELECTION_THREAD_H
+
+#include "CoalescingThread.h"
+#include "FittingLeastSquares.h"
+#include "FittingOrderSelection.h"
+#include "FittingPointsConvenient.h"
+
+/// Thread that runs FittingOrderSelection for the automatic order mode of FittingWindow, so the GUI thread is not
+/// blocked while every order is evaluated. The only assertions on that path are on the order, which request checks
+/// in the GUI thread
+class FittingOrderSelectionThread : public CoalescingThread
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor
+  FittingOrderSelectionThread ();
+
+  /// Queue an evaluation of the points, which are exactly the points held by the least squares engine. Both are
+  /// copied. The maximum order must not be above the order of the engine. The thread is started if it is not already
+  /// running
+  void request (int requestId,
+                int maxOrder,
+                const FittingPointsConvenient &pointsConvenient,
+                const FittingLeastSquares &leastSquares);
+
+signals:
+  /// Send the evaluation of one request back to the GUI thread
+  void signalOrderSelection (int requestId,
+                             FittingOrderSelection orderSelection);
+
+protected:
+  /// Evaluate the request taken by takeRequest
+  virtual void processRequest ();
+
+  /// Copy out the latest request
+  virtual void takeRequest ();
+
+private:
+
+  // Latest request, guarded by the lock of CoalescingThread
+  int m_requestId;
+  int m_maxOrder;
+  FittingPointsConvenient m_pointsConvenient;
+  FittingLeastSquares m_leastSquares;
+
+  // Request being evaluated, used only by this thread
+  int m_requestIdTaken;
+  int m_maxOrderTaken;
+  FittingPointsConvenient m_pointsConvenientTaken;
+  FittingLeastSquares m_leastSquaresTaken;
+};
+
+#endif // FITTING_ORDER_SELECTION_THREAD_H
@@ -0,0 +1,32 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "FittingOrderSelectionWorker.h"
+#include "FittingStatistics.h"
+
+FittingOrderSelectionWorker::FittingOrderSelectionWorker (const FittingPointsConvenient &pointsConvenient,
+                                                          const FittingCurveCoefficients &coefficients,
+                                                          double &mse,
+                                                          double &rms,
+                                                          double &rSquared) :
+  m_pointsConvenient (pointsConvenient),
+  m_coefficients (coefficients),
+  m_mse (mse),
+  m_rms (rms),
+  m_rSquared (rSquared)
+{
+}
+
+void FittingOrderSelectionWorker::run ()
+{
+  FittingStatistics fittingStatistics;
+
+  fittingStatistics.calculateStatistics (m_pointsConvenient,
+                                         m_coefficients,
+                                         m_mse,
+                                         m_rms,
+                                         m_rSquared);
+}
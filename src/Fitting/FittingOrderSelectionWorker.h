@@ -0,0 +1,39 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FITTING_ORDER_SELECTION_WORKER_H
+#define FITTING_ORDER_SELECTION_WORKER_H
+
+#include "FittingCurveCoefficients.h"
+#include "FittingPointsConvenient.h"
+#include <QRunnable>
+
+/// Runnable that computes the statistics of one order for FittingOrderSelection. Each worker writes only the
+/// statistics of its own order, so the workers for all orders can run concurrently
+class FittingOrderSelectionWorker : public QRunnable
+{
+public:
+  /// Single constructor
+  FittingOrderSelectionWorker (const FittingPointsConvenient &pointsConvenient,
+                               const FittingCurveCoefficients &coefficients,
+                               double &mse,
+                               double &rms,
+                               double &rSquared);
+
+  /// Compute the statistics of this order
+  virtual void run ();
+
+private:
+  FittingOrderSelectionWorker ();
+
+  const FittingPointsConvenient &m_pointsConvenient;
+  const FittingCurveCoefficients &m_coefficients;
+  double &m_mse;
+  double &m_rms;
+  double &m_rSquared;
+};
+
+#endif // FITTING_ORDER_SELECTION_WORKER_H
@@ -4,11 +4,10 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
-#include "EngaugeAssert.h"
 #include "FittingCurveCoefficients.h"
+#include "FittingLeastSquares.h"
 #include "FittingStatistics.h"
 #include "Logger.h"
-#include "Matrix.h"
 #include <QApplication>
 #include <qmath.h>
 
@@ -21,29 +20,16 @@ FittingStatistics::~FittingStatistics()
 }
 
 void FittingStatistics::calculateCurveFit (int orderReduced,
-                                           const FittingPointsConvenient &pointsConvenient,
+                                           FittingLeastSquares &leastSquares,
                                            FittingCurveCoefficients &coefficients)
 {
   QVector<double> a; // Unused if there are no points
 
   if (0 <= orderReduced) {
 
-    // Calculate X and y arrays in y = X a
-    Matrix X (pointsConvenient.size (), orderReduced + 1);
-    QVector<double> Y (pointsConvenient.size ());
-    loadXAndYArrays (orderReduced,
-                     pointsConvenient,
-                     X,
-                     Y);
-
-    // Solve for the coefficients a in y = X a + epsilon using a = (Xtranpose X)^(-1) Xtranspose y
-    Matrix denominator = X.transpose () * X;
-    LOG4CPP_DEBUG_S ((*mainCat)) << "FittingStatistics::calculateCurveFit determinant=" << denominator.determinant();
-    a = denominator.inverse () * X.transpose () * Y;
-
-    Matrix expectedIdentity = denominator * denominator.inverse ();
-    LOG4CPP_DEBUG_S ((*mainCat)) << "FittingStatistics::calculateCurveFit expectedIdentity="
-                                 << expectedIdentity.toString ().toLatin1().data ();
+    // Solve for the coefficients a in y = X a + epsilon using the QR decomposition of the points
+    leastSquares.solve (orderReduced,
+                        a);
   }
 
   // Copy coefficients into member variable and into list for sending as a signal
@@ -71,18 +57,41 @@ void FittingStatistics::calculateCurveFitAndStatistics (unsigned int order,
                                                         double &mse,
                                                         double &rms,
                                                         double &rSquared)
+{
+  // Points are streamed into the QR decomposition
+  FittingLeastSquares leastSquares (qMax (0, orderReduced (order,
+                                                           pointsConvenient)));
+  FittingPointsConvenient::const_iterator itr;
+  for (itr = pointsConvenient.begin(); itr != pointsConvenient.end(); itr++) {
+
+    const QPointF &p = *itr;
+    leastSquares.addPoint (p.x (),
+                           p.y ());
+  }
+
+  calculateCurveFitAndStatistics (order,
+                                  pointsConvenient,
+                                  leastSquares,
+                                  coefficients,
+                                  mse,
+                                  rms,
+                                  rSquared);
+}
+
+void FittingStatistics::calculateCurveFitAndStatistics (unsigned int order,
+                                                        const FittingPointsConvenient &pointsConvenient,
+                                                        FittingLeastSquares &leastSquares,
+                                                        FittingCurveCoefficients &coefficients,
+                                                        double &mse,
+                                                        double &rms,
+                                                        double &rSquared)
 {
   // Let user know something is happening if a high order was picked since that can take a long time
   qApp->setOverrideCursor (Qt::WaitCursor);
 
-  // To prevent having an underdetermined system with an infinite number of solutions (which will result
-  // in divide by zero when computing an inverse) we reduce the order here if necessary.
-  // In other words, we limit the order to -1 for no points, 0 for one point, 1 for two points, and so on
-  int orderReduced = qMin ((int) order,
-                           pointsConvenient.size() - 1);
-
-  calculateCurveFit (orderReduced,
-                     pointsConvenient,
+  calculateCurveFit (orderReduced (order,
+                                   pointsConvenient),
+                     leastSquares,
                      coefficients);
   calculateStatistics (pointsConvenient,
                        coefficients,
@@ -137,38 +146,24 @@ void FittingStatistics::calculateStatistics (const FittingPointsConvenient &poin
   }
 }
 
-void FittingStatistics::loadXAndYArrays (int orderReduced,
-                                         const FittingPointsConvenient &pointsConvenient,
-                                         Matrix &X,
-                                         QVector<double> &Y) const
+int FittingStatistics::orderReduced (unsigned int order,
+                                     const FittingPointsConvenient &pointsConvenient) const
 {
-  ENGAUGE_ASSERT (Y.size () == X.rows ());
-
-  // Construct the matrices
-  int row;
-  FittingPointsConvenient::const_iterator itr;
-  for (row = 0, itr = pointsConvenient.begin(); itr != pointsConvenient.end(); itr++, row++) {
-
-    const QPointF &p = *itr;
-    double x = p.x ();
-    double y = p.y ();
-
-    for (int order = 0; order <= orderReduced; order++) {
-
-      X.set (row, order, qPow (x, order));
-    }
-
-    Y [row] = y;
-  }
+  // To prevent having an underdetermined system with an infinite number of solutions (which will result
+  // in divide by zero when computing an inverse) we reduce the order here if necessary.
+  // In other words, we limit the order to -1 for no points, 0 for one point, 1 for two points, and so on
+  return qMin ((int) order,
+               pointsConvenient.size() - 1);
 }
 
 double FittingStatistics::yFromXAndCoefficients (const FittingCurveCoefficients &coefficients,
                                                  double x) const
 {
+  // Horner's method
   double sum = 0;
 
-  for (int order = 0; order <= MAX_POLYNOMIAL_ORDER; order++) {
-    sum += coefficients [order] * qPow (x, (double) order);
+  for (int order = MAX_POLYNOMIAL_ORDER; order >= 0; order--) {
+    sum = sum * x + coefficients [order];
   }
 
   return sum;
@@ -13,7 +13,7 @@
 
 const int MAX_POLYNOMIAL_ORDER = 9; // Check execution time if this is increased from, say, 6 or 7
 
-class Matrix;
+class FittingLeastSquares;
 
 /// This class does the math to compute statistics for FittingWindow
 class FittingStatistics
@@ -23,6 +23,13 @@ public:
   FittingStatistics ();
   virtual ~FittingStatistics ();
 
+  /// Compute the curve fit coefficients from a least squares engine, without statistics. Coefficients above
+  /// orderReduced are set to zero, and all coefficients are zero if orderReduced is negative. Unlike
+  /// calculateCurveFitAndStatistics this does not touch the GUI, so it can be called from worker threads
+  void calculateCurveFit (int orderReduced,
+                          FittingLeastSquares &leastSquares,
+                          FittingCurveCoefficients &coefficients);
+
   /// Compute the curve fit and the statistics for that curve fit
   /// \param order Requested order of the polynomial to be fitted. This will be reduced if there are not
   ///              enough points just enough to prevent having an undetermined system (=more degrees of freedom
@@ -38,21 +45,29 @@ public:
                                        double &mse,
                                        double &rms,
                                        double &rSquared);
-  
-private:
-  
-  void calculateCurveFit (int orderReduced,
-                          const FittingPointsConvenient &pointsConvenient,
-                          FittingCurveCoefficients &coefficients);
+
+  /// Same as the other calculateCurveFitAndStatistics, except the fit comes from a least squares engine that already
+  /// holds exactly the points in pointsConvenient, so one engine can be shared by several orders. The order of the
+  /// engine must be at least the reduced order
+  void calculateCurveFitAndStatistics (unsigned int order,
+                                       const FittingPointsConvenient &pointsConvenient,
+                                       FittingLeastSquares &leastSquares,
+                                       FittingCurveCoefficients &coefficients,
+                                       double &mse,
+                                       double &rms,
+                                       double &rSquared);
+
+  /// Compute the statistics of a curve fit. Like calculateCurveFit, this can be called from worker threads
   void calculateStatistics (const FittingPointsConvenient &pointsConvenient,
                             const FittingCurveCoefficients &coefficients,
                             double &mse,
                             double &rms,
                             double &rSquared);
-  void loadXAndYArrays (int orderReduced,
-                        const FittingPointsConvenient &pointsConvenient,
-                        Matrix &X,
-                        QVector<double> &Y) const;
+  
+private:
+  
+  int orderReduced (unsigned int order,
+                    const FittingPointsConvenient &pointsConvenient) const;
   double yFromXAndCoefficients (const FittingCurveCoefficients &coefficients,
                                 double x) const;
 };
@@ -11,8 +11,10 @@
 #include "EngaugeAssert.h"
 #include "FittingCurveCoefficients.h"
 #include "FittingModel.h"
+#include "FittingOrderSelectionThread.h"
 #include "FittingStatistics.h"
 #include "FittingWindow.h"
+#include "FormatDouble.h"
 #include "GeometryModel.h"
 #include "Logger.h"
 #include "MainWindow.h"
@@ -24,6 +26,7 @@
 #include <QItemSelectionModel>
 #include <QLabel>
 #include <QLineEdit>
+#include <QLocale>
 #include <qmath.h>
 #include "Transformation.h"
 #include "WindowTable.h"
@@ -31,10 +34,16 @@
 const int COLUMN_COEFFICIENTS = 0;
 const int COLUMN_POLYNOMIAL_TERMS = 1;
 
+const int ORDER_AUTOMATIC = -1; // Combobox data of the automatic order entry
+
 FittingWindow::FittingWindow (MainWindow *mainWindow) :
   WindowAbstractBase (mainWindow),
   m_isLogXTheta (false),
-  m_isLogYRadius (false)
+  m_isLogYRadius (false),
+  m_incrementalIsCurrent (false),
+  m_hasPointIdentifiersChanged (false),
+  m_orderSelectionThread (0),
+  m_orderSelectionRequestId (0)
 {
   setVisible (false);
   setAllowedAreas (Qt::AllDockWidgetAreas);
@@ -48,6 +57,10 @@ FittingWindow::FittingWindow (MainWindow *mainWindow) :
 
   m_coefficients.resize (MAX_POLYNOMIAL_ORDER + 1);
 
+  m_orderSelectionThread = new FittingOrderSelectionThread;
+  connect (m_orderSelectionThread, SIGNAL (signalOrderSelection (int, FittingOrderSelection)),
+           this, SLOT (slotOrderSelection (int, FittingOrderSelection)));
+
   createWidgets (mainWindow);
   initializeOrder ();
   clear ();
@@ -55,6 +68,9 @@ FittingWindow::FittingWindow (MainWindow *mainWindow) :
 
 FittingWindow::~FittingWindow()
 {
+  // Evaluation in progress uses copies of the points, so it only has to finish
+  m_orderSelectionThread->wait ();
+  delete m_orderSelectionThread;
 }
 
 void FittingWindow::calculateCurveFitAndStatistics ()
@@ -64,37 +80,15 @@ void FittingWindow::calculateCurveFitAndStatistics ()
   double mse = 0, rms = 0, rSquared = 0;
   fittingStatistics.calculateCurveFitAndStatistics (maxOrder (),
                                                     m_pointsConvenient,
+                                                    m_incremental.leastSquares (),
                                                     m_coefficients,
                                                     mse,
                                                     rms,
                                                     rSquared);
 
-  m_lblMeanSquareError->setText (QString::number (mse));
-  m_lblRootMeanSquare->setText (QString::number (rms));
-  m_lblRSquared->setText (QString::number (rSquared));
-
-  // Send coefficients to connected classes. Also send the first and last x values
-  if (m_pointsConvenient.size () > 0) {
-    int last = m_pointsConvenient.size () - 1;
-    emit signalCurveFit (m_coefficients,
-                         m_pointsConvenient [0].x(),
-                         m_pointsConvenient [last].x (),
-                         m_isLogXTheta,
-                         m_isLogYRadius);
-  } else {
-    emit signalCurveFit (m_coefficients,
-                         0,
-                         0,
-                         false,
-                         false);
-  }
-
-  // Copy into displayed control
-  for (int row = 0, order = m_model->rowCount () - 1; row < m_model->rowCount (); row++, order--) {
-
-    QStandardItem *item = new QStandardItem (QString::number (m_coefficients [order]));
-    m_model->setItem (row, COLUMN_COEFFICIENTS, item);
-  }
+  displayCurveFitAndStatistics (mse,
+                                rms,
+                                rSquared);
 }
 
 void FittingWindow::clear ()
@@ -104,6 +98,15 @@ void FittingWindow::clear ()
   m_lblMeanSquareError->setText ("");
   m_lblRootMeanSquare->setText ("");
   m_lblRSquared->setText ("");
+  m_lblCriterion->setText ("");
+
+  m_incremental.clear ();
+  m_incrementalIsCurrent = false;
+  m_hasPointIdentifiersChanged = false;
+  m_pointIdentifiersChanged.clear ();
+
+  // Any evaluation still in progress is for points that are gone
+  ++m_orderSelectionRequestId;
 }
 
 void FittingWindow::closeEvent(QCloseEvent * /* event */)
@@ -130,6 +133,10 @@ void FittingWindow::createWidgets (MainWindow *mainWindow)
   for (int order = 0; order <= MAX_POLYNOMIAL_ORDER; order++) {
     m_cmbOrder->addItem (QString::number (order), QVariant (order));
   }
+  m_cmbOrder->addItem (tr ("Auto"), QVariant (ORDER_AUTOMATIC));
+  m_cmbOrder->setWhatsThis (tr ("Order of the fitted polynomial.\n\n"
+                                "With Auto, every order is evaluated and the order with the lowest information criterion "
+                                "is shown. The statistics of each order then appear as tooltips of the other entries"));
   connect (m_cmbOrder, SIGNAL (currentIndexChanged (int)), this, SLOT (slotCmbOrder (int)));
   layout->addWidget (m_cmbOrder, row++, 1, 1, 1);
 
@@ -171,6 +178,49 @@ void FittingWindow::createWidgets (MainWindow *mainWindow)
   m_lblRSquared->setReadOnly (true);
   m_lblRSquared->setWhatsThis (tr ("Calculated R squared statistic"));
   layout->addWidget (m_lblRSquared, row++, 1, 1, 1);
+
+  QLabel *lblCriterion = new QLabel (tr ("Information criterion:"));
+  layout->addWidget (lblCriterion, row, 0, 1, 1);
+
+  m_lblCriterion = new QLineEdit;
+  m_lblCriterion->setReadOnly (true);
+  m_lblCriterion->setWhatsThis (tr ("Corrected Akaike information criterion of the order selected by Auto. Lower values "
+                                    "indicate a better balance between the mean square error and the number of coefficients"));
+  layout->addWidget (m_lblCriterion, row++, 1, 1, 1);
+}
+
+void FittingWindow::displayCurveFitAndStatistics (double mse,
+                                                  double rms,
+                                                  double rSquared)
+{
+  m_lblMeanSquareError->setText (QString::number (mse));
+  m_lblRootMeanSquare->setText (QString::number (rms));
+  m_lblRSquared->setText (QString::number (rSquared));
+
+  // Send coefficients to connected classes. Also send the first and last x values
+  if (m_pointsConvenient.size () > 0) {
+    int last = m_pointsConvenient.size () - 1;
+    emit signalCurveFit (m_coefficients,
+                         m_pointsConvenient [0].x(),
+                         m_pointsConvenient [last].x (),
+                         m_isLogXTheta,
+                         m_isLogYRadius);
+  } else {
+    emit signalCurveFit (m_coefficients,
+                         0,
+                         0,
+                         false,
+                         false);
+  }
+
+  // Copy into displayed control, with the same text as QString::number which uses the C locale and six significant digits
+  const int PRECISION = 6;
+  FormatDouble format (QLocale::c ());
+  for (int row = 0, order = m_model->rowCount () - 1; row < m_model->rowCount (); row++, order--) {
+
+    QStandardItem *item = new QStandardItem (format.formatGeneral (m_coefficients [order], PRECISION));
+    m_model->setItem (row, COLUMN_COEFFICIENTS, item);
+  }
 }
 
 void FittingWindow::doCopy ()
@@ -195,6 +245,11 @@ void FittingWindow::initializeOrder ()
   m_cmbOrder->setCurrentIndex (index);
 }
 
+bool FittingWindow::isOrderAutomatic () const
+{
+  return m_cmbOrder->currentData().toInt() == ORDER_AUTOMATIC;
+}
+
 int FittingWindow::maxOrder () const
 {
   return m_cmbOrder->currentData().toInt();
@@ -202,12 +257,34 @@ int FittingWindow::maxOrder () const
 
 void FittingWindow::refreshTable ()
 {
-  int order = m_cmbOrder->currentData().toInt();
+  if (isOrderAutomatic ()) {
+
+    // Current fit stays on display until the evaluation of all orders arrives in slotOrderSelection
+    m_orderSelectionThread->request (++m_orderSelectionRequestId,
+                                     MAX_POLYNOMIAL_ORDER,
+                                     m_pointsConvenient,
+                                     m_incremental.leastSquares ());
 
-  // Table size may have to change
-  resizeTable (order);
+  } else {
+
+    // Results of the automatic mode no longer apply
+    ++m_orderSelectionRequestId;
+    for (int index = 0; index < m_cmbOrder->count (); index++) {
+      m_cmbOrder->setItemData (index,
+                               QVariant (),
+                               Qt::ToolTipRole);
+    }
+    m_cmbOrder->setItemText (m_cmbOrder->findData (QVariant (ORDER_AUTOMATIC)),
+                             tr ("Auto"));
+    m_lblCriterion->setText ("");
+
+    int order = maxOrder ();
 
-  calculateCurveFitAndStatistics ();
+    // Table size may have to change
+    resizeTable (order);
+
+    calculateCurveFitAndStatistics ();
+  }
 }
 
 void FittingWindow::resizeTable (int order)
@@ -245,11 +322,73 @@ void FittingWindow::resizeTable (int order)
   }
 }
 
+void FittingWindow::setPointIdentifiersChanged (const QStringList &pointIdentifiersChanged)
+{
+  m_hasPointIdentifiersChanged = true;
+  m_pointIdentifiersChanged = pointIdentifiersChanged.toSet ();
+}
+
 void FittingWindow::slotCmbOrder(int /* index  */)
 {
   refreshTable ();
 }
 
+void FittingWindow::slotOrderSelection (int requestId,
+                                        FittingOrderSelection orderSelection)
+{
+  if (requestId != m_orderSelectionRequestId) {
+    return; // Points or mode changed after this request
+  }
+
+  int orderBest = orderSelection.orderBest ();
+
+  LOG4CPP_INFO_S ((*mainCat)) << "FittingWindow::slotOrderSelection"
+                              << " order=" << orderBest;
+
+  // Report every evaluated order in the tooltip of its entry
+  for (int order = 0; order <= MAX_POLYNOMIAL_ORDER; order++) {
+
+    QVariant toolTip;
+    if (order <= orderSelection.orderMax ()) {
+      toolTip = tr ("Mean square error: %1\nRoot mean square: %2\nR squared: %3\nInformation criterion: %4")
+                .arg (orderSelection.mse (order))
+                .arg (orderSelection.rms (order))
+                .arg (orderSelection.rSquared (order))
+                .arg (orderSelection.criterion (order));
+    }
+    m_cmbOrder->setItemData (m_cmbOrder->findData (QVariant (order)),
+                             toolTip,
+                             Qt::ToolTipRole);
+  }
+
+  m_cmbOrder->setItemText (m_cmbOrder->findData (QVariant (ORDER_AUTOMATIC)),
+                           (orderBest < 0 ?
+                              tr ("Auto") :
+                              tr ("Auto (%1)").arg (orderBest)));
+
+  // Table has one row when there are no points, as in calculateCurveFitAndStatistics
+  resizeTable (qMax (0, orderBest));
+
+  double mse = 0, rms = 0, rSquared = 0;
+  if (orderBest < 0) {
+
+    m_coefficients.fill (0);
+    m_lblCriterion->setText ("");
+
+  } else {
+
+    m_coefficients = orderSelection.coefficients (orderBest);
+    mse = orderSelection.mse (orderBest);
+    rms = orderSelection.rms (orderBest);
+    rSquared = orderSelection.rSquared (orderBest);
+    m_lblCriterion->setText (QString::number (orderSelection.criterion (orderBest)));
+  }
+
+  displayCurveFitAndStatistics (mse,
+                                rms,
+                                rSquared);
+}
+
 void FittingWindow::update (const CmdMediator &cmdMediator,
                             const MainWindowModel &modelMainWindow,
                             const QString &curveSelected,
@@ -257,15 +396,32 @@ void FittingWindow::update (const CmdMediator &cmdMediator,
 {
   LOG4CPP_INFO_S ((*mainCat)) << "FittingWindow::update";
 
+  bool isLogXTheta = (cmdMediator.document().modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogYRadius = (cmdMediator.document().modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+
+  // Only the points changed by the command have to be applied to the fit, if the fit is of the same curve with the
+  // same conversion to graph coordinates. Changed points are taken now so they cannot leak into a later update
+  bool isIncremental = m_hasPointIdentifiersChanged &&
+                       m_incrementalIsCurrent &&
+                       curveSelected == m_curveSelected &&
+                       isLogXTheta == m_isLogXTheta &&
+                       isLogYRadius == m_isLogYRadius &&
+                       !(m_transformation != transformation);
+  QSet<QString> pointIdentifiersChanged = m_pointIdentifiersChanged;
+  m_hasPointIdentifiersChanged = false;
+  m_pointIdentifiersChanged.clear ();
+
   // Save inputs
   m_curveSelected = curveSelected;
   m_modelExport = cmdMediator.document().modelExport();
   m_model->setDelimiter (m_modelExport.delimiter());
-  m_isLogXTheta = (cmdMediator.document().modelCoords().coordScaleXTheta() == COORD_SCALE_LOG);
-  m_isLogYRadius = (cmdMediator.document().modelCoords().coordScaleYRadius() == COORD_SCALE_LOG);
+  m_isLogXTheta = isLogXTheta;
+  m_isLogYRadius = isLogYRadius;
   m_view->setDragEnabled (modelMainWindow.dragDropExport());
+  m_transformation = transformation;
 
   m_pointsConvenient.clear ();
+  m_incrementalIsCurrent = false;
 
   if (transformation.transformIsDefined()) {
 
@@ -274,32 +430,62 @@ void FittingWindow::update (const CmdMediator &cmdMediator,
 
     ENGAUGE_CHECK_PTR (curve);
 
-    if (curve->numPoints() > 0) {
-
-      // Copy points to convenient list
-      const Points points = curve->points();
-      Points::const_iterator itr;
-      for (itr = points.begin (); itr != points.end (); itr++) {
-
-        const Point &point = *itr;
-        QPointF posScreen = point.posScreen ();
-        QPointF posGraph;
-        transformation.transformScreenToRawGraph (posScreen,
-                                                  posGraph);
-
-        // Adjust for log coordinates
-        if (m_isLogXTheta) {
-          double x = qLn (posGraph.x()) / qLn (10.0); // Use base 10 consistent with text in resizeTable
-          posGraph.setX (x);
-        }
-        if (m_isLogYRadius) {
-          double y = qLn (posGraph.y()) / qLn (10.0); // Use base 10 consistent with text in resizeTable
-          posGraph.setY (y);
-        }
-
-        m_pointsConvenient.append (posGraph);
+    // Starting over is cheaper when most of the points changed
+    if (2 * pointIdentifiersChanged.count () > curve->numPoints ()) {
+      isIncremental = false;
+    }
+
+    // Copy points to convenient list
+    QStringList identifiers;
+    const Points points = curve->points();
+    Points::const_iterator itr;
+    for (itr = points.begin (); itr != points.end (); itr++) {
+
+      const Point &point = *itr;
+      QPointF posScreen = point.posScreen ();
+      QPointF posGraph;
+      transformation.transformScreenToRawGraph (posScreen,
+                                                posGraph);
+
+      // Adjust for log coordinates
+      if (m_isLogXTheta) {
+        double x = qLn (posGraph.x()) / qLn (10.0); // Use base 10 consistent with text in resizeTable
+        posGraph.setX (x);
+      }
+      if (m_isLogYRadius) {
+        double y = qLn (posGraph.y()) / qLn (10.0); // Use base 10 consistent with text in resizeTable
+        posGraph.setY (y);
+      }
+
+      m_pointsConvenient.append (posGraph);
+
+      if (!isIncremental) {
+        identifiers << point.identifier ();
+      } else if (pointIdentifiersChanged.remove (point.identifier ())) {
+        m_incremental.setPoint (point.identifier (),
+                                posGraph);
       }
     }
+
+    if (isIncremental) {
+
+      // Changed points that are no longer in the curve were removed. Points of other curves are ignored
+      QSet<QString>::const_iterator itrRemoved;
+      for (itrRemoved = pointIdentifiersChanged.begin (); itrRemoved != pointIdentifiersChanged.end (); itrRemoved++) {
+        m_incremental.removePoint (*itrRemoved);
+      }
+
+    } else {
+
+      m_incremental.rebuild (identifiers,
+                             m_pointsConvenient);
+    }
+
+    m_incrementalIsCurrent = true;
+
+  } else {
+
+    m_incremental.clear ();
   }
 
   refreshTable ();
@@ -9,23 +9,27 @@
 
 #include "DocumentModelExportFormat.h"
 #include "FittingCurveCoefficients.h"
+#include "FittingIncremental.h"
+#include "FittingOrderSelection.h"
 #include "FittingPointsConvenient.h"
+#include <QSet>
+#include <QStringList>
 #include <QVector>
+#include "Transformation.h"
 #include "WindowAbstractBase.h"
 
 class CmdMediator;
 class Curve;
 class FittingModel;
+class FittingOrderSelectionThread;
 class MainWindow;
 class MainWindowModel;
-class Matrix;
 class QComboBox;
 class QItemSelection;
 class QLabel;
 class QLineEdit;
 class QString;
 class QTableView;
-class Transformation;
 
 /// Window that displays curve fitting as applied to the currently selected curve
 ///
@@ -43,6 +47,11 @@ public:
   virtual void clear ();
   virtual void closeEvent(QCloseEvent *event);
   virtual void doCopy ();
+
+  /// Limit the next update to the specified points, which are the only points that the current command added, removed
+  /// or moved. The fit is then updated from just those points, rather than refitted from all points of the curve
+  void setPointIdentifiersChanged (const QStringList &pointIdentifiersChanged);
+
   virtual void update (const CmdMediator &cmdMediator,
                        const MainWindowModel &modelMainWindow,
                        const QString &curveSelected,
@@ -54,6 +63,10 @@ private slots:
   /// Update after change in the selected curve fit order
   void slotCmbOrder(int index);
 
+  /// Show the fit of the best order after all orders were evaluated in the automatic order mode
+  void slotOrderSelection (int requestId,
+                           FittingOrderSelection orderSelection);
+
 signals:
 
   /// Signal containing coefficients from curve fit
@@ -67,7 +80,11 @@ private:
 
   void calculateCurveFitAndStatistics ();
   void createWidgets(MainWindow *mainWindow);
+  void displayCurveFitAndStatistics (double mse,
+                                     double rms,
+                                     double rSquared);
   void initializeOrder ();
+  bool isOrderAutomatic () const;
   int maxOrder () const;
   void refreshTable ();
   void resizeTable (int order);
@@ -79,12 +96,29 @@ private:
   QLineEdit *m_lblMeanSquareError;
   QLineEdit *m_lblRootMeanSquare;
   QLineEdit *m_lblRSquared;
+  QLineEdit *m_lblCriterion;
 
   QString m_curveSelected; // Save selected curve name so it can be displayed. Let user know what data this fit applies to
   bool m_isLogXTheta;
   bool m_isLogYRadius;
   FittingPointsConvenient m_pointsConvenient;
 
+  // Least squares engine holding m_pointsConvenient, shared by every order. It is kept between updates so a command
+  // that changes only a few points costs only those points, which is possible while the curve and the conversion to
+  // graph coordinates are the same as in the previous update
+  FittingIncremental m_incremental;
+  bool m_incrementalIsCurrent;
+  Transformation m_transformation;
+
+  // Points changed by the current command, from setPointIdentifiersChanged. Without these the next update refits
+  // all points
+  bool m_hasPointIdentifiersChanged;
+  QSet<QString> m_pointIdentifiersChanged;
+
+  // Evaluation of all orders in the automatic order mode. Results of any request but the latest are stale and ignored
+  FittingOrderSelectionThread *m_orderSelectionThread;
+  int m_orderSelectionRequestId;
+
   // Calculated curve fit coefficients, with 0th for constant term, 1st for linear term, ...
   QVector<double> m_coefficients;
 
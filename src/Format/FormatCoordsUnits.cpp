@@ -16,7 +16,8 @@
 const bool IS_X_THETA = true;
 const bool IS_NOT_X_THETA = false;
 
-FormatCoordsUnits::FormatCoordsUnits()
+FormatCoordsUnits::FormatCoordsUnits() :
+  m_formatDouble (QLocale::c ())
 {
   LOG4CPP_DEBUG_S ((*mainCat)) << "FormatCoordsUnits::FormatCoordsUnits";
 }
@@ -71,13 +72,18 @@ void FormatCoordsUnits::unformattedToFormatted (double xThetaUnformatted,
 {
   LOG4CPP_DEBUG_S ((*mainCat)) << "FormatCoordsUnits::unformattedToFormatted";
 
+  // Number formatter is reused across calls, and only rebuilt when the locale changes
+  if (m_formatDouble.locale () != mainWindowModel.locale ()) {
+    m_formatDouble = FormatDouble (mainWindowModel.locale ());
+  }
+
   FormatCoordsUnitsStrategyNonPolarTheta formatNonPolarTheta;
   FormatCoordsUnitsStrategyPolarTheta formatPolarTheta;
 
   if (modelCoords.coordsType() == COORDS_TYPE_CARTESIAN) {
 
     xThetaFormatted = formatNonPolarTheta.unformattedToFormatted (xThetaUnformatted,
-                                                                  mainWindowModel.locale(),
+                                                                  m_formatDouble,
                                                                   modelCoords.coordUnitsX(),
                                                                   modelCoords.coordUnitsDate(),
                                                                   modelCoords.coordUnitsTime(),
@@ -86,7 +92,7 @@ void FormatCoordsUnits::unformattedToFormatted (double xThetaUnformatted,
                                                                   transformation,
                                                                   yRadiusUnformatted);
     yRadiusFormatted = formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
-                                                                   mainWindowModel.locale(),
+                                                                   m_formatDouble,
                                                                    modelCoords.coordUnitsY(),
                                                                    modelCoords.coordUnitsDate(),
                                                                    modelCoords.coordUnitsTime(),
@@ -98,13 +104,13 @@ void FormatCoordsUnits::unformattedToFormatted (double xThetaUnformatted,
   } else {
     
     xThetaFormatted = formatPolarTheta.unformattedToFormatted (xThetaUnformatted,
-                                                               mainWindowModel.locale(),
+                                                               m_formatDouble,
                                                                modelCoords.coordUnitsTheta(),
                                                                modelGeneral,
                                                                transformation,
                                                                yRadiusUnformatted);
     yRadiusFormatted = formatNonPolarTheta.unformattedToFormatted (yRadiusUnformatted,
-                                                                   mainWindowModel.locale(),
+                                                                   m_formatDouble,
                                                                    modelCoords.coordUnitsRadius(),
                                                                    modelCoords.coordUnitsDate(),
                                                                    modelCoords.coordUnitsTime(),
@@ -7,6 +7,8 @@
 #ifndef FORMAT_COORDS_UNITS_H
 #define FORMAT_COORDS_UNITS_H
 
+#include "FormatDouble.h"
+
 class DocumentModelCoords;
 class DocumentModelGeneral;
 class MainWindowModel;
@@ -36,6 +38,11 @@ class FormatCoordsUnits {
                                QString &xThetaFormatted,
                                QString &yRadiusFormatted,
                                const Transformation &transformation) const;
+
+ private:
+
+  // Number formatter for the most recent locale, reused since creating one for every value is slow
+  mutable FormatDouble m_formatDouble;
 };
 
 #endif // FORMAT_COORDS_UNITS_H
@@ -9,6 +9,7 @@
 #include "FormatCoordsUnitsStrategyNonPolarTheta.h"
 #include "FormatDateTime.h"
 #include "FormatDegreesMinutesSecondsNonPolarTheta.h"
+#include "FormatDouble.h"
 #include "Logger.h"
 #include <QLocale>
 #include "Transformation.h"
@@ -61,7 +62,7 @@ double FormatCoordsUnitsStrategyNonPolarTheta::formattedToUnformatted (const QSt
 }
 
 QString FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted (double valueUnformatted,
-                                                                        const QLocale &locale,
+                                                                        const FormatDouble &formatDouble,
                                                                         CoordUnitsNonPolarTheta coordUnits,
                                                                         CoordUnitsDate coordUnitsDate,
                                                                         CoordUnitsTime coordUnitsTime,
@@ -72,8 +73,6 @@ QString FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted (double v
 {
   LOG4CPP_DEBUG_S ((*mainCat)) << "FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted";
 
-  const char FORMAT ('g');
-
   QString valueFormatted;
 
   switch (coordUnits) {
@@ -97,13 +96,12 @@ QString FormatCoordsUnitsStrategyNonPolarTheta::unformattedToFormatted (double v
       break;
 
     case COORD_UNITS_NON_POLAR_THETA_NUMBER:
-      valueFormatted = locale.toString (valueUnformatted,
-                                        FORMAT,
-                                        precisionDigitsForRawNumber (valueUnformatted,
-                                                                     valueUnformattedOther,
-                                                                     isXTheta,
-                                                                     modelGeneral,
-                                                                     transformation));
+      valueFormatted = formatDouble.formatGeneral (valueUnformatted,
+                                                   precisionDigitsForRawNumber (valueUnformatted,
+                                                                                valueUnformattedOther,
+                                                                                isXTheta,
+                                                                                modelGeneral,
+                                                                                transformation));
       break;
 
     default:
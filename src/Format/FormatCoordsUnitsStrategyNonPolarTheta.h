@@ -14,6 +14,7 @@
 #include <QString>
 
 class DocumentModelGeneral;
+class FormatDouble;
 class QLocale;
 class Transformation;
 
@@ -33,7 +34,7 @@ class FormatCoordsUnitsStrategyNonPolarTheta : public FormatCoordsUnitsStrategyA
 
   /// Convert simple unformatted number to formatted string
   QString unformattedToFormatted (double valueUnformatted,
-                                  const QLocale &locale,
+                                  const FormatDouble &formatDouble,
                                   CoordUnitsNonPolarTheta coordUnits,
                                   CoordUnitsDate coordUnitsDate,
                                   CoordUnitsTime coordUnitsTime,
@@ -8,6 +8,7 @@
 #include "EngaugeAssert.h"
 #include "FormatCoordsUnitsStrategyPolarTheta.h"
 #include "FormatDegreesMinutesSecondsPolarTheta.h"
+#include "FormatDouble.h"
 #include "Logger.h"
 #include <QLocale>
 
@@ -51,7 +52,7 @@ double FormatCoordsUnitsStrategyPolarTheta::formattedToUnformatted (const QStrin
 }
 
 QString FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted (double valueUnformatted,
-                                                                     const QLocale &locale,
+                                                                     const FormatDouble &formatDouble,
                                                                      CoordUnitsPolarTheta coordUnits,
                                                                      const DocumentModelGeneral &modelGeneral,
                                                                      const Transformation &transformation,
@@ -59,7 +60,6 @@ QString FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted (double valu
 {
   LOG4CPP_DEBUG_S ((*mainCat)) << "FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted";
 
-  const char FORMAT ('g');
   const bool IS_X_THETA = true;
 
   QString valueFormatted;
@@ -80,13 +80,12 @@ QString FormatCoordsUnitsStrategyPolarTheta::unformattedToFormatted (double valu
     case COORD_UNITS_POLAR_THETA_GRADIANS:
     case COORD_UNITS_POLAR_THETA_RADIANS:
     case COORD_UNITS_POLAR_THETA_TURNS:
-      valueFormatted = locale.toString (valueUnformatted,
-                                        FORMAT,
-                                        precisionDigitsForRawNumber (valueUnformatted,
-                                                                     valueUnformattedOther,
-                                                                     IS_X_THETA,
-                                                                     modelGeneral,
-                                                                     transformation));
+      valueFormatted = formatDouble.formatGeneral (valueUnformatted,
+                                                   precisionDigitsForRawNumber (valueUnformatted,
+                                                                                valueUnformattedOther,
+                                                                                IS_X_THETA,
+                                                                                modelGeneral,
+                                                                                transformation));
       break;
 
     default:
@@ -12,6 +12,7 @@
 #include "FormatCoordsUnitsStrategyAbstractBase.h"
 #include <QString>
 
+class FormatDouble;
 class QLocale;
 class Transformation;
 
@@ -28,7 +29,7 @@ class FormatCoordsUnitsStrategyPolarTheta : public FormatCoordsUnitsStrategyAbst
 
   /// Convert simple unformatted number to formatted string
   QString unformattedToFormatted (double valueUnformatted,
-                                  const QLocale &locale,
+                                  const FormatDouble &formatDouble,
                                   CoordUnitsPolarTheta coordUnits,
                                   const DocumentModelGeneral &modelGeneral,
                                   const Transformation &transformation,
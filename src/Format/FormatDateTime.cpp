@@ -6,18 +6,27 @@
 
 #include "EngaugeAssert.h"
 #include "FormatDateTime.h"
+#include "FormatDateTimeCompiled.h"
 #include "Logger.h"
 #include <QDateTime>
+#include <QMutexLocker>
+#include <QSharedPointer>
 #include <QTimeZone>
 
 // Need a reference time zone so exported outputs do not exhibit unpredictable local/UTC hours differences
 const Qt::TimeSpec REFERENCE_TIME_ZONE (Qt::UTC);
 
+QMutex FormatDateTime::m_mutexParse;
+FormatsDate FormatDateTime::m_formatsDateParseAcceptable;
+FormatsTime FormatDateTime::m_formatsTimeParseAcceptable;
+FormatsDate FormatDateTime::m_formatsDateParseIncomplete;
+FormatsTime FormatDateTime::m_formatsTimeParseIncomplete;
+QHash<int, QSharedPointer<FormatDateTimeCompiled> > FormatDateTime::m_compiled;
+
 FormatDateTime::FormatDateTime()
 {
+  // Parse formats are shared, and loaded by the first parse
   loadFormatsFormat();
-  loadFormatsParseAcceptable();
-  loadFormatsParseIncomplete();
 }
 
 bool FormatDateTime::ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
@@ -46,81 +55,33 @@ bool FormatDateTime::ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
   return ambiguous;
 }
 
-void FormatDateTime::dateTimeLookup (const FormatsDate &formatsDateAll,
-                                     const FormatsTime &formatsTimeAll,
-                                     CoordUnitsDate coordUnitsDate,
-                                     CoordUnitsTime coordUnitsTime,
-                                     const QString &string,
-                                     bool useQDateTimeElseQRegExp,
-                                     double &value,
-                                     bool &success) const
+const FormatDateTimeCompiled &FormatDateTime::compiled (CoordUnitsDate coordUnitsDate,
+                                                        CoordUnitsTime coordUnitsTime) const
 {
-  LOG4CPP_INFO_S ((*mainCat)) << "FormatDateTime::dateTimeLookup";
-
-  success = false;
-
-  ENGAUGE_ASSERT (formatsDateAll.contains (coordUnitsDate));
-  ENGAUGE_ASSERT (formatsTimeAll.contains (coordUnitsTime));
-
-  QStringList formatsDate = formatsDateAll [coordUnitsDate];
-  QStringList formatsTime = formatsTimeAll [coordUnitsTime];
-
-  // Loop through the legal date/time combinations
-  QStringList::const_iterator itrDate, itrTime;
-  bool iterating = true;
-  for (itrDate = formatsDate.begin(); itrDate != formatsDate.end() && iterating; itrDate++) {
-
-    QString formatDate = *itrDate;
-
-    for (itrTime = formatsTime.begin(); itrTime != formatsTime.end() && iterating; itrTime++) {
-
-      QString formatTime = *itrTime;
-
-      // Insert space as separator only if needed. Do not use trim around here since formatDate may or may not end in a space
-      QString separator = (!formatDate.isEmpty() && !formatTime.isEmpty() ? " " : "");
-
-      QString formatDateTime = formatDate + separator + formatTime;
-
-      if (!formatDateTime.isEmpty()) {
-
-        // Try parsing according to the current format
-        if (useQDateTimeElseQRegExp) {
-
-          QDateTime dt = QDateTime::fromString (string,
-                                                formatDateTime);
-
-          if (dt.isValid() && !ambiguityBetweenDateAndTime (coordUnitsDate,
-                                                            coordUnitsTime,
-                                                            string)) {
-
-            success = true;
-            value = dt.toTimeSpec (REFERENCE_TIME_ZONE).toTime_t ();
-            iterating = false; // Stop iterating
-
-            LOG4CPP_INFO_S ((*mainCat)) << "FormatDateTime::dateTimeLookup"
-                                        << " string=" << string.toLatin1().data()
-                                        << " qDateTimeFormatMatched=" << formatDateTime.toLatin1().data()
-                                        << " value=" << value
-                                        << " stringQDateTime=" << dt.toString().toLatin1().data();
+  QMutexLocker locker (&m_mutexParse);
 
-          }
-        } else {
+  if (m_formatsDateParseAcceptable.isEmpty ()) {
+    loadFormatsParseAcceptable();
+    loadFormatsParseIncomplete();
+  }
 
-          QRegExp reg (formatDateTime);
-          if (reg.exactMatch(string)) {
+  int key = coordUnitsDate * NUM_COORD_UNITS_TIME + coordUnitsTime;
+  if (!m_compiled.contains (key)) {
 
-            success = true; // Note that value does not get set in QRegExp case
-            iterating = false; // Stop iterating
+    LOG4CPP_INFO_S ((*mainCat)) << "FormatDateTime::compiled"
+                                << " date=" << coordUnitsDateToString (coordUnitsDate).toLatin1().data()
+                                << " time=" << coordUnitsTimeToString (coordUnitsTime).toLatin1().data();
 
-            LOG4CPP_INFO_S ((*mainCat)) << "FormatDateTime::dateTimeLookup"
-                                        << " string=" << string.toLatin1().data()
-                                        << " regExpMatched=" << formatDateTime.toLatin1().data();
+    ENGAUGE_ASSERT (m_formatsDateParseAcceptable.contains (coordUnitsDate));
+    ENGAUGE_ASSERT (m_formatsTimeParseAcceptable.contains (coordUnitsTime));
 
-          }
-        }
-      }
-    }
+    m_compiled [key] = QSharedPointer<FormatDateTimeCompiled> (new FormatDateTimeCompiled (m_formatsDateParseAcceptable [coordUnitsDate],
+                                                                                           m_formatsTimeParseAcceptable [coordUnitsTime],
+                                                                                           m_formatsDateParseIncomplete [coordUnitsDate],
+                                                                                           m_formatsTimeParseIncomplete [coordUnitsTime]));
   }
+
+  return *m_compiled [key];
 }
 
 QString FormatDateTime::formatOutput (CoordUnitsDate coordUnitsDate,
@@ -429,8 +390,6 @@ QValidator::State FormatDateTime::parseInput (CoordUnitsDate coordUnitsDate,
                               << " time=" << coordUnitsTimeToString (coordUnitsTime).toLatin1().data()
                               << " string=" << stringUntrimmed.toLatin1().data();
 
-  const bool USE_QREGEXP = true, DO_NOT_USE_QREGEXP = false;
-
   const QString string = stringUntrimmed.trimmed();
 
   QValidator::State state;
@@ -442,36 +401,34 @@ QValidator::State FormatDateTime::parseInput (CoordUnitsDate coordUnitsDate,
 
     state = QValidator::Invalid;
 
-    // First see if value is acceptable
+    const FormatDateTimeCompiled &formats = compiled (coordUnitsDate,
+                                                      coordUnitsTime);
+
+    // First see if value is acceptable. A single number is ambiguous between date and time, so it never is
     bool success = false;
-    dateTimeLookup (m_formatsDateParseAcceptable,
-                    m_formatsTimeParseAcceptable,
-                    coordUnitsDate,
-                    coordUnitsTime,
-                    string,
-                    USE_QREGEXP,
-                    value,
-                    success);
+    if (!ambiguityBetweenDateAndTime (coordUnitsDate,
+                                      coordUnitsTime,
+                                      string)) {
+
+      // Formats that could not be reduced to a skeleton are always tried, so no other formats need to be tried here
+      QDateTime dt;
+      if (formats.parseAcceptable (string,
+                                   dt)) {
+
+        success = true;
+        value = dt.toTimeSpec (REFERENCE_TIME_ZONE).toTime_t ();
+      }
+    }
+
     if (success) {
       
       state = QValidator::Acceptable;
       
-    } else {
-      
-      // Not acceptable, but perhaps it is just incomplete
-      dateTimeLookup (m_formatsDateParseIncomplete,
-                    m_formatsTimeParseIncomplete,
-                      coordUnitsDate,
-                      coordUnitsTime,
-                      string,
-                      DO_NOT_USE_QREGEXP,
-                      value,
-                      success);
-      if (success) {
-        
-        state = QValidator::Intermediate;
-        
-      }
+    } else if (formats.parseIncomplete (string)) {
+
+      // Not acceptable, but it is just incomplete
+      state = QValidator::Intermediate;
+
     }
   }
 
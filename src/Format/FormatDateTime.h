@@ -11,6 +11,8 @@
 #include "CoordUnitsTime.h"
 #include <QDateTime>
 #include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
 #include <QString>
 #include <QStringList>
 #include <QValidator>
@@ -21,6 +23,8 @@ typedef QHash<CoordUnitsTime, QString> FormatTime;
 typedef QHash<CoordUnitsDate, QStringList> FormatsDate;
 typedef QHash<CoordUnitsTime, QStringList> FormatsTime;
 
+class FormatDateTimeCompiled;
+
 /// Input parsing and output formatting for date/time values
 class FormatDateTime {
  public:
@@ -33,7 +37,8 @@ class FormatDateTime {
                         double value) const;
   
   /// Parse the input string into a time value. Success flag is false if parsing failed.
-  /// Leading/trailing spaces are trimmed (=ignored)
+  /// Leading/trailing spaces are trimmed (=ignored). The parse formats are compiled once and shared by all instances,
+  /// so parsing many strings in a row is fast even when each one uses a new instance
   QValidator::State parseInput (CoordUnitsDate coordUnitsDate,
                                 CoordUnitsTime coordUnitsTime,
                                 const QString &stringUntrimmed,
@@ -44,31 +49,31 @@ class FormatDateTime {
   bool ambiguityBetweenDateAndTime (CoordUnitsDate coordUnitsDate,
                                     CoordUnitsTime coordUnitsTime,
                                     const QString &string) const;
-  void dateTimeLookup (const FormatsDate &formatsDate,
-                       const FormatsTime &formatsTime,
-                       CoordUnitsDate coordUnitsDate,
-                       CoordUnitsTime coordUnitsTime,
-                       const QString &string,
-                       bool useQDateTimeElseQRegExp,
-                       double &value, // Set only if useQDateTimeElseQRegExp=success=true
-                       bool &success) const;
+  const FormatDateTimeCompiled &compiled (CoordUnitsDate coordUnitsDate,
+                                          CoordUnitsTime coordUnitsTime) const;
   void loadFormatsFormat();
-  void loadFormatsParseAcceptable();
-  void loadFormatsParseIncomplete();
+  static void loadFormatsParseAcceptable();
+  static void loadFormatsParseIncomplete();
 
   // For formatting output
   FormatDate m_formatsDateFormat;
   FormatTime m_formatsTimeFormat;
 
+  // Guards the shared parse formats below, which are loaded and compiled on first use and then never change
+  static QMutex m_mutexParse;
+
   // For parsing input, using built in Qt date/time parsing according to QDateTime
-  FormatsDate m_formatsDateParseAcceptable;
-  FormatsTime m_formatsTimeParseAcceptable;
+  static FormatsDate m_formatsDateParseAcceptable;
+  static FormatsTime m_formatsTimeParseAcceptable;
 
   // For parsing input, after input has been found to not be Acceptable. Regular expressions are used since Qt date/time
   // parsing of Intermediate strings does not work. Example, 'J' and 'Ja' would be rejected although they are typed
   // in the process of entering 'Jan' for the month
-  FormatsDate m_formatsDateParseIncomplete;
-  FormatsTime m_formatsTimeParseIncomplete;
+  static FormatsDate m_formatsDateParseIncomplete;
+  static FormatsTime m_formatsTimeParseIncomplete;
+
+  // Compiled parse formats, keyed by date and time units, which live as long as the application
+  static QHash<int, QSharedPointer<FormatDateTimeCompiled> > m_compiled;
 };
 
 #endif // FORMAT_DATE_TIME_H
@@ -0,0 +1,217 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "FormatDateTimeCompiled.h"
+
+const QChar SKELETON_NUMBER ('N');
+const QChar SKELETON_TEXT ('A');
+const QString SEPARATORS ("/-: ");
+
+FormatDateTimeCompiled::FormatDateTimeCompiled (const QStringList &formatsDateAcceptable,
+                                                const QStringList &formatsTimeAcceptable,
+                                                const QStringList &formatsDateIncomplete,
+                                                const QStringList &formatsTimeIncomplete) :
+  m_indexLastMatch (-1)
+{
+  m_formatsAcceptable = combine (formatsDateAcceptable,
+                                 formatsTimeAcceptable);
+
+  QStringList::const_iterator itr;
+  for (itr = m_formatsAcceptable.begin(); itr != m_formatsAcceptable.end(); itr++) {
+    m_skeletonsAcceptable << skeletonOfFormat (*itr);
+  }
+
+  QStringList formatsIncomplete = combine (formatsDateIncomplete,
+                                           formatsTimeIncomplete);
+  for (itr = formatsIncomplete.begin(); itr != formatsIncomplete.end(); itr++) {
+    m_regExpsIncomplete << QRegExp (*itr);
+  }
+}
+
+QStringList FormatDateTimeCompiled::combine (const QStringList &formatsDate,
+                                             const QStringList &formatsTime)
+{
+  QStringList formats;
+
+  QStringList::const_iterator itrDate, itrTime;
+  for (itrDate = formatsDate.begin(); itrDate != formatsDate.end(); itrDate++) {
+
+    const QString &formatDate = *itrDate;
+
+    for (itrTime = formatsTime.begin(); itrTime != formatsTime.end(); itrTime++) {
+
+      const QString &formatTime = *itrTime;
+
+      QString separator = (!formatDate.isEmpty() && !formatTime.isEmpty() ? " " : "");
+
+      QString formatDateTime = formatDate + separator + formatTime;
+      if (!formatDateTime.isEmpty()) {
+        formats << formatDateTime;
+      }
+    }
+  }
+
+  return formats;
+}
+
+bool FormatDateTimeCompiled::parseAcceptable (const QString &string,
+                                              QDateTime &dateTime) const
+{
+  QString skeleton = skeletonOfString (string);
+
+  // Most recent match first
+  int indexLastMatch = m_indexLastMatch.load ();
+  if (indexLastMatch >= 0 &&
+      tryAcceptable (indexLastMatch,
+                     string,
+                     skeleton,
+                     dateTime)) {
+    return true;
+  }
+
+  for (int index = 0; index < m_formatsAcceptable.count(); index++) {
+    if (index != indexLastMatch &&
+        tryAcceptable (index,
+                       string,
+                       skeleton,
+                       dateTime)) {
+
+      m_indexLastMatch.store (index);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool FormatDateTimeCompiled::parseIncomplete (const QString &string) const
+{
+  QList<QRegExp>::const_iterator itr;
+  for (itr = m_regExpsIncomplete.begin(); itr != m_regExpsIncomplete.end(); itr++) {
+
+    // Copy shares the compiled engine, and keeps the match state of the shared instance untouched
+    QRegExp reg (*itr);
+    if (reg.exactMatch (string)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+QString FormatDateTimeCompiled::skeletonOfFormat (const QString &format)
+{
+  QString skeleton;
+
+  int i = 0;
+  while (i < format.length ()) {
+
+    QChar ch = format [i];
+
+    // Length of run of identical characters
+    int count = 1;
+    while (i + count < format.length () && format [i + count] == ch) {
+      ++count;
+    }
+
+    QChar token;
+    if ((ch == 'd' && count <= 2) ||
+        (ch == 'M' && count <= 2) ||
+        (ch == 'y' && (count == 2 || count == 4)) ||
+        (ch == 'h' && count <= 2) ||
+        (ch == 'H' && count <= 2) ||
+        (ch == 'm' && count <= 2) ||
+        (ch == 's' && count <= 2) ||
+        (ch == 'z' && (count == 1 || count == 3))) {
+
+      token = SKELETON_NUMBER;
+
+    } else if ((ch == 'd' && count <= 4) ||
+               (ch == 'M' && count <= 4)) {
+
+      token = SKELETON_TEXT;
+
+    } else if ((ch == 'A' || ch == 'a') && count == 1) {
+
+      token = SKELETON_TEXT;
+
+      // AP and ap are also am/pm markers
+      if (i + 1 < format.length () && format [i + 1] == (ch == 'A' ? 'P' : 'p')) {
+        ++count;
+      }
+
+    } else if (ch == ' ') {
+
+      token = ch; // Runs of spaces are collapsed, as in skeletonOfString
+
+    } else if (SEPARATORS.contains (ch) && count == 1) {
+
+      token = ch;
+
+    } else {
+
+      // Quotes, other literals and unusual field widths are left to QDateTime
+      return QString ();
+    }
+
+    // Adjacent fields of the same kind cannot be separated in the string skeleton
+    if ((token == SKELETON_NUMBER || token == SKELETON_TEXT) &&
+        skeleton.endsWith (token)) {
+      return QString ();
+    }
+
+    skeleton += token;
+    i += count;
+  }
+
+  return skeleton;
+}
+
+QString FormatDateTimeCompiled::skeletonOfString (const QString &string)
+{
+  QString skeleton;
+
+  for (int i = 0; i < string.length (); i++) {
+
+    QChar ch = string [i];
+
+    QChar token;
+    if (ch.isDigit ()) {
+      token = SKELETON_NUMBER;
+    } else if (SEPARATORS.contains (ch)) {
+      token = ch;
+    } else {
+      token = SKELETON_TEXT; // Month names may include accents and abbreviation periods
+    }
+
+    // Runs become a single token. This includes runs of spaces, and runs of any separator which no format skeleton has
+    if (!skeleton.endsWith (token)) {
+      skeleton += token;
+    }
+  }
+
+  return skeleton;
+}
+
+bool FormatDateTimeCompiled::tryAcceptable (int index,
+                                            const QString &string,
+                                            const QString &skeleton,
+                                            QDateTime &dateTime) const
+{
+  const QString &skeletonFormat = m_skeletonsAcceptable.at (index);
+  if (!skeletonFormat.isEmpty () && skeletonFormat != skeleton) {
+    return false;
+  }
+
+  QDateTime dt = QDateTime::fromString (string,
+                                        m_formatsAcceptable.at (index));
+  if (dt.isValid ()) {
+    dateTime = dt;
+    return true;
+  }
+
+  return false;
+}
@@ -0,0 +1,70 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FORMAT_DATE_TIME_COMPILED_H
+#define FORMAT_DATE_TIME_COMPILED_H
+
+#include <QAtomicInt>
+#include <QDateTime>
+#include <QList>
+#include <QRegExp>
+#include <QString>
+#include <QStringList>
+
+/// Parse formats of FormatDateTime for one combination of date and time units, compiled once so large numbers of
+/// strings can be parsed quickly. Each combined QDateTime format is reduced to a skeleton in which every numeric field
+/// becomes 'N' and every text field becomes 'A', so a string is only handed to QDateTime::fromString for the formats
+/// whose skeleton equals the skeleton of the string. The format that matched most recently is tried first, since
+/// pasted and imported values almost always share one format. The incomplete formats are compiled into QRegExp
+/// instances up front.
+///
+/// After construction the only state that changes is the most recent match, which is atomic, so one instance can be
+/// shared by all threads
+class FormatDateTimeCompiled
+{
+public:
+  /// Single constructor. Each date format is combined with each time format, in order
+  FormatDateTimeCompiled (const QStringList &formatsDateAcceptable,
+                          const QStringList &formatsTimeAcceptable,
+                          const QStringList &formatsDateIncomplete,
+                          const QStringList &formatsTimeIncomplete);
+
+  /// Parse a trimmed string that may be a complete date/time. Returns false if no format with a matching skeleton
+  /// accepted the string
+  bool parseAcceptable (const QString &string,
+                        QDateTime &dateTime) const;
+
+  /// Return true if the trimmed string matches one of the incomplete formats
+  bool parseIncomplete (const QString &string) const;
+
+private:
+  FormatDateTimeCompiled ();
+
+  // Combine date and time formats, with a space separator only if both are nonempty. Empty combinations are dropped
+  static QStringList combine (const QStringList &formatsDate,
+                              const QStringList &formatsTime);
+
+  // Skeleton of a QDateTime format. Empty if the format cannot be reduced safely, in which case the format is always tried
+  static QString skeletonOfFormat (const QString &format);
+
+  // Skeleton of a string being parsed. Runs of digits become 'N' and runs of other non-separator characters become 'A'
+  static QString skeletonOfString (const QString &string);
+
+  // Try one acceptable format if its skeleton allows
+  bool tryAcceptable (int index,
+                      const QString &string,
+                      const QString &skeleton,
+                      QDateTime &dateTime) const;
+
+  QStringList m_formatsAcceptable;
+  QStringList m_skeletonsAcceptable;
+  QList<QRegExp> m_regExpsIncomplete;
+
+  // Index into m_formatsAcceptable of the most recent match, or -1 if there has been none
+  mutable QAtomicInt m_indexLastMatch;
+};
+
+#endif // FORMAT_DATE_TIME_COMPILED_H
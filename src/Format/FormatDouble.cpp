@@ -0,0 +1,141 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "FormatDouble.h"
+#include <QByteArray>
+#include <qmath.h>
+#include <qnumeric.h>
+#include <stdlib.h>
+
+// Largest precision handled by the C library path. This is enough digits to uniquely identify any double
+const int MAX_PRECISION = 17;
+
+// Fixed format values at or beyond this size are passed to QLocale, since they have more digits than any double
+// can represent exactly
+const double MAX_FIXED_MAGNITUDE = 1e17;
+
+FormatDouble::FormatDouble (const QLocale &locale) :
+  m_locale (locale),
+  m_decimalPoint (locale.decimalPoint ()),
+  m_exponential (locale.exponential ()),
+  m_negativeSign (locale.negativeSign ()),
+  m_positiveSign (locale.positiveSign ())
+{
+  // Group separators are inserted by QLocale unless omitted, and some locales use digits other than 0 to 9
+  m_canSubstitute = ((locale.numberOptions () & QLocale::OmitGroupSeparator) != 0) &&
+                    (locale.zeroDigit () == QChar ('0'));
+}
+
+QString FormatDouble::format (double value,
+                              char format,
+                              int precision) const
+{
+  bool isGeneral = (format == 'g');
+
+  if (!m_canSubstitute ||
+      !qIsFinite (value) ||
+      value == 0 || // QLocale handles the sign of negative zero its own way
+      precision < (isGeneral ? 1 : 0) ||
+      precision > MAX_PRECISION ||
+      (format == 'f' && qAbs (value) >= MAX_FIXED_MAGNITUDE)) {
+
+    return m_locale.toString (value,
+                              format,
+                              precision);
+  }
+
+  char formatString [] = "%.*?";
+  formatString [3] = format;
+
+  // Largest output is sign, 17 digits before and 17 digits after the decimal point, or an exponent
+  char buffer [64];
+  int length = qsnprintf (buffer,
+                          sizeof (buffer),
+                          formatString,
+                          precision,
+                          value);
+
+  // Substitute the locale characters. The C library may use a locale of its own for the decimal point, so any
+  // character that is not a digit, sign or exponent marker is taken to be the decimal point
+  QChar characters [sizeof (buffer)];
+  for (int i = 0; i < length; i++) {
+    char c = buffer [i];
+    if ('0' <= c && c <= '9') {
+      characters [i] = QChar (c);
+    } else if (c == '-') {
+      characters [i] = m_negativeSign;
+    } else if (c == '+') {
+      characters [i] = m_positiveSign;
+    } else if (c == 'e') {
+      characters [i] = m_exponential;
+    } else {
+      characters [i] = m_decimalPoint;
+    }
+  }
+
+  return QString (characters,
+                  length);
+}
+
+QString FormatDouble::formatFixed (double value,
+                                   int precision) const
+{
+  return format (value,
+                 'f',
+                 precision);
+}
+
+QString FormatDouble::formatGeneral (double value,
+                                     int precision) const
+{
+  return format (value,
+                 'g',
+                 precision);
+}
+
+QString FormatDouble::formatScientific (double value,
+                                        int precision) const
+{
+  return format (value,
+                 'e',
+                 precision);
+}
+
+QString FormatDouble::formatShortest (double value) const
+{
+  // Fifteen digits always round trip back to the same text, so if the value also round trips at that precision the
+  // trailing zeros removed by the 'g' format leave the shortest digits. Otherwise 16 or 17 digits are needed
+  const int MIN_ROUND_TRIP_PRECISION = 15;
+
+  if (qIsFinite (value)) {
+
+    char buffer [64];
+    for (int precision = MIN_ROUND_TRIP_PRECISION; precision < MAX_PRECISION; precision++) {
+
+      qsnprintf (buffer,
+                 sizeof (buffer),
+                 "%.*g",
+                 precision,
+                 value);
+
+      // Parse with the C library too, so its decimal point is understood
+      if (strtod (buffer, 0) == value) {
+        return format (value,
+                       'g',
+                       precision);
+      }
+    }
+  }
+
+  return format (value,
+                 'g',
+                 MAX_PRECISION);
+}
+
+const QLocale &FormatDouble::locale () const
+{
+  return m_locale;
+}
@@ -0,0 +1,63 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef FORMAT_DOUBLE_H
+#define FORMAT_DOUBLE_H
+
+#include <QChar>
+#include <QLocale>
+#include <QString>
+
+/// Fast conversion of numbers to text, giving the same text as QLocale::toString for the fixed ('f'), scientific ('e')
+/// and general ('g') formats. The digits come from the C library, which rounds correctly just like QLocale, and then the
+/// decimal point, signs and exponent character of the locale are substituted into a single buffer. Cases that
+/// substitution cannot reproduce, such as group separators, non-ASCII digits and infinities, are passed to QLocale.
+///
+/// The locale settings are captured by the constructor, so one instance should be reused for many values
+class FormatDouble
+{
+ public:
+  /// Single constructor
+  FormatDouble (const QLocale &locale);
+
+  /// Same as QLocale::toString with the 'f' format
+  QString formatFixed (double value,
+                       int precision) const;
+
+  /// Same as QLocale::toString with the 'g' format
+  QString formatGeneral (double value,
+                         int precision) const;
+
+  /// Same as QLocale::toString with the 'e' format
+  QString formatScientific (double value,
+                            int precision) const;
+
+  /// Fewest significant digits that convert back to exactly the same value, in the 'g' format
+  QString formatShortest (double value) const;
+
+  /// Locale captured by the constructor
+  const QLocale &locale () const;
+
+ private:
+  FormatDouble ();
+
+  // Format with the C library and then substitute the locale characters, or fall back to QLocale
+  QString format (double value,
+                  char format,
+                  int precision) const;
+
+  QLocale m_locale;
+
+  // True if the locale only differs from the C library output by single character substitutions
+  bool m_canSubstitute;
+
+  QChar m_decimalPoint;
+  QChar m_exponential;
+  QChar m_negativeSign;
+  QChar m_positiveSign;
+};
+
+#endif // FORMAT_DOUBLE_H
@@ -0,0 +1,106 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "DocumentModelCoords.h"
+#include "DocumentModelGeneral.h"
+#include "GeometryCache.h"
+#include "MainWindowModel.h"
+#include <QTextStream>
+#include "Transformation.h"
+
+// Enough significant digits to write every double exactly
+const int SETTINGS_KEY_PRECISION = 17;
+
+GeometryCache::GeometryCache ()
+{
+}
+
+void GeometryCache::clear ()
+{
+  m_results.clear ();
+}
+
+void GeometryCache::insert (const GeometryResult &result)
+{
+  m_results [result.curveName] = result;
+}
+
+bool GeometryCache::lookup (const QString &curveName,
+                            const QString &settingsKey,
+                            const Points &points,
+                            GeometryResult &result) const
+{
+  QHash<QString, GeometryResult>::const_iterator itr = m_results.find (curveName);
+  if (itr == m_results.end ()) {
+    return false;
+  }
+
+  const GeometryResult &resultCached = itr.value ();
+  if (resultCached.settingsKey != settingsKey ||
+      resultCached.points.count () != points.count ()) {
+    return false;
+  }
+
+  for (int i = 0; i < points.count (); i++) {
+
+    const Point &point = points.at (i);
+    const Point &pointCached = resultCached.points.at (i);
+    QPointF posScreen = point.posScreen ();
+    QPointF posScreenCached = pointCached.posScreen ();
+
+    // Exact comparison, since QPointF equality is fuzzy
+    if (posScreen.x () != posScreenCached.x () ||
+        posScreen.y () != posScreenCached.y () ||
+        point.identifier () != pointCached.identifier ()) {
+      return false;
+    }
+  }
+
+  result = resultCached;
+
+  return true;
+}
+
+QString GeometryCache::settingsKey (const DocumentModelCoords &modelCoords,
+                                    const DocumentModelGeneral &modelGeneral,
+                                    const MainWindowModel &modelMainWindow,
+                                    const Transformation &transformation,
+                                    CurveConnectAs connectAs)
+{
+  QString key;
+  QTextStream str (&key);
+  str.setRealNumberPrecision (SETTINGS_KEY_PRECISION);
+
+  // Screen to graph conversion
+  str << "transformIsDefined=" << (transformation.transformIsDefined () ? "yes" : "no");
+  if (transformation.transformIsDefined ()) {
+    QTransform matrix = transformation.transformMatrix ();
+    str << " matrix=(" << matrix.m11 () << ", " << matrix.m12 () << ", " << matrix.m13 () << ", "
+        << matrix.m21 () << ", " << matrix.m22 () << ", " << matrix.m23 () << ", "
+        << matrix.m31 () << ", " << matrix.m32 () << ", " << matrix.m33 () << ")";
+  }
+  str << " coordsType=" << modelCoords.coordsType ()
+      << " coordScaleXTheta=" << modelCoords.coordScaleXTheta ()
+      << " coordScaleYRadius=" << modelCoords.coordScaleYRadius ()
+      << " originRadius=" << modelCoords.originRadius ();
+
+  // Formatting of the x and y columns
+  str << " coordUnitsX=" << modelCoords.coordUnitsX ()
+      << " coordUnitsY=" << modelCoords.coordUnitsY ()
+      << " coordUnitsTheta=" << modelCoords.coordUnitsTheta ()
+      << " coordUnitsRadius=" << modelCoords.coordUnitsRadius ()
+      << " coordUnitsDate=" << modelCoords.coordUnitsDate ()
+      << " coordUnitsTime=" << modelCoords.coordUnitsTime ()
+      << " extraPrecision=" << modelGeneral.extraPrecision ()
+      << " locale=" << modelMainWindow.locale ().name ()
+      << " numberOptions=" << (int) modelMainWindow.locale ().numberOptions ();
+
+  // Strategy
+  str << " connectAs=" << curveConnectAsToString (connectAs);
+  str.flush ();
+
+  return key;
+}
@@ -0,0 +1,56 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GEOMETRY_CACHE_H
+#define GEOMETRY_CACHE_H
+
+#include "CurveConnectAs.h"
+#include "GeometryResult.h"
+#include <QHash>
+#include <QString>
+
+class DocumentModelCoords;
+class DocumentModelGeneral;
+class MainWindowModel;
+class Transformation;
+
+/// Cache of GeometryWindow results, with one entry per curve. An entry is valid while the points of its curve, in
+/// order with the same positions and identifiers, and the settings that go into the calculation are unchanged. This
+/// tracks which curves are dirty without any help from the commands, so a command that only touches other curves,
+/// or only changes settings that geometry does not use, does not cause a recalculation
+class GeometryCache
+{
+public:
+  /// Single constructor
+  GeometryCache ();
+
+  /// Discard all entries
+  void clear ();
+
+  /// Store a result, replacing any earlier result for the same curve
+  void insert (const GeometryResult &result);
+
+  /// Return true, with the result, if the curve has an entry for the same points and settings
+  bool lookup (const QString &curveName,
+               const QString &settingsKey,
+               const Points &points,
+               GeometryResult &result) const;
+
+  /// Text that identifies just the settings used by GeometryStrategyContext::calculateGeometry, so changes to other
+  /// settings keep the cached results. Numbers are written with full precision so different settings never give
+  /// the same text
+  static QString settingsKey (const DocumentModelCoords &modelCoords,
+                              const DocumentModelGeneral &modelGeneral,
+                              const MainWindowModel &modelMainWindow,
+                              const Transformation &transformation,
+                              CurveConnectAs connectAs);
+
+private:
+
+  QHash<QString, GeometryResult> m_results; // Keyed by curve name
+};
+
+#endif // GEOMETRY_CACHE_H
@@ -0,0 +1,92 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "EngaugeAssert.h"
+#include "GeometryPrefixSums.h"
+#include <qmath.h>
+
+GeometryPrefixSums::GeometryPrefixSums ()
+{
+}
+
+void GeometryPrefixSums::append (const QPointF &posGraph,
+                                 double distance,
+                                 double functionArea,
+                                 double shoelace)
+{
+  m_positionsGraph.append (posGraph);
+  m_distances.append (distance);
+  m_functionAreas.append (functionArea);
+  m_shoelaces.append (shoelace);
+}
+
+void GeometryPrefixSums::clear ()
+{
+  m_positionsGraph.clear ();
+  m_distances.clear ();
+  m_functionAreas.clear ();
+  m_shoelaces.clear ();
+}
+
+int GeometryPrefixSums::count () const
+{
+  return m_positionsGraph.count ();
+}
+
+double GeometryPrefixSums::distance (int indexFrom,
+                                     int indexTo) const
+{
+  ENGAUGE_ASSERT (0 <= indexFrom && indexFrom < count ());
+  ENGAUGE_ASSERT (0 <= indexTo && indexTo < count ());
+
+  return qAbs (m_distances.at (indexTo) - m_distances.at (indexFrom));
+}
+
+double GeometryPrefixSums::distanceTotal () const
+{
+  return (count () > 0 ?
+            distance (0, count () - 1) :
+            0);
+}
+
+double GeometryPrefixSums::functionArea (int indexFrom,
+                                         int indexTo) const
+{
+  ENGAUGE_ASSERT (0 <= indexFrom && indexFrom < count ());
+  ENGAUGE_ASSERT (0 <= indexTo && indexTo < count ());
+
+  return m_functionAreas.at (indexTo) - m_functionAreas.at (indexFrom);
+}
+
+double GeometryPrefixSums::functionAreaTotal () const
+{
+  return (count () > 0 ?
+            functionArea (0, count () - 1) :
+            0);
+}
+
+double GeometryPrefixSums::polygonArea (int indexFrom,
+                                        int indexTo) const
+{
+  ENGAUGE_ASSERT (0 <= indexFrom && indexFrom < count ());
+  ENGAUGE_ASSERT (0 <= indexTo && indexTo < count ());
+
+  // Shoelace formula, with the terms along the curve coming from the running sums
+  const QPointF &posFrom = m_positionsGraph.at (indexFrom);
+  const QPointF &posTo = m_positionsGraph.at (indexTo);
+
+  double sum = m_shoelaces.at (indexTo) - m_shoelaces.at (indexFrom);
+  sum += posTo.x() * posFrom.y() - posFrom.x() * posTo.y();
+
+  return qAbs (sum) / 2.0;
+}
+
+double GeometryPrefixSums::polygonAreaTotal () const
+{
+  return (count () > 0 ?
+            polygonArea (0, count () - 1) :
+            0);
+}
@@ -0,0 +1,70 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GEOMETRY_PREFIX_SUMS_H
+#define GEOMETRY_PREFIX_SUMS_H
+
+#include <QPointF>
+#include <QVector>
+
+/// Running sums of arc length, area under the curve and shoelace terms along a curve, in graph coordinates, with one
+/// entry per curve point. The sums are accumulated over the same subinterval points used for the distance columns,
+/// so smooth curves include their curvature. The distance and area between any two points then take constant time,
+/// which GeometryWindow uses for the points selected in its table.
+///
+/// The sums are rebuilt in one pass whenever the curve changes, for straight curves as well as smooth ones. A local
+/// edit of a straight curve only changes its two neighboring intervals, but every later running sum still shifts, so
+/// patching would be no cheaper than the rebuild
+class GeometryPrefixSums
+{
+public:
+  /// Single constructor, with no points
+  GeometryPrefixSums ();
+
+  /// Append the next curve point, with the sums from the first point up to this point
+  void append (const QPointF &posGraph,
+               double distance,
+               double functionArea,
+               double shoelace);
+
+  /// Remove all points
+  void clear ();
+
+  /// Number of points
+  int count () const;
+
+  /// Distance along the curve between two points
+  double distance (int indexFrom,
+                   int indexTo) const;
+
+  /// Distance along the whole curve. Zero if there are no points
+  double distanceTotal () const;
+
+  /// Area under the curve between two points, by trapezoidal integration. This is signed, and only applies to functions
+  double functionArea (int indexFrom,
+                       int indexTo) const;
+
+  /// Area under the whole curve. Zero if there are no points
+  double functionAreaTotal () const;
+
+  /// Area inside the polygon formed by the curve between two points, closed by a straight line back to the first
+  /// point. This is only correct if the polygon is simply connected
+  double polygonArea (int indexFrom,
+                      int indexTo) const;
+
+  /// Area inside the whole curve, closed by a straight line from the last point back to the first point. Zero if there
+  /// are no points
+  double polygonAreaTotal () const;
+
+private:
+
+  QVector<QPointF> m_positionsGraph;
+  QVector<double> m_distances;
+  QVector<double> m_functionAreas;
+  QVector<double> m_shoelaces; // Sums of x(k) * y(k+1) - x(k+1) * y(k) over consecutive subinterval points
+};
+
+#endif // GEOMETRY_PREFIX_SUMS_H
@@ -0,0 +1,56 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GEOMETRY_RESULT_H
+#define GEOMETRY_RESULT_H
+
+#include "GeometryPrefixSums.h"
+#include "Points.h"
+#include <QString>
+#include <QVector>
+
+/// Output of GeometryStrategyContext::calculateGeometry for one curve, together with the inputs it was calculated
+/// from so GeometryCache can tell whether it is still valid
+struct GeometryResult {
+  /// Curve that was calculated
+  QString curveName;
+
+  /// Settings the calculation depended on, from GeometryCache::settingsKey
+  QString settingsKey;
+
+  /// Points of the curve, in order
+  Points points;
+
+  /// Area under the curve if it is a function
+  QString funcArea;
+
+  /// Area inside the curve if it is a relation
+  QString polyArea;
+
+  /// Formatted x coordinate of each point. Empty if the transformation was not defined
+  QVector<QString> x;
+
+  /// Formatted y coordinate of each point. Empty if the transformation was not defined
+  QVector<QString> y;
+
+  /// Distance along the curve from the first point
+  QVector<QString> distanceGraphForward;
+
+  /// Distance along the curve from the first point, as a percentage of the curve length
+  QVector<QString> distancePercentForward;
+
+  /// Distance along the curve from the last point
+  QVector<QString> distanceGraphBackward;
+
+  /// Distance along the curve from the last point, as a percentage of the curve length
+  QVector<QString> distancePercentBackward;
+
+  /// Running sums along the curve, for distances and areas between any two points. Empty if the transformation was
+  /// not defined
+  GeometryPrefixSums prefixSums;
+};
+
+#endif // GEOMETRY_RESULT_H
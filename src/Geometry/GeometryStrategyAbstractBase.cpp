@@ -6,7 +6,10 @@
 
 #include "EngaugeAssert.h"
 #include "FormatCoordsUnits.h"
+#include "FormatDouble.h"
+#include "GeometryPrefixSums.h"
 #include "GeometryStrategyAbstractBase.h"
+#include <QLocale>
 #include <qmath.h>
 #include <QPointF>
 #include "Spline.h"
@@ -42,30 +45,16 @@ void GeometryStrategyAbstractBase::calculatePositionsGraph (const Points &points
   }
 }
 
-double GeometryStrategyAbstractBase::functionArea (const QVector<QPointF> &positionsGraph) const
-{
-  // Integrate using trapezoidal approximation to get the area under the function
-  double sum = 0, xLast = 0, yLast = 0;
-  for (int i = 1; i < positionsGraph.size (); i++) {
-    double x = positionsGraph [i].x();
-    double y = positionsGraph [i].y();
-    double area = 0.5 * (y + yLast) * (x - xLast);
-    sum += area;
-    xLast = x;
-    yLast = y;
-  }
-
-  return sum;
-}
-
 void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subintervalsPerInterval,
                                                                        const QVector<QPointF> &positionsGraph,
-                                                                       QVector<QPointF> &positionsGraphWithSubintervals,
+                                                                       GeometryPrefixSums &prefixSums,
                                                                        QVector<QString> &distanceGraphForward,
                                                                        QVector<QString> &distancePercentForward,
                                                                        QVector<QString> &distanceGraphBackward,
                                                                        QVector<QString> &distancePercentBackward) const
 {
+  prefixSums.clear ();
+
   if (positionsGraph.size () > 0) {
 
     int i;
@@ -82,34 +71,36 @@ void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subin
     Spline spline (t,
                    xy);
 
-    // Loop over the original points, with one original point per original interval
-    QVector<double> distanceGraphDouble;
-    double xLast = 0, yLast = 0, distance = 0;
+    // In the interval i-1 to i we insert points to create smaller subintervals, going from i-1 (exclusive) to
+    // i (inclusive). Interval i=0 contributes just its last point. The t values increase, so they are interpolated
+    // in one batch
+    vector<double> tSubintervals;
     for (i = 0; i < positionsGraph.size(); i++) {
+      for (int subinterval = (i > 0 ? 0 : subintervalsPerInterval - 1); subinterval < subintervalsPerInterval; subinterval++) {
+        tSubintervals.push_back ((double) (i - 1.0) + (double) (subinterval + 1) / (double) (subintervalsPerInterval));
+      }
+    }
 
-      // In the interval i-1 to i we insert points to create smaller subintervals
-      for (int subinterval = 0; subinterval < subintervalsPerInterval; subinterval++) {
-
-        // Go from i-1 (exclusive) to i (inclusive)
-        double t = (double) (i - 1.0) + (double) (subinterval + 1) / (double) (subintervalsPerInterval);
-
-        SplinePair splinePair = spline.interpolateCoeff (t);
-
-        double x = splinePair.x ();
-        double y = splinePair.y ();
+    vector<SplinePair> xySubintervals;
+    spline.interpolateCoeffs (tSubintervals,
+                              xySubintervals);
 
-        // All points from intervals where i>0, and last point from interval i=0
-        if (i > 0 || subinterval == subintervalsPerInterval - 1) {
+    // Accumulate the sums along the subinterval points, with one entry per original point
+    double xLast = 0, yLast = 0, distance = 0, functionArea = 0, shoelace = 0;
+    unsigned int k = 0;
+    for (i = 0; i < positionsGraph.size(); i++) {
 
-          // Insert one of several new points for each original point
-          positionsGraphWithSubintervals.push_back (QPointF (x, y));
+      int count = (i > 0 ? subintervalsPerInterval : 1);
+      for (int subinterval = 0; subinterval < count; subinterval++, k++) {
 
-        }
+        double x = xySubintervals [k].x ();
+        double y = xySubintervals [k].y ();
 
-        if (i > 0) {
+        if (k > 0) {
 
-          // Add to cumulative distance
           distance += qSqrt ((x - xLast) * (x - xLast) + (y - yLast) * (y - yLast));
+          functionArea += 0.5 * (y + yLast) * (x - xLast); // Trapezoidal integration
+          shoelace += xLast * y - x * yLast;
 
         }
 
@@ -117,18 +108,23 @@ void GeometryStrategyAbstractBase::insertSubintervalsAndLoadDistances (int subin
         yLast = y;
       }
 
-      // Insert one distance entry for each original point
-      distanceGraphDouble.push_back (distance);
+      prefixSums.append (QPointF (xLast, yLast),
+                         distance,
+                         functionArea,
+                         shoelace);
     }
 
     // Compute distance columns
-    double dTotal = qMax (1.0, distanceGraphDouble [distanceGraphDouble.size() - 1]); // qMax prevents divide by zero
-    for (i = 0; i < distanceGraphDouble.size (); i++) {
-      double d = distanceGraphDouble [i];
-      distanceGraphForward.push_back (QString::number (d));
-      distancePercentForward.push_back (QString::number (100.0 * d / dTotal));
-      distanceGraphBackward.push_back (QString::number (dTotal - d));
-      distancePercentBackward.push_back (QString::number (100.0 * (dTotal - d) / dTotal));
+    // Same text as QString::number, which uses the C locale and six significant digits
+    const int PRECISION = 6;
+    FormatDouble format (QLocale::c ());
+    double dTotal = qMax (1.0, prefixSums.distanceTotal ()); // qMax prevents divide by zero
+    for (i = 0; i < prefixSums.count (); i++) {
+      double d = prefixSums.distance (0, i);
+      distanceGraphForward.push_back (format.formatGeneral (d, PRECISION));
+      distancePercentForward.push_back (format.formatGeneral (100.0 * d / dTotal, PRECISION));
+      distanceGraphBackward.push_back (format.formatGeneral (dTotal - d, PRECISION));
+      distancePercentBackward.push_back (format.formatGeneral (100.0 * (dTotal - d) / dTotal, PRECISION));
     }
   }
 }
@@ -163,21 +159,3 @@ void GeometryStrategyAbstractBase::loadXY (const QVector<QPointF> &positionsGrap
   }
 }
 
-double GeometryStrategyAbstractBase::polygonAreaForSimplyConnected (const QVector<QPointF> &points) const
-{
-  // Shoelace formula
-  int N = points.size ();
-
-  double sum = 0.0;
-  if (N > 0) {
-
-
-    for (int i = 0; i < N - 1; i++) {
-      sum += points [i].x() * points [i + 1].y() - points [i + 1].x() * points [i].y();
-    }
-
-    sum += points [N  - 1].x() * points [0].y() - points [0].x() * points [N - 1].y ();
-  }
-
-  return qAbs (sum) / 2.0;
-}
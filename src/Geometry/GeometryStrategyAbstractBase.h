@@ -13,6 +13,7 @@
 
 class DocumentModelCoords;
 class DocumentModelGeneral;
+class GeometryPrefixSums;
 class MainWindowModel;
 class QPointF;
 class Transformation;
@@ -27,42 +28,22 @@ public:
   GeometryStrategyAbstractBase();
   virtual ~GeometryStrategyAbstractBase ();
 
-  /// Calculate geometry parameters
-  virtual void calculateGeometry (const Points &points,
-                                  const DocumentModelCoords &modelCoords,
-                                  const DocumentModelGeneral &modelGeneral,
-                                  const MainWindowModel &modelMainWindow,
-                                  const Transformation &transformation,
-                                  QString &funcArea,
-                                  QString &polyArea,
-                                  QVector<QString> &x,
-                                  QVector<QString> &y,
-                                  QVector<QString> &distanceGraphForward,
-                                  QVector<QString> &distancePercentForward,
-                                  QVector<QString> &distanceGraphBackward,
-                                  QVector<QString> &distancePercentBackward) const = 0;
-
-protected:
+  /// Calculate distances and areas from the graph coordinates of the points. This uses neither the logger nor
+  /// assertions that the inputs can fail, so unlike the other methods it can be called outside the GUI thread
+  virtual void calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                           QString &funcArea,
+                                           QString &polyArea,
+                                           QVector<QString> &distanceGraphForward,
+                                           QVector<QString> &distancePercentForward,
+                                           QVector<QString> &distanceGraphBackward,
+                                           QVector<QString> &distancePercentBackward,
+                                           GeometryPrefixSums &prefixSums) const = 0;
 
-  /// Convert screen positions to graph positions
+  /// Convert screen positions to graph positions. The transformation must be defined
   void calculatePositionsGraph (const Points &points,
                                 const Transformation &transformation,
                                 QVector<QPointF> &positionsGraph) const;
 
-  /// Use trapezoidal approximation to compute area under the function. Does not apply to relation
-  double functionArea (const QVector<QPointF> &positionsGraph) const;
-
-  /// Insert the specified number of subintervals into each interval. For straight curves subintervalsPerInterval=1 so the
-  /// linearity is maintained, and for smooth curves subintervalsPerInterval>1 so the geometry calculations take into account
-  /// the curvature(s) of the line
-  void insertSubintervalsAndLoadDistances (int subintervalsPerInterval,
-                                           const QVector<QPointF> &positionsGraph,
-                                           QVector<QPointF> &positionsGraphWithSubintervals,
-                                           QVector<QString> &distanceGraphForward,
-                                           QVector<QString> &distancePercentForward,
-                                           QVector<QString> &distanceGraphBackward,
-                                           QVector<QString> &distancePercentBackward) const;
-
   /// Load x and y coordinate vectors
   void loadXY (const QVector<QPointF> &positionsGraph,
                const DocumentModelCoords &modelCoords,
@@ -72,9 +53,19 @@ protected:
                QVector<QString> &x,
                QVector<QString> &y) const;
 
-  /// Area in polygon using Shoelace formula, which only works if polygon is simply connected. We do not
-  /// check to see if the polygon is simply connected since that would be (1) slow and (2) much work
-  double polygonAreaForSimplyConnected (const QVector<QPointF> &points) const;
+protected:
+
+  /// Insert the specified number of subintervals into each interval. For straight curves subintervalsPerInterval=1 so the
+  /// linearity is maintained, and for smooth curves subintervalsPerInterval>1 so the geometry calculations take into account
+  /// the curvature(s) of the line. The running sums of distance and areas along the subinterval points are loaded into
+  /// prefixSums, from which the distance columns are computed
+  void insertSubintervalsAndLoadDistances (int subintervalsPerInterval,
+                                           const QVector<QPointF> &positionsGraph,
+                                           GeometryPrefixSums &prefixSums,
+                                           QVector<QString> &distanceGraphForward,
+                                           QVector<QString> &distancePercentForward,
+                                           QVector<QString> &distanceGraphBackward,
+                                           QVector<QString> &distancePercentBackward) const;
 
 };
 
@@ -10,6 +10,7 @@
 #include "GeometryStrategyFunctionStraight.h"
 #include "GeometryStrategyRelationSmooth.h"
 #include "GeometryStrategyRelationStraight.h"
+#include <QPointF>
 #include "Transformation.h"
 
 GeometryStrategyContext::GeometryStrategyContext()
@@ -24,6 +25,26 @@ GeometryStrategyContext::~GeometryStrategyContext()
 {
 }
 
+void GeometryStrategyContext::calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                                          CurveConnectAs connectAs,
+                                                          QString &funcArea,
+                                                          QString &polyArea,
+                                                          QVector<QString> &distanceGraphForward,
+                                                          QVector<QString> &distancePercentForward,
+                                                          QVector<QString> &distanceGraphBackward,
+                                                          QVector<QString> &distancePercentBackward,
+                                                          GeometryPrefixSums &prefixSums) const
+{
+  m_strategies [connectAs]->calculateDistancesAndAreas (positionsGraph,
+                                                        funcArea,
+                                                        polyArea,
+                                                        distanceGraphForward,
+                                                        distancePercentForward,
+                                                        distanceGraphBackward,
+                                                        distancePercentBackward,
+                                                        prefixSums);
+}
+
 void GeometryStrategyContext::calculateGeometry (const Points &points,
                                                  const DocumentModelCoords &modelCoords,
                                                  const DocumentModelGeneral &modelGeneral,
@@ -37,22 +58,55 @@ void GeometryStrategyContext::calculateGeometry (const Points &points,
                                                  QVector<QString> &distanceGraphForward,
                                                  QVector<QString> &distancePercentForward,
                                                  QVector<QString> &distanceGraphBackward,
-                                                 QVector<QString> &distancePercentBackward) const
+                                                 QVector<QString> &distancePercentBackward,
+                                                 GeometryPrefixSums &prefixSums) const
 {
   if (transformation.transformIsDefined()) {
 
-    m_strategies [connectAs]->calculateGeometry (points,
-                                                 modelCoords,
-                                                 modelGeneral,
-                                                 modelMainWindow,
-                                                 transformation,
-                                                 funcArea,
-                                                 polyArea,
-                                                 x,
-                                                 y,
-                                                 distanceGraphForward,
-                                                 distancePercentForward,
-                                                 distanceGraphBackward,
-                                                 distancePercentBackward);
+    QVector<QPointF> positionsGraph;
+    calculatePositionsGraphAndXY (points,
+                                  modelCoords,
+                                  modelGeneral,
+                                  modelMainWindow,
+                                  transformation,
+                                  connectAs,
+                                  positionsGraph,
+                                  x,
+                                  y);
+
+    calculateDistancesAndAreas (positionsGraph,
+                                connectAs,
+                                funcArea,
+                                polyArea,
+                                distanceGraphForward,
+                                distancePercentForward,
+                                distanceGraphBackward,
+                                distancePercentBackward,
+                                prefixSums);
   }
 }
+
+void GeometryStrategyContext::calculatePositionsGraphAndXY (const Points &points,
+                                                            const DocumentModelCoords &modelCoords,
+                                                            const DocumentModelGeneral &modelGeneral,
+                                                            const MainWindowModel &modelMainWindow,
+                                                            const Transformation &transformation,
+                                                            CurveConnectAs connectAs,
+                                                            QVector<QPointF> &positionsGraph,
+                                                            QVector<QString> &x,
+                                                            QVector<QString> &y) const
+{
+  const GeometryStrategyAbstractBase *strategy = m_strategies [connectAs];
+
+  strategy->calculatePositionsGraph (points,
+                                     transformation,
+                                     positionsGraph);
+
+  strategy->loadXY (positionsGraph,
+                    modelCoords,
+                    modelGeneral,
+                    modelMainWindow,
+                    transformation,
+                    x,
+                    y);
+}
@@ -14,7 +14,9 @@
 
 class DocumentModelCoords;
 class DocumentModelGeneral;
+class GeometryPrefixSums;
 class GeometryStrategyAbstractBase;
+class QPointF;
 class Transformation;
 
 /// Class for that manages geometry strategies
@@ -25,7 +27,20 @@ public:
   GeometryStrategyContext();
   virtual ~GeometryStrategyContext ();
 
-  /// Calculate geometry parameters
+  /// Calculate distances and areas from the graph coordinates given by calculatePositionsGraphAndXY. Unlike the other
+  /// methods this can be called outside the GUI thread, since it uses neither the logger nor assertions that the
+  /// inputs can fail
+  void calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                   CurveConnectAs connectAs,
+                                   QString &funcArea,
+                                   QString &polyArea,
+                                   QVector<QString> &distanceGraphForward,
+                                   QVector<QString> &distancePercentForward,
+                                   QVector<QString> &distanceGraphBackward,
+                                   QVector<QString> &distancePercentBackward,
+                                   GeometryPrefixSums &prefixSums) const;
+
+  /// Calculate geometry parameters. Nothing is calculated if the transformation is not defined
   void calculateGeometry (const Points &points,
                           const DocumentModelCoords &modelCoords,
                           const DocumentModelGeneral &modelGeneral,
@@ -39,7 +54,20 @@ public:
                           QVector<QString> &distanceGraphForward,
                           QVector<QString> &distancePercentForward,
                           QVector<QString> &distanceGraphBackward,
-                          QVector<QString> &distancePercentBackward) const;
+                          QVector<QString> &distancePercentBackward,
+                          GeometryPrefixSums &prefixSums) const;
+
+  /// Convert the points to graph coordinates, and format them for the x and y columns. The transformation must be
+  /// defined
+  void calculatePositionsGraphAndXY (const Points &points,
+                                     const DocumentModelCoords &modelCoords,
+                                     const DocumentModelGeneral &modelGeneral,
+                                     const MainWindowModel &modelMainWindow,
+                                     const Transformation &transformation,
+                                     CurveConnectAs connectAs,
+                                     QVector<QPointF> &positionsGraph,
+                                     QVector<QString> &x,
+                                     QVector<QString> &y) const;
 
 private:
 
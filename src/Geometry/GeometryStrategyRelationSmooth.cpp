@@ -4,8 +4,8 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "GeometryPrefixSums.h"
 #include "GeometryStrategyRelationSmooth.h"
-#include "Transformation.h"
 
 GeometryStrategyRelationSmooth::GeometryStrategyRelationSmooth()
 {
@@ -15,43 +15,25 @@ GeometryStrategyRelationSmooth::~GeometryStrategyRelationSmooth()
 {
 }
 
-void GeometryStrategyRelationSmooth::calculateGeometry (const Points &points,
-                                                        const DocumentModelCoords &modelCoords,
-                                                        const DocumentModelGeneral &modelGeneral,
-                                                        const MainWindowModel &modelMainWindow,
-                                                        const Transformation &transformation,
-                                                        QString &funcArea,
-                                                        QString &polyArea,
-                                                        QVector<QString> &x,
-                                                        QVector<QString> &y,
-                                                        QVector<QString> &distanceGraphForward,
-                                                        QVector<QString> &distancePercentForward,
-                                                        QVector<QString> &distanceGraphBackward,
-                                                        QVector<QString> &distancePercentBackward) const
+void GeometryStrategyRelationSmooth::calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                                                 QString &funcArea,
+                                                                 QString &polyArea,
+                                                                 QVector<QString> &distanceGraphForward,
+                                                                 QVector<QString> &distancePercentForward,
+                                                                 QVector<QString> &distanceGraphBackward,
+                                                                 QVector<QString> &distancePercentBackward,
+                                                                 GeometryPrefixSums &prefixSums) const
 {
   const int NUM_SUB_INTERVALS_SMOOTH = 10; // One input point becomes NUM_SUB_INTERVALS points to account for smoothing
 
-  QVector<QPointF> positionsGraph, positionsGraphWithSubintervals;
-  calculatePositionsGraph (points,
-                           transformation,
-                           positionsGraph);
-
   insertSubintervalsAndLoadDistances (NUM_SUB_INTERVALS_SMOOTH,
                                       positionsGraph,
-                                      positionsGraphWithSubintervals,
+                                      prefixSums,
                                       distanceGraphForward,
                                       distancePercentForward,
                                       distanceGraphBackward,
                                       distancePercentBackward);
-  double pArea = polygonAreaForSimplyConnected (positionsGraphWithSubintervals);
-
-  loadXY (positionsGraph,
-          modelCoords,
-          modelGeneral,
-          modelMainWindow,
-          transformation,
-          x,
-          y);
+  double pArea = prefixSums.polygonAreaTotal ();
 
   // Set header values
   funcArea = "";
@@ -10,8 +10,6 @@
 #include "GeometryStrategyAbstractBase.h"
 #include <QVector>
 
-class Transformation;
-
 /// Calculate for line through the points that is smoothly connected as a relation
 class GeometryStrategyRelationSmooth : public GeometryStrategyAbstractBase
 {
@@ -20,20 +18,15 @@ public:
   GeometryStrategyRelationSmooth();
   virtual ~GeometryStrategyRelationSmooth ();
 
-  /// Calculate geometry parameters
-  virtual void calculateGeometry (const Points &points,
-                                  const DocumentModelCoords &modelCoords,
-                                  const DocumentModelGeneral &modelGeneral,
-                                  const MainWindowModel &modelMainWindow,
-                                  const Transformation &transformation,
-                                  QString &funcArea,
-                                  QString &polyArea,
-                                  QVector<QString> &x,
-                                  QVector<QString> &y,
-                                  QVector<QString> &distanceGraphForward,
-                                  QVector<QString> &distancePercentForward,
-                                  QVector<QString> &distanceGraphBackward,
-                                  QVector<QString> &distancePercentBackward) const;
+  /// Calculate distances and areas from the graph coordinates of the points
+  virtual void calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                           QString &funcArea,
+                                           QString &polyArea,
+                                           QVector<QString> &distanceGraphForward,
+                                           QVector<QString> &distancePercentForward,
+                                           QVector<QString> &distanceGraphBackward,
+                                           QVector<QString> &distancePercentBackward,
+                                           GeometryPrefixSums &prefixSums) const;
 
 };
 
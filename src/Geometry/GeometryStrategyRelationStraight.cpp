@@ -4,8 +4,8 @@
  * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
  ******************************************************************************************************/
 
+#include "GeometryPrefixSums.h"
 #include "GeometryStrategyRelationStraight.h"
-#include "Transformation.h"
 
 GeometryStrategyRelationStraight::GeometryStrategyRelationStraight()
 {
@@ -15,43 +15,25 @@ GeometryStrategyRelationStraight::~GeometryStrategyRelationStraight()
 {
 }
 
-void GeometryStrategyRelationStraight::calculateGeometry (const Points &points,
-                                                          const DocumentModelCoords &modelCoords,
-                                                          const DocumentModelGeneral &modelGeneral,
-                                                          const MainWindowModel &modelMainWindow,
-                                                          const Transformation &transformation,
-                                                          QString &funcArea,
-                                                          QString &polyArea,
-                                                          QVector<QString> &x,
-                                                          QVector<QString> &y,
-                                                          QVector<QString> &distanceGraphForward,
-                                                          QVector<QString> &distancePercentForward,
-                                                          QVector<QString> &distanceGraphBackward,
-                                                          QVector<QString> &distancePercentBackward) const
+void GeometryStrategyRelationStraight::calculateDistancesAndAreas (const QVector<QPointF> &positionsGraph,
+                                                                   QString &funcArea,
+                                                                   QString &polyArea,
+                                                                   QVector<QString> &distanceGraphForward,
+                                                                   QVector<QString> &distancePercentForward,
+                                                                   QVector<QString> &distanceGraphBackward,
+                                                                   QVector<QString> &distancePercentBackward,
+                                                                   GeometryPrefixSums &prefixSums) const
 {
   const int NUM_SUB_INTERVALS_STRAIGHT = 1; // Value of one with trapezoidal integration results in calculations using straight lines between points
 
-  QVector<QPointF> positionsGraph, positionsGraphWithSubintervals;
-  calculatePositionsGraph (points,
-                           transformation,
-                           positionsGraph);
-
   insertSubintervalsAndLoadDistances (NUM_SUB_INTERVALS_STRAIGHT,
                                       positionsGraph,
-                                      positionsGraphWithSubintervals,
+                                      prefixSums,
                                       distanceGraphForward,
                                       distancePercentForward,
                                       distanceGraphBackward,
                                       distancePercentBackward);
-  double pArea = polygonAreaForSimplyConnected (positionsGraphWithSubintervals);
-
-  loadXY (positionsGraph,
-          modelCoords,
-          modelGeneral,
-          modelMainWindow,
-          transformation,
-          x,
-          y);
+  double pArea = prefixSums.polygonAreaTotal ();
 
   // Set header values
   funcArea = "";
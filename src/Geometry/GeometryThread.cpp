@@ -0,0 +1,55 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "GeometryThread.h"
+
+GeometryThread::GeometryThread () :
+  m_requestId (0),
+  m_connectAs (CONNECT_AS_FUNCTION_SMOOTH),
+  m_requestIdTaken (0),
+  m_connectAsTaken (CONNECT_AS_FUNCTION_SMOOTH)
+{
+}
+
+void GeometryThread::processRequest ()
+{
+  // No logging here, since this is not the GUI thread
+  m_geometryStrategyContext.calculateDistancesAndAreas (m_positionsGraphTaken,
+                                                        m_connectAsTaken,
+                                                        m_resultTaken.funcArea,
+                                                        m_resultTaken.polyArea,
+                                                        m_resultTaken.distanceGraphForward,
+                                                        m_resultTaken.distancePercentForward,
+                                                        m_resultTaken.distanceGraphBackward,
+                                                        m_resultTaken.distancePercentBackward,
+                                                        m_resultTaken.prefixSums);
+
+  emit signalGeometry (m_requestIdTaken,
+                       m_resultTaken);
+}
+
+void GeometryThread::request (int requestId,
+                              CurveConnectAs connectAs,
+                              const QVector<QPointF> &positionsGraph,
+                              const GeometryResult &result)
+{
+  beginRequest ();
+
+  m_requestId = requestId;
+  m_connectAs = connectAs;
+  m_positionsGraph = positionsGraph;
+  m_result = result;
+
+  endRequest ();
+}
+
+void GeometryThread::takeRequest ()
+{
+  m_requestIdTaken = m_requestId;
+  m_connectAsTaken = m_connectAs;
+  m_positionsGraphTaken = m_positionsGraph;
+  m_resultTaken = m_result;
+}
@@ -0,0 +1,67 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GEOMETRY_THREAD_H
+#define GEOMETRY_THREAD_H
+
+#include "CoalescingThread.h"
+#include "CurveConnectAs.h"
+#include "GeometryResult.h"
+#include "GeometryStrategyContext.h"
+#include <QPointF>
+#include <QVector>
+
+/// Thread that calculates geometry for GeometryWindow when GeometryCache has no valid result, so the GUI thread stays
+/// responsive for curves with many points. The conversion to graph coordinates and the formatting of the x and y
+/// columns, which log and assert, are done in the GUI thread by GeometryStrategyContext::calculatePositionsGraphAndXY.
+/// This thread does the rest, which is the spline fit, the running sums and the distance columns
+class GeometryThread : public CoalescingThread
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor
+  GeometryThread ();
+
+  /// Queue a calculation. The result has its curve name, settings key, points and x and y columns already set, and
+  /// positionsGraph holds the graph coordinates of its points. All inputs are copied. The thread is started if it is
+  /// not already running
+  void request (int requestId,
+                CurveConnectAs connectAs,
+                const QVector<QPointF> &positionsGraph,
+                const GeometryResult &result);
+
+signals:
+  /// Send the result of one request back to the GUI thread
+  void signalGeometry (int requestId,
+                       GeometryResult result);
+
+protected:
+  /// Calculate the distances and areas of the request taken by takeRequest
+  virtual void processRequest ();
+
+  /// Copy out the latest request
+  virtual void takeRequest ();
+
+private:
+
+  // Strategies are used only by this thread
+  GeometryStrategyContext m_geometryStrategyContext;
+
+  // Latest request, guarded by the lock of CoalescingThread
+  int m_requestId;
+  CurveConnectAs m_connectAs;
+  QVector<QPointF> m_positionsGraph;
+  GeometryResult m_result;
+
+  // Request being processed, used only by this thread
+  int m_requestIdTaken;
+  CurveConnectAs m_connectAsTaken;
+  QVector<QPointF> m_positionsGraphTaken;
+  GeometryResult m_resultTaken;
+};
+
+#endif // GEOMETRY_THREAD_H
@@ -11,13 +11,16 @@
 #include "CurveStyle.h"
 #include "EngaugeAssert.h"
 #include "GeometryModel.h"
+#include "GeometryThread.h"
 #include "GeometryWindow.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include <QApplication>
 #include <QClipboard>
 #include <QItemSelectionModel>
+#include <QPointF>
 #include <QTextStream>
+#include <QVector>
 #include "WindowTable.h"
 
 // Token constraints:
@@ -32,8 +35,15 @@ const QString TokenIndex (QObject::tr ("Index"));
 const QString TokenDistanceGraph (QObject::tr ("Distance"));
 const QString TokenDistancePercent (QObject::tr ("Percent"));
 
+// Curves with fewer points are calculated in the GUI thread, since that takes less time than a round trip to the
+// background thread and avoids showing the previous result in the meantime
+const int BACKGROUND_POINTS_MIN = 500;
+
 GeometryWindow::GeometryWindow (MainWindow *mainWindow) :
-  WindowAbstractBase (mainWindow)
+  WindowAbstractBase (mainWindow),
+  m_geometryThread (0),
+  m_geometryRequestId (0),
+  m_geometryRequestIdCleared (0)
 {
   setVisible (false);
   setAllowedAreas (Qt::AllDockWidgetAreas);
@@ -49,10 +59,16 @@ GeometryWindow::GeometryWindow (MainWindow *mainWindow) :
                     "Index = Point number\n\n"
                     "Distance = Distance along the curve in forward or backward direction, in either graph units "
                     "or as a percentage\n\n"
+                    "When two or more rows are selected, the distance and area between the first and last selected points "
+                    "appear as a tooltip\n\n"
                     "If drag-and-drop is disabled, a rectangular set of cells may be selected by clicking and dragging. Otherwise, if "
                     "drag-and-drop is enabled, a rectangular set of cells may be selected using Click then Shift+Click, since click and drag "
                     "starts the dragging operation. Drag-and-drop mode is set in the Main Window settings"));
 
+  m_geometryThread = new GeometryThread;
+  connect (m_geometryThread, SIGNAL (signalGeometry (int, GeometryResult)),
+           this, SLOT (slotGeometry (int, GeometryResult)));
+
   createWidgets (mainWindow);
   loadStrategies();
   initializeHeader ();
@@ -60,6 +76,9 @@ GeometryWindow::GeometryWindow (MainWindow *mainWindow) :
 
 GeometryWindow::~GeometryWindow()
 {
+  // Calculation in progress uses copies of its inputs, so it only has to finish
+  m_geometryThread->wait ();
+  delete m_geometryThread;
 }
 
 void GeometryWindow::clear ()
@@ -71,6 +90,12 @@ void GeometryWindow::clear ()
   for (int row = 0; row < NUM_HEADER_ROWS - 1; row++) {
     m_model->setItem (row, COLUMN_HEADER_VALUE, new QStandardItem (""));
   }
+
+  // Cached results and any calculation still in progress are for a Document that is gone
+  m_geometryCache.clear ();
+  m_geometryRequestIdCleared = ++m_geometryRequestId;
+  m_resultDisplayed = GeometryResult ();
+  m_view->setToolTip ("");
 }
 
 void GeometryWindow::closeEvent(QCloseEvent * /* event */)
@@ -92,6 +117,8 @@ void GeometryWindow::createWidgets (MainWindow *mainWindow)
   m_view = new WindowTable (*m_model);
   connect (m_view, SIGNAL (signalTableStatusChange ()),
            mainWindow, SLOT (slotTableStatusChange ()));
+  connect (m_view->selectionModel (), SIGNAL (selectionChanged (const QItemSelection &, const QItemSelection &)),
+           this, SLOT (slotSelectionChanged (const QItemSelection &, const QItemSelection &)));
 
   setWidget (m_view);
 }
@@ -133,6 +160,42 @@ void GeometryWindow::loadStrategies ()
   LOG4CPP_INFO_S ((*mainCat)) << "GeometryWindow::loadStrategies";
 }
 
+void GeometryWindow::loadTable (const GeometryResult &result)
+{
+  m_resultDisplayed = result;
+
+  // Output to table. Only cells whose text changed are updated, which after an edit of a large curve is usually
+  // a small fraction of them
+  resizeTable (NUM_HEADER_ROWS + result.points.count());
+
+  setCellText (HEADER_ROW_NAME, COLUMN_HEADER_VALUE, result.curveName);
+  setCellText (HEADER_ROW_FUNC_AREA, COLUMN_HEADER_VALUE, result.funcArea);
+  setCellText (HEADER_ROW_POLY_AREA, COLUMN_HEADER_VALUE, result.polyArea);
+
+  // Body is empty if the transformation was not defined
+  int row = NUM_HEADER_ROWS;
+  int index = 0;
+  for (; index < result.x.count(); row++, index++) {
+
+    const Point &point = result.points.at (index);
+
+    setCellText (row, COLUMN_BODY_X, result.x [index]);
+    setCellText (row, COLUMN_BODY_Y, result.y [index]);
+    setCellText (row, COLUMN_BODY_INDEX, QString::number (index + 1));
+    setCellText (row, COLUMN_BODY_DISTANCE_GRAPH_FORWARD, result.distanceGraphForward [index]);
+    setCellText (row, COLUMN_BODY_DISTANCE_PERCENT_FORWARD, result.distancePercentForward [index]);
+    setCellText (row, COLUMN_BODY_DISTANCE_GRAPH_BACKWARD, result.distanceGraphBackward [index]);
+    setCellText (row, COLUMN_BODY_DISTANCE_PERCENT_BACKWARD, result.distancePercentBackward [index]);
+    setCellText (row, COLUMN_BODY_POINT_IDENTIFIERS, point.identifier());
+  }
+
+  // Unselect everything
+  unselectAll ();
+
+  // Make sure the hidden column stays hidden
+  m_view->setColumnHidden (COLUMN_BODY_POINT_IDENTIFIERS, true);
+}
+
 void GeometryWindow::resizeTable (int rowCount)
 {
   LOG4CPP_INFO_S ((*mainCat)) << "GeometryWindow::resizeTable";
@@ -144,6 +207,37 @@ void GeometryWindow::resizeTable (int rowCount)
 
 }
 
+void GeometryWindow::setCellText (int row,
+                                  int column,
+                                  const QString &text)
+{
+  QStandardItem *item = m_model->item (row, column);
+
+  if (item == 0) {
+    m_model->setItem (row, column, new QStandardItem (text));
+  } else if (item->text () != text) {
+    item->setText (text);
+  }
+}
+
+void GeometryWindow::slotGeometry (int requestId,
+                                   GeometryResult result)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "GeometryWindow::slotGeometry";
+
+  // Results requested before the last clear are for a Document that is gone
+  if (requestId < m_geometryRequestIdCleared) {
+    return;
+  }
+
+  // A stale result is still correct for its own points and settings
+  m_geometryCache.insert (result);
+
+  if (requestId == m_geometryRequestId) {
+    loadTable (result);
+  }
+}
+
 void GeometryWindow::slotPointHoverEnter (QString pointIdentifier)
 {
   m_model->setCurrentPointIdentifier (pointIdentifier);
@@ -154,6 +248,43 @@ void GeometryWindow::slotPointHoverLeave (QString /* pointIdentifier */)
   m_model->setCurrentPointIdentifier ("");
 }
 
+void GeometryWindow::slotSelectionChanged (const QItemSelection & /* selected */,
+                                           const QItemSelection & /* deselected */)
+{
+  const GeometryPrefixSums &prefixSums = m_resultDisplayed.prefixSums;
+
+  // Selection ranges are used rather than the selected cells, which can number in the millions
+  int indexFirst = prefixSums.count (), indexLast = -1;
+  QItemSelection selection = m_view->selectionModel ()->selection ();
+  QItemSelection::const_iterator itr;
+  for (itr = selection.begin (); itr != selection.end (); itr++) {
+    indexFirst = qMin (indexFirst, itr->top () - NUM_HEADER_ROWS);
+    indexLast = qMax (indexLast, itr->bottom () - NUM_HEADER_ROWS);
+  }
+  indexFirst = qMax (indexFirst, 0);
+  indexLast = qMin (indexLast, prefixSums.count () - 1);
+
+  QString toolTip;
+  if (indexFirst < indexLast) {
+
+    bool isFunction = !m_resultDisplayed.funcArea.isEmpty ();
+    double area = (isFunction ?
+                     prefixSums.functionArea (indexFirst, indexLast) :
+                     prefixSums.polygonArea (indexFirst, indexLast));
+
+    toolTip = QString ("%1 %2-%3\n%4 %5\n%6 %7")
+              .arg (TokenIndex)
+              .arg (indexFirst + 1)
+              .arg (indexLast + 1)
+              .arg (TokenDistanceGraph)
+              .arg (QString::number (prefixSums.distance (indexFirst, indexLast)))
+              .arg (isFunction ? TokenFunctionArea : TokenPolygonArea)
+              .arg (QString::number (area));
+  }
+
+  m_view->setToolTip (toolTip);
+}
+
 void GeometryWindow::unselectAll ()
 {
   QItemSelectionModel *selectionModel = m_view->selectionModel ();
@@ -173,67 +304,87 @@ void GeometryWindow::update (const CmdMediator &cmdMediator,
   m_model->setDelimiter (m_modelExport.delimiter());
   m_view->setDragEnabled (modelMainWindow.dragDropExport());
 
-  // Gather and calculate geometry data
+  // Gather geometry inputs
   const Curve *curve = cmdMediator.document().curveForCurveName (curveSelected);
 
   ENGAUGE_CHECK_PTR (curve);
 
   const Points points = curve->points();
 
-  QString funcArea, polyArea;
-  QVector<QString> x, y, distanceGraphForward, distancePercentForward, distanceGraphBackward, distancePercentBackward;
-
   CurveStyle curveStyle = cmdMediator.document().modelCurveStyles().curveStyle (curveSelected);
-  m_geometryStrategyContext.calculateGeometry (points,
-                                               cmdMediator.document().modelCoords(),
-                                               cmdMediator.document().modelGeneral(),
-                                               modelMainWindow,
-                                               transformation,
-                                               curveStyle.lineStyle().curveConnectAs(),
-                                               funcArea,
-                                               polyArea,
-                                               x,
-                                               y,
-                                               distanceGraphForward,
-                                               distancePercentForward,
-                                               distanceGraphBackward,
-                                               distancePercentBackward);
-
-  // Output to table
-  resizeTable (NUM_HEADER_ROWS + points.count());
-
-  m_model->setItem (HEADER_ROW_NAME, COLUMN_HEADER_VALUE, new QStandardItem (curveSelected));
-  m_model->setItem (HEADER_ROW_FUNC_AREA, COLUMN_HEADER_VALUE, new QStandardItem (funcArea));
-  m_model->setItem (HEADER_ROW_POLY_AREA, COLUMN_HEADER_VALUE, new QStandardItem (polyArea));
-
-  if (transformation.transformIsDefined()) {
-
-    int row = NUM_HEADER_ROWS;
-    int index = 0;
-    for (; index < points.count(); row++, index++) {
-
-      const Point &point = points.at (index);
-
-      QPointF posGraph;
-      transformation.transformScreenToRawGraph (point.posScreen (),
-                                                posGraph);
-
-      m_model->setItem (row, COLUMN_BODY_X, new QStandardItem (x [index]));
-      m_model->setItem (row, COLUMN_BODY_Y, new QStandardItem (y [index]));
-      m_model->setItem (row, COLUMN_BODY_INDEX, new QStandardItem (QString::number (index + 1)));
-      m_model->setItem (row, COLUMN_BODY_DISTANCE_GRAPH_FORWARD, new QStandardItem (distanceGraphForward [index]));
-      m_model->setItem (row, COLUMN_BODY_DISTANCE_PERCENT_FORWARD, new QStandardItem (distancePercentForward [index]));
-      m_model->setItem (row, COLUMN_BODY_DISTANCE_GRAPH_BACKWARD, new QStandardItem (distanceGraphBackward [index]));
-      m_model->setItem (row, COLUMN_BODY_DISTANCE_PERCENT_BACKWARD, new QStandardItem (distancePercentBackward [index]));
-      m_model->setItem (row, COLUMN_BODY_POINT_IDENTIFIERS, new QStandardItem (point.identifier()));
+  CurveConnectAs connectAs = curveStyle.lineStyle().curveConnectAs();
+  QString settingsKey = GeometryCache::settingsKey (cmdMediator.document().modelCoords(),
+                                                    cmdMediator.document().modelGeneral(),
+                                                    modelMainWindow,
+                                                    transformation,
+                                                    connectAs);
+
+  // Any calculation in progress is for older inputs
+  ++m_geometryRequestId;
+
+  GeometryResult result;
+  if (m_geometryCache.lookup (curveSelected,
+                              settingsKey,
+                              points,
+                              result)) {
+
+    // Curve has not changed since it was last calculated
+    loadTable (result);
+
+  } else if (points.count () < BACKGROUND_POINTS_MIN ||
+             !transformation.transformIsDefined ()) {
+
+    result.curveName = curveSelected;
+    result.settingsKey = settingsKey;
+    result.points = points;
+    m_geometryStrategyContext.calculateGeometry (points,
+                                                 cmdMediator.document().modelCoords(),
+                                                 cmdMediator.document().modelGeneral(),
+                                                 modelMainWindow,
+                                                 transformation,
+                                                 connectAs,
+                                                 result.funcArea,
+                                                 result.polyArea,
+                                                 result.x,
+                                                 result.y,
+                                                 result.distanceGraphForward,
+                                                 result.distancePercentForward,
+                                                 result.distanceGraphBackward,
+                                                 result.distancePercentBackward,
+                                                 result.prefixSums);
+
+    m_geometryCache.insert (result);
+    loadTable (result);
+
+  } else {
+
+    // Previous result of the same curve stays on display until slotGeometry, but that of another curve would mislead
+    if (m_resultDisplayed.curveName != curveSelected) {
+      GeometryResult resultPending;
+      resultPending.curveName = curveSelected;
+      loadTable (resultPending);
     }
-  }
-
-  // Unselect everything
-  unselectAll ();
 
-  // Make sure the hidden column stays hidden
-  m_view->setColumnHidden (COLUMN_BODY_POINT_IDENTIFIERS, true);
+    // Parts that log or assert are done here, since the thread must do neither
+    result.curveName = curveSelected;
+    result.settingsKey = settingsKey;
+    result.points = points;
+    QVector<QPointF> positionsGraph;
+    m_geometryStrategyContext.calculatePositionsGraphAndXY (points,
+                                                            cmdMediator.document().modelCoords(),
+                                                            cmdMediator.document().modelGeneral(),
+                                                            modelMainWindow,
+                                                            transformation,
+                                                            connectAs,
+                                                            positionsGraph,
+                                                            result.x,
+                                                            result.y);
+
+    m_geometryThread->request (m_geometryRequestId,
+                               connectAs,
+                               positionsGraph,
+                               result);
+  }
 }
 
 QTableView *GeometryWindow::view () const
@@ -8,12 +8,15 @@
 #define GEOMETRY_WINDOW_H
 
 #include "DocumentModelExportFormat.h"
+#include "GeometryCache.h"
+#include "GeometryResult.h"
 #include "GeometryStrategyContext.h"
 #include "WindowAbstractBase.h"
 
 class CmdMediator;
 class Curve;
 class GeometryModel;
+class GeometryThread;
 class MainWindow;
 class MainWindowModel;
 class QItemSelection;
@@ -55,6 +58,16 @@ public slots:
   /// Unhighlight the row for the specified point
   void slotPointHoverLeave (QString);
 
+private slots:
+
+  /// Show the result of a calculation that ran on the background thread
+  void slotGeometry (int requestId,
+                     GeometryResult result);
+
+  /// Show the distance and area between the first and last selected points
+  void slotSelectionChanged (const QItemSelection &selected,
+                             const QItemSelection &deselected);
+
 signals:
 
   /// Signal that this QDockWidget was just closed
@@ -66,7 +79,11 @@ private:
   void createWidgets (MainWindow *mainWindow);
   void initializeHeader();
   void loadStrategies ();
+  void loadTable (const GeometryResult &result);
   void resizeTable (int rowCount);
+  void setCellText (int row,
+                    int column,
+                    const QString &text); // Reuses the existing item, which is much faster when the text is unchanged
   void unselectAll (); // Unselect all cells. This cleans up nicely when Document is closed
 
   enum ColumnsHeader {
@@ -100,6 +117,15 @@ private:
 
   GeometryStrategyContext m_geometryStrategyContext;
 
+  // Results of earlier calculations, so curves that did not change are not calculated again
+  GeometryCache m_geometryCache;
+
+  // Calculations of curves with many points. Results of any request but the latest are cached but not shown
+  GeometryThread *m_geometryThread;
+  int m_geometryRequestId;
+  int m_geometryRequestIdCleared; // Request id at the most recent clear, so earlier results are dropped
+  GeometryResult m_resultDisplayed; // Result in the table, with the running sums for the selected points
+
   // Export format is updated after every CmdAbstractBase gets redone/undone
   DocumentModelExportFormat m_modelExport;
 };
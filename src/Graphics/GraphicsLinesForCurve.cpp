@@ -223,22 +223,22 @@ void GraphicsLinesForCurve::lineMembershipReset ()
 
 bool GraphicsLinesForCurve::needOrdinalRenumbering () const
 {
-  // Ordinals should be 0, 1, ...
-  bool needRenumbering = false;
-  for (int ordinalKeyWanted = 0; ordinalKeyWanted < m_graphicsPoints.count(); ordinalKeyWanted++) {
+  // Ordinals should be 0, 1, ... The keys are walked directly, since QMap::keys would copy all of them for every point
+  int ordinalKeyWanted = 0;
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++, ordinalKeyWanted++) {
 
-    double ordinalKeyGot = m_graphicsPoints.keys().at (ordinalKeyWanted);
+    double ordinalKeyGot = itr.key();
 
     // Sanity checks
     ENGAUGE_ASSERT (ordinalKeyGot != Point::UNDEFINED_ORDINAL ());
 
     if (ordinalKeyWanted != ordinalKeyGot) {
-      needRenumbering = true;
-      break;
+      return true;
     }
   }
 
-  return needRenumbering;
+  return false;
 }
 
 void GraphicsLinesForCurve::printStream (QString indentation,
@@ -299,24 +299,18 @@ void GraphicsLinesForCurve::renumberOrdinals ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "GraphicsLinesForCurve::renumberOrdinals";
 
-  int ordinalKeyWanted;
-
   // Ordinals should be 0, 1, and so on. Assigning a list to QMap::keys has no effect, so the
-  // approach is to copy to a temporary list and then copy back
-  QList<GraphicsPoint*> points;
-  for (ordinalKeyWanted = 0; ordinalKeyWanted < m_graphicsPoints.count(); ordinalKeyWanted++) {
+  // approach is to build a new map in one pass over the old map, which is already in ordinal order
+  OrdinalToGraphicsPoint graphicsPointsRenumbered;
+  int ordinalKeyWanted = 0;
+  OrdinalToGraphicsPoint::const_iterator itr;
+  for (itr = m_graphicsPoints.begin(); itr != m_graphicsPoints.end(); itr++) {
 
-    GraphicsPoint *graphicsPoint = m_graphicsPoints.values().at (ordinalKeyWanted);
-    points << graphicsPoint;
+    GraphicsPoint *graphicsPoint = itr.value();
+    graphicsPointsRenumbered [ordinalKeyWanted++] = graphicsPoint;
   }
 
-  m_graphicsPoints.clear ();
-
-  for (ordinalKeyWanted = 0; ordinalKeyWanted < points.count(); ordinalKeyWanted++) {
-
-    GraphicsPoint *graphicsPoint = points.at (ordinalKeyWanted);
-    m_graphicsPoints [ordinalKeyWanted] = graphicsPoint;
-  }
+  m_graphicsPoints = graphicsPointsRenumbered;
 }
 
 void GraphicsLinesForCurve::updateAfterCommand (GraphicsScene &scene,
@@ -457,14 +451,7 @@ void GraphicsLinesForCurve::updatePointOrdinalsAfterDrag (const LineStyle &lineS
       temporaryList [ordinalNew++] = point;
     }
 
-    // Copy from temporary back to original map
-    m_graphicsPoints.clear();
-    for (itrP = temporaryList.begin(); itrP != temporaryList.end(); itrP++) {
-
-      double ordinal = itrP.key();
-      GraphicsPoint *point = itrP.value();
-
-      m_graphicsPoints [ordinal] = point;
-    }
+    // Replace the original map, which is implicitly shared so nothing is copied
+    m_graphicsPoints = temporaryList;
   }
 }
@@ -6,6 +6,7 @@
 
 #include "ColorFilter.h"
 #include "Correlation.h"
+#include "CorrelationBorrow.h"
 #include "DocumentModelCoords.h"
 #include "EngaugeAssert.h"
 #include "GridClassifier.h"
@@ -15,12 +16,14 @@
 #include <QFile>
 #include <QImage>
 #include "QtToString.h"
+#include <QVector>
 #include "Transformation.h"
 
 int GridClassifier::NUM_PIXELS_PER_HISTOGRAM_BINS = 1;
 double GridClassifier::PEAK_HALF_WIDTH = 4;
 int GridClassifier::MIN_STEP_PIXELS = 4 * GridClassifier::PEAK_HALF_WIDTH; // Step includes down ramp, flat part, up ramp
 const QString GNUPLOT_DELIMITER ("\t");
+const int CANDIDATES_PER_BATCH = 64; // Bounds memory used for picket fences and correlations during batch correlation
 
 // We set up the picket fence with binStart arbitrarily set close to zero. Peak is
 // not exactly at zero since we want to include the left side of the first peak.
@@ -349,7 +352,15 @@ void GridClassifier::populateHistogramBins (const QImage &image,
   ColorFilter filter;
   QRgb rgbBackground = filter.marginColor (&image);
 
+  bool isPolar = (transformation.modelCoords().coordsType() == COORDS_TYPE_POLAR);
+  double thetaPeriod = (isPolar ? transformation.modelCoords().thetaPeriod() : 0);
+
+  // Foreground pixels of each column are transformed together using the batch transformation
+  QVector<double> xColumn (image.height()), yColumn (image.height());
+
   for (int x = 0; x < image.width(); x++) {
+
+    int count = 0;
     for (int y = 0; y < image.height(); y++) {
 
       QColor pixel = image.pixel (x, y);
@@ -358,36 +369,49 @@ void GridClassifier::populateHistogramBins (const QImage &image,
       if (!filter.colorCompare (rgbBackground,
                                 pixel.rgb ())) {
 
-        // Add this pixel to histograms
-        QPointF posGraph;
-        transformation.transformScreenToRawGraph (QPointF (x, y), posGraph);
+        xColumn [count] = x;
+        yColumn [count] = y;
+        ++count;
+      }
+    }
 
-        if (transformation.modelCoords().coordsType() == COORDS_TYPE_POLAR) {
+    transformation.transformScreenToRawGraph (count,
+                                              xColumn.constData (),
+                                              yColumn.constData (),
+                                              xColumn.data (),
+                                              yColumn.data ());
 
-          // If out of the 0 to period range, the theta value must shifted by the period to get into that range
-          while (posGraph.x() < xMin) {
-            posGraph.setX (posGraph.x() + transformation.modelCoords().thetaPeriod());
-          }
-          while (posGraph.x() > xMax) {
-            posGraph.setX (posGraph.x() - transformation.modelCoords().thetaPeriod());
-          }
+    // Add the pixels to histograms
+    for (int i = 0; i < count; i++) {
+
+      QPointF posGraph (xColumn [i],
+                        yColumn [i]);
+
+      if (isPolar) {
+
+        // If out of the 0 to period range, the theta value must shifted by the period to get into that range
+        while (posGraph.x() < xMin) {
+          posGraph.setX (posGraph.x() + thetaPeriod);
+        }
+        while (posGraph.x() > xMax) {
+          posGraph.setX (posGraph.x() - thetaPeriod);
         }
+      }
 
-        int binX = binFromCoordinate (posGraph.x(), xMin, xMax);
-        int binY = binFromCoordinate (posGraph.y(), yMin, yMax);
+      int binX = binFromCoordinate (posGraph.x(), xMin, xMax);
+      int binY = binFromCoordinate (posGraph.y(), yMin, yMax);
 
-        ENGAUGE_ASSERT (0 <= binX);
-        ENGAUGE_ASSERT (0 <= binY);
-        ENGAUGE_ASSERT (binX < m_numHistogramBins);
-        ENGAUGE_ASSERT (binY < m_numHistogramBins);
+      ENGAUGE_ASSERT (0 <= binX);
+      ENGAUGE_ASSERT (0 <= binY);
+      ENGAUGE_ASSERT (binX < m_numHistogramBins);
+      ENGAUGE_ASSERT (binY < m_numHistogramBins);
 
-        // Roundoff error in log scaling may let bin go just outside legal range
-        binX = qMin (binX, m_numHistogramBins - 1);
-        binY = qMin (binY, m_numHistogramBins - 1);
+      // Roundoff error in log scaling may let bin go just outside legal range
+      binX = qMin (binX, m_numHistogramBins - 1);
+      binY = qMin (binY, m_numHistogramBins - 1);
 
-        ++m_binsX [binX];
-        ++m_binsY [binY];
-      }
+      ++m_binsX [binX];
+      ++m_binsY [binY];
     }
   }
 }
@@ -402,7 +426,7 @@ void GridClassifier::searchCountSpace (double bins [],
                               << " step=" << binStep;
 
   // Loop though the space of possible counts
-  Correlation correlation (m_numHistogramBins);
+  CorrelationBorrow correlation (m_numHistogramBins);
   double *picketFence = new double [m_numHistogramBins];
   double corr, corrMax;
   bool isFirst = true;
@@ -415,10 +439,10 @@ void GridClassifier::searchCountSpace (double bins [],
                      count,
                      true);
 
-    correlation.correlateWithoutShift (m_numHistogramBins,
-                                       bins,
-                                       picketFence,
-                                       corr);
+    correlation->correlateWithoutShift (m_numHistogramBins,
+                                        bins,
+                                        picketFence,
+                                        corr);
     if (isFirst || (corr > corrMax)) {
       countMax = count;
       corrMax = corr;
@@ -445,66 +469,90 @@ void GridClassifier::searchStartStepSpace (bool isGnuplot,
   // Correlations are tracked for logging
   double *signalA = new double [m_numHistogramBins];
   double *signalB = new double [m_numHistogramBins];
-  double *correlations = new double [m_numHistogramBins];
   double *correlationsMax = new double [m_numHistogramBins];
 
-  // Loop though the space of possible gridlines using the independent variables (start,step).
-  Correlation correlation (m_numHistogramBins);
-  double *picketFence = new double [m_numHistogramBins];
-  int binStart;
-  double corr = 0, corrMax = 0;
+  // Loop though the space of possible gridlines using the independent variables (start,step). Candidate picket
+  // fences are correlated in batches against the histogram, which is transformed only once, and the candidates
+  // are spread across threads. Results within each batch are examined in order of increasing step, so the
+  // selection logic is the same as when correlating one candidate at a time
+  CorrelationBorrow correlation (m_numHistogramBins);
+  double *picketFences = new double [CANDIDATES_PER_BATCH * m_numHistogramBins];
+  double *correlations = new double [CANDIDATES_PER_BATCH * m_numHistogramBins];
+  const double *picketFencePointers [CANDIDATES_PER_BATCH];
+  double *correlationsPointers [CANDIDATES_PER_BATCH];
+  int binStarts [CANDIDATES_PER_BATCH];
+  double corrs [CANDIDATES_PER_BATCH];
+  for (int candidate = 0; candidate < CANDIDATES_PER_BATCH; candidate++) {
+    picketFencePointers [candidate] = picketFences + candidate * m_numHistogramBins;
+    correlationsPointers [candidate] = correlations + candidate * m_numHistogramBins;
+  }
+  correlation->loadReference (m_numHistogramBins,
+                              bins);
+  double corrMax = 0;
   bool isFirst = true;
 
-  // We do not explicitly search(=loop) through binStart here, since Correlation::correlateWithShift will take
+  // We do not explicitly search(=loop) through binStart here, since Correlation::correlateWithShiftBatch will take
   // care of that for us
 
   // Step search starts out small, and stops at value that gives count substantially greater than 2. Freakishly small
   // images need to have MIN_STEP_PIXELS overridden so the loop iterates at least once
   binStartMax = BIN_START_UNSHIFTED + 1; // In case search below ever fails
   binStepMax = qMin (MIN_STEP_PIXELS, m_numHistogramBins / 8); // In case search below ever fails
-  for (int binStep = qMin (MIN_STEP_PIXELS, m_numHistogramBins / 8); binStep < m_numHistogramBins / 4; binStep++) {
+  int binStepStop = m_numHistogramBins / 4;
+  for (int binStepFirst = qMin (MIN_STEP_PIXELS, m_numHistogramBins / 8); binStepFirst < binStepStop; binStepFirst += CANDIDATES_PER_BATCH) {
+
+    int count = qMin (CANDIDATES_PER_BATCH, binStepStop - binStepFirst);
+    for (int candidate = 0; candidate < count; candidate++) {
+      loadPicketFence (picketFences + candidate * m_numHistogramBins,
+                       BIN_START_UNSHIFTED,
+                       binStepFirst + candidate,
+                       PEAK_HALF_WIDTH,
+                       false);
+    }
 
-    loadPicketFence (picketFence,
-                     BIN_START_UNSHIFTED,
-                     binStep,
-                     PEAK_HALF_WIDTH,
-                     false);
-
-    correlation.correlateWithShift (m_numHistogramBins,
-                                    bins,
-                                    picketFence,
-                                    binStart,
-                                    corr,
-                                    correlations);
-    if (isFirst || (corr > corrMax)) {
+    correlation->correlateWithShiftBatch (m_numHistogramBins,
+                                          count,
+                                          picketFencePointers,
+                                          binStarts,
+                                          corrs,
+                                          correlationsPointers);
+
+    for (int candidate = 0; candidate < count; candidate++) {
+
+      int binStep = binStepFirst + candidate;
+      int binStart = binStarts [candidate];
+      double corr = corrs [candidate];
 
-      int binStartMaxNext = binStart + BIN_START_UNSHIFTED + 1; // Compensate for the shift performed inside loadPicketFence
+      if (isFirst || (corr > corrMax)) {
 
-      // Make sure binStartMax never goes out of bounds
-      if (binStartMaxNext < m_numHistogramBins) {
+        int binStartMaxNext = binStart + BIN_START_UNSHIFTED + 1; // Compensate for the shift performed inside loadPicketFence
 
-        binStartMax = binStartMaxNext;
-        binStepMax = binStep;
-        corrMax = corr;
-        copyVectorToVector (bins, signalA);
-        copyVectorToVector (picketFence, signalB);
-        copyVectorToVector (correlations, correlationsMax);
+        // Make sure binStartMax never goes out of bounds
+        if (binStartMaxNext < m_numHistogramBins) {
 
-        // Output a gnuplot file. We should see the correlation values consistently increasing
-        if (isGnuplot) {
+          binStartMax = binStartMaxNext;
+          binStepMax = binStep;
+          corrMax = corr;
+          copyVectorToVector (bins, signalA);
+          copyVectorToVector (picketFencePointers [candidate], signalB);
+          copyVectorToVector (correlationsPointers [candidate], correlationsMax);
 
-           dumpGnuplotCoordinate(coordinateLabel,
-                                 corr,
-                                 bins,
-                                 valueMin,
-                                 valueMax,
-                                 binStart,
-                                 binStep);
+          // Output a gnuplot file. We should see the correlation values consistently increasing
+          if (isGnuplot) {
+
+             dumpGnuplotCoordinate(coordinateLabel,
+                                   corr,
+                                   bins,
+                                   valueMin,
+                                   valueMax,
+                                   binStart,
+                                   binStep);
+          }
         }
       }
-    }
 
-    isFirst = false;
+      isFirst = false;
+    }
   }
 
   // Convert from bins back to graph coordinates
@@ -540,5 +588,5 @@ void GridClassifier::searchStartStepSpace (bool isGnuplot,
   delete [] signalB;
   delete [] correlations;
   delete [] correlationsMax;
-  delete [] picketFence;
+  delete [] picketFences;
 }
@@ -16,9 +16,11 @@
 const BoundaryGroup BOUNDARY_GROUP_FIRST = 100;
 
 GridHealer::GridHealer(const QImage &imageBefore,
-                       const DocumentModelGridRemoval &modelGridRemoval) :
+                       const DocumentModelGridRemoval &modelGridRemoval,
+                       const QAtomicInt *cancelRequested) :
   m_boundaryGroupNext (BOUNDARY_GROUP_FIRST),
-  m_modelGridRemoval (modelGridRemoval)
+  m_modelGridRemoval (modelGridRemoval),
+  m_cancelRequested (cancelRequested)
 {
   LOG4CPP_INFO_S ((*mainCat)) << "GridHealer::GridHealer";
 
@@ -27,6 +29,11 @@ GridHealer::GridHealer(const QImage &imageBefore,
 
   m_pixels.resize (imageBefore.height());
   for (int row = 0; row < imageBefore.height(); row++) {
+
+    if (isCancelled ()) {
+      return;
+    }
+
     m_pixels [row].resize (imageBefore.width());
 
     for (int col = 0; col < imageBefore.width(); col++) {
@@ -48,6 +55,10 @@ void GridHealer::connectCloseGroups(QImage &imageToHeal)
   // N*(N-1)/2 search for groups that are close to each other
   for (int iFrom = 0; iFrom < m_groupNumberToCentroid.count() - 1; iFrom++) {
 
+    if (isCancelled ()) {
+      return;
+    }
+
     BoundaryGroup groupFrom = m_groupNumberToCentroid.keys().at (iFrom);
 
     ENGAUGE_ASSERT (m_groupNumberToCentroid.contains (groupFrom));
@@ -117,11 +128,62 @@ void GridHealer::erasePixel (int xCol,
   }
 }
 
+void GridHealer::erasePixels (const QVector<bool> &mask)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "GridHealer::erasePixels";
+
+  int rows = m_pixels.count();
+  int cols = (rows > 0 ? m_pixels [0].count() : 0);
+
+  ENGAUGE_ASSERT (mask.count() == rows * cols);
+
+  const bool *maskData = mask.constData();
+
+  // First pass marks the removed pixels
+  for (int row = 0; row < rows; row++) {
+    const bool *maskRow = maskData + row * cols;
+    QVector<PixelStateOrBoundaryGroup> &pixelRow = m_pixels [row];
+    for (int col = 0; col < cols; col++) {
+      if (maskRow [col]) {
+        pixelRow [col] = PIXEL_STATE_REMOVED;
+      }
+    }
+  }
+
+  // Second pass marks foreground pixels that touch a removed pixel. Since erasePixel never changes a removed
+  // pixel into an adjacent pixel, this gives the same states as erasing the pixels one at a time
+  for (int row = 0; row < rows; row++) {
+    QVector<PixelStateOrBoundaryGroup> &pixelRow = m_pixels [row];
+    for (int col = 0; col < cols; col++) {
+
+      if (pixelRow [col] == PIXEL_STATE_FOREGROUND) {
+
+        bool isAdjacent = false;
+        for (int rowSearch = qMax (0, row - 1); !isAdjacent && rowSearch <= qMin (rows - 1, row + 1); rowSearch++) {
+          const bool *maskRow = maskData + rowSearch * cols;
+          for (int colSearch = qMax (0, col - 1); !isAdjacent && colSearch <= qMin (cols - 1, col + 1); colSearch++) {
+            isAdjacent = maskRow [colSearch];
+          }
+        }
+
+        if (isAdjacent) {
+          pixelRow [col] = PIXEL_STATE_ADJACENT;
+        }
+      }
+    }
+  }
+}
+
 void GridHealer::groupContiguousAdjacentPixels()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "GridHealer::groupContiguousAdjacentPixels";
 
   for (int row = 0; row < m_pixels.count(); row++) {
+
+    if (isCancelled ()) {
+      return;
+    }
+
     for (int col = 0; col < m_pixels [0].count(); col++) {
 
       if (m_pixels [row] [col] == PIXEL_STATE_ADJACENT) {
@@ -155,7 +217,14 @@ void GridHealer::heal (QImage &imageToHeal)
   LOG4CPP_INFO_S ((*mainCat)) << "GridHealer::heal";
 
   groupContiguousAdjacentPixels ();
-  connectCloseGroups (imageToHeal);
+  if (!isCancelled ()) {
+    connectCloseGroups (imageToHeal);
+  }
+}
+
+bool GridHealer::isCancelled () const
+{
+  return (m_cancelRequested != 0) && (m_cancelRequested->load () != 0);
 }
 
 void GridHealer::recursiveSearchForAdjacentPixels (int boundaryGroup,
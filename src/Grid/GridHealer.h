@@ -7,6 +7,7 @@
 #ifndef GRID_HEALER_H
 #define GRID_HEALER_H
 
+#include <QAtomicInt>
 #include <QMap>
 #include <QPointF>
 #include <QVector>
@@ -37,15 +38,21 @@ typedef QMap<BoundaryGroup, QPointF> GroupNumberToPoint;
 class GridHealer
 {
  public:
-  /// Single constructor
+  /// Single constructor. Background processing passes a cancel flag, and the constructor and heal stop early once
+  /// the flag becomes nonzero. The results are incomplete in that case, so the caller must discard them
   GridHealer(const QImage &imageBefore,
-             const DocumentModelGridRemoval &modelGridRemoval);
+             const DocumentModelGridRemoval &modelGridRemoval,
+             const QAtomicInt *cancelRequested = 0);
 
   /// Remember that pixel was erased since it belongs to an grid line. In the image, erasure
   /// correponds to a foreground pixel being changed to the background color
   void erasePixel (int xCol,
                    int yRow);
 
+  /// Bulk version of erasePixel. The mask has one entry per pixel in row-major order, and true entries
+  /// are erased. The result is the same as calling erasePixel for each true entry, in any order
+  void erasePixels (const QVector<bool> &mask);
+
   /// Heal the broken curve lines by spanning the gaps across the newly-removed grid lines
   void heal (QImage &imageToHeal);
 
@@ -54,6 +61,7 @@ class GridHealer
 
   void connectCloseGroups(QImage &imageToHeal);
   void groupContiguousAdjacentPixels();
+  bool isCancelled () const;
   void recursiveSearchForAdjacentPixels (int boundaryGroup,
                                          int row,
                                          int col,
@@ -73,6 +81,9 @@ class GridHealer
   GroupNumberToPoint m_groupNumberToPixel;
 
   DocumentModelGridRemoval m_modelGridRemoval;
+
+  // Null when processing cannot be cancelled
+  const QAtomicInt *m_cancelRequested;
 };
 
 #endif // GRID_HEALER_H
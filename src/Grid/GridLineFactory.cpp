@@ -18,6 +18,7 @@
 #include "MainWindowModel.h"
 #include <QGraphicsScene>
 #include <qmath.h>
+#include <QStringList>
 #include <QTextStream>
 #include "QtToString.h"
 #include "Transformation.h"
@@ -92,6 +93,20 @@ GridLine *GridLineFactory::createGridLine (double xFrom,
   // desired pieces together. For straight lines in linear graphs this algorithm is very much overkill, but there is no significant
   // penalty and this approach works in every situation
 
+  if (m_pointsToIsolate.count () == 0) {
+
+    // Without points to isolate the whole line is a single segment, which is drawn as a straight line or an exact
+    // arc. Only the two endpoints are needed, so the stepping below is skipped
+    finishActiveGridLine (interpolatedScreenPoint (0.0, xFrom, yFrom, xTo, yTo, transformation),
+                          interpolatedScreenPoint (1.0, xFrom, yFrom, xTo, yTo, transformation),
+                          yFrom,
+                          yTo,
+                          transformation,
+                          *gridLine);
+
+    return gridLine;
+  }
+
   // Should give single-pixel resolution on most images, and 'good enough' resolution on extremely large images
   const int NUM_STEPS = 1000;
 
@@ -103,21 +118,12 @@ GridLine *GridLineFactory::createGridLine (double xFrom,
 
     double s = (double) i / (double) NUM_STEPS;
 
-    // Interpolate coordinates assuming normal linear scaling
-    double xGraph = (1.0 - s) * xFrom + s * xTo;
-    double yGraph = (1.0 - s) * yFrom + s * yTo;
-
-    // Replace interpolated coordinates using log scaling if appropriate, preserving the same ranges
-    if (m_modelCoords.coordScaleXTheta() == COORD_SCALE_LOG) {
-      xGraph = qExp ((1.0 - s) * qLn (xFrom) + s * qLn (xTo));
-    }
-    if (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LOG) {
-      yGraph = qExp ((1.0 - s) * qLn (yFrom) + s * qLn (yTo));
-    }
-
-    QPointF pointScreen;
-    transformation.transformRawGraphToScreen (QPointF (xGraph, yGraph),
-                                              pointScreen);
+    QPointF pointScreen = interpolatedScreenPoint (s,
+                                                   xFrom,
+                                                   yFrom,
+                                                   xTo,
+                                                   yTo,
+                                                   transformation);
 
     double distanceToNearestPoint = minScreenDistanceFromPoints (pointScreen);
     if ((distanceToNearestPoint < m_pointRadius) ||
@@ -196,6 +202,22 @@ void GridLineFactory::createGridLinesForEvenlySpacedGrid (const DocumentModelGri
         (isLinearX || (startX > 0)) &&
         (isLinearY || (startY > 0))) {
 
+      // Grid lines are rebuilt after every command, but most commands do not affect them. If every input is the
+      // same as last time then the existing grid lines are kept
+      QString cacheKey = gridLinesCacheKey (modelGridDisplay,
+                                            transformation,
+                                            startX,
+                                            stepX,
+                                            stopX,
+                                            startY,
+                                            stepY,
+                                            stopY);
+      if (cacheKey == gridLines.cacheKey ()) {
+        return;
+      }
+
+      gridLines.clear ();
+
       QColor color (ColorPaletteToQColor (modelGridDisplay.paletteColor()));
       QPen pen (QPen (color,
                       GRID_LINE_WIDTH,
@@ -214,8 +236,15 @@ void GridLineFactory::createGridLinesForEvenlySpacedGrid (const DocumentModelGri
         gridLine->setPen (pen);
         gridLines.add (gridLine);
       }
+
+      gridLines.setCacheKey (cacheKey);
+
+      return;
     }
   }
+
+  // No grid lines are possible
+  gridLines.clear ();
 }
 
 void GridLineFactory::createTransformAlign (const Transformation &transformation,
@@ -379,6 +408,73 @@ void GridLineFactory::finishActiveGridLine (const QPointF &posStartScreen,
   bindItemToScene (item);
 }
 
+QString GridLineFactory::gridLinesCacheKey (const DocumentModelGridDisplay &modelGridDisplay,
+                                            const Transformation &transformation,
+                                            double startX,
+                                            double stepX,
+                                            double stopX,
+                                            double startY,
+                                            double stepY,
+                                            double stopY) const
+{
+  // Full precision is required since a tiny change in an axis point changes the transformation
+  const char FORMAT = 'g';
+  const int PRECISION = 17;
+
+  QTransform matrix = transformation.transformMatrix ();
+
+  QStringList fields;
+  fields << QString::number (m_modelCoords.coordsType ())
+         << QString::number (m_modelCoords.coordScaleXTheta ())
+         << QString::number (m_modelCoords.coordScaleYRadius ())
+         << QString::number (m_modelCoords.coordUnitsTheta ())
+         << QString::number (m_modelCoords.originRadius (), FORMAT, PRECISION)
+         << QString::number (modelGridDisplay.paletteColor ())
+         << QString::number (startX, FORMAT, PRECISION)
+         << QString::number (stepX, FORMAT, PRECISION)
+         << QString::number (stopX, FORMAT, PRECISION)
+         << QString::number (startY, FORMAT, PRECISION)
+         << QString::number (stepY, FORMAT, PRECISION)
+         << QString::number (stopY, FORMAT, PRECISION)
+         << QString::number (matrix.m11 (), FORMAT, PRECISION)
+         << QString::number (matrix.m12 (), FORMAT, PRECISION)
+         << QString::number (matrix.m13 (), FORMAT, PRECISION)
+         << QString::number (matrix.m21 (), FORMAT, PRECISION)
+         << QString::number (matrix.m22 (), FORMAT, PRECISION)
+         << QString::number (matrix.m23 (), FORMAT, PRECISION)
+         << QString::number (matrix.m31 (), FORMAT, PRECISION)
+         << QString::number (matrix.m32 (), FORMAT, PRECISION)
+         << QString::number (matrix.m33 (), FORMAT, PRECISION);
+
+  return fields.join (" ");
+}
+
+QPointF GridLineFactory::interpolatedScreenPoint (double s,
+                                                  double xFrom,
+                                                  double yFrom,
+                                                  double xTo,
+                                                  double yTo,
+                                                  const Transformation &transformation) const
+{
+  // Interpolate coordinates assuming normal linear scaling
+  double xGraph = (1.0 - s) * xFrom + s * xTo;
+  double yGraph = (1.0 - s) * yFrom + s * yTo;
+
+  // Replace interpolated coordinates using log scaling if appropriate, preserving the same ranges
+  if (m_modelCoords.coordScaleXTheta() == COORD_SCALE_LOG) {
+    xGraph = qExp ((1.0 - s) * qLn (xFrom) + s * qLn (xTo));
+  }
+  if (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LOG) {
+    yGraph = qExp ((1.0 - s) * qLn (yFrom) + s * qLn (yTo));
+  }
+
+  QPointF pointScreen;
+  transformation.transformRawGraphToScreen (QPointF (xGraph, yGraph),
+                                            pointScreen);
+
+  return pointScreen;
+}
+
 QGraphicsItem *GridLineFactory::lineItem (const QPointF &posStartScreen,
                                           const QPointF &posEndScreen) const
 {
@@ -10,6 +10,8 @@
 #include "GridLine.h"
 #include "Point.h"
 #include <QList>
+#include <QPointF>
+#include <QString>
 
 class Document;
 class DocumentModelCoords;
@@ -47,7 +49,8 @@ public:
                             double yTo,
                             const Transformation &transformation);
 
-  /// Create a rectangular (cartesian) or annular (polar) grid of evenly spaced grid lines.
+  /// Create a rectangular (cartesian) or annular (polar) grid of evenly spaced grid lines. Any previous grid lines are
+  /// removed, unless they were generated from exactly the same inputs in which case they are kept as is
   void createGridLinesForEvenlySpacedGrid (const DocumentModelGridDisplay &modelGridDisplay,
                                            const Document &document,
                                            const MainWindowModel &modelMainWindow,
@@ -74,6 +77,20 @@ private:
                              double yTo,
                              const Transformation &transformation,
                              GridLine &gridLine) const;
+  QString gridLinesCacheKey (const DocumentModelGridDisplay &modelGridDisplay,
+                             const Transformation &transformation,
+                             double startX,
+                             double stepX,
+                             double stopX,
+                             double startY,
+                             double stepY,
+                             double stopY) const;
+  QPointF interpolatedScreenPoint (double s,
+                                   double xFrom,
+                                   double yFrom,
+                                   double xTo,
+                                   double yTo,
+                                   const Transformation &transformation) const;
   QGraphicsItem *lineItem (const QPointF &posStartScreen,
                            const QPointF &posEndScreen) const;
   double minScreenDistanceFromPoints (const QPointF &posScreen);
@@ -0,0 +1,101 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "GridLineRasterizer.h"
+#include <qmath.h>
+
+// Lines are erased with this many pixels on each side of the center pixel
+const int HALF_THICKNESS = 1;
+
+GridLineRasterizer::GridLineRasterizer (const GridLineSegments &segments,
+                                        bool *mask,
+                                        int width,
+                                        int rowStart,
+                                        int rowStop) :
+  m_segments (segments),
+  m_mask (mask),
+  m_width (width),
+  m_rowStart (rowStart),
+  m_rowStop (rowStop)
+{
+}
+
+void GridLineRasterizer::markPixel (int x,
+                                    int y)
+{
+  if (m_rowStart <= y && y < m_rowStop &&
+      0 <= x && x < m_width) {
+
+    m_mask [y * m_width + x] = true;
+  }
+}
+
+void GridLineRasterizer::rasterizeMoreHorizontal (const QLineF &segment)
+{
+  const QPointF pos1 = segment.p1();
+  const QPointF pos2 = segment.p2();
+
+  int xMin = qMin (pos1.x(), pos2.x());
+  int xMax = qMax (pos1.x(), pos2.x());
+  int yAtXMin = (pos1.x() < pos2.x() ? pos1.y() : pos2.y());
+  int yAtXMax = (pos1.x() < pos2.x() ? pos2.y() : pos1.y());
+
+  // Skip lines that cannot touch this band
+  if (qMax (yAtXMin, yAtXMax) + HALF_THICKNESS + 1 < m_rowStart ||
+      qMin (yAtXMin, yAtXMax) - HALF_THICKNESS - 1 >= m_rowStop) {
+    return;
+  }
+
+  for (int x = xMin; x <= xMax; x++) {
+    double s = (xMax == xMin ? 0.0 : (double) (x - xMin) / (double) (xMax - xMin));
+    double yLine = (1.0 - s) * yAtXMin + s * yAtXMax;
+    for (int yOffset = -HALF_THICKNESS; yOffset <= HALF_THICKNESS; yOffset++) {
+      int y = (int) (0.5 + yLine + yOffset);
+      markPixel (x, y);
+    }
+  }
+}
+
+void GridLineRasterizer::rasterizeMoreVertical (const QLineF &segment)
+{
+  const QPointF pos1 = segment.p1();
+  const QPointF pos2 = segment.p2();
+
+  int yMin = qMin (pos1.y(), pos2.y());
+  int yMax = qMax (pos1.y(), pos2.y());
+  int xAtYMin = (pos1.y() < pos2.y() ? pos1.x() : pos2.x());
+  int xAtYMax = (pos1.y() < pos2.y() ? pos2.x() : pos1.x());
+
+  // Only the rows inside this band are visited
+  int yStart = qMax (yMin, m_rowStart);
+  int yStop = qMin (yMax, m_rowStop - 1);
+  for (int y = yStart; y <= yStop; y++) {
+    double s = (yMax == yMin ? 0.0 : (double) (y - yMin) / (double) (yMax - yMin));
+    double xLine = (1.0 - s) * xAtYMin + s * xAtYMax;
+    for (int xOffset = -HALF_THICKNESS; xOffset <= HALF_THICKNESS; xOffset++) {
+      int x = (int) (0.5 + xLine + xOffset);
+      markPixel (x, y);
+    }
+  }
+}
+
+void GridLineRasterizer::run ()
+{
+  GridLineSegments::const_iterator itr;
+  for (itr = m_segments.begin(); itr != m_segments.end(); itr++) {
+
+    const QLineF &segment = *itr;
+
+    // Is line more horizontal or vertical?
+    double deltaX = qAbs (segment.x1() - segment.x2());
+    double deltaY = qAbs (segment.y1() - segment.y2());
+    if (deltaX > deltaY) {
+      rasterizeMoreHorizontal (segment);
+    } else {
+      rasterizeMoreVertical (segment);
+    }
+  }
+}
@@ -0,0 +1,49 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef GRID_LINE_RASTERIZER_H
+#define GRID_LINE_RASTERIZER_H
+
+#include <QLineF>
+#include <QRunnable>
+#include <QVector>
+
+/// Grid line segments, already clipped to the image boundaries, in screen coordinates
+typedef QVector<QLineF> GridLineSegments;
+
+/// Runnable that rasterizes every grid line segment into one horizontal band of a removal mask. Each band
+/// covers a disjoint set of rows so any number of bands can be processed concurrently without locking. The
+/// pixels written are exactly those that GridRemoval erased one at a time before the mask was introduced
+class GridLineRasterizer : public QRunnable
+{
+public:
+  /// Single constructor. The mask has one entry per pixel in row-major order, and must
+  /// outlive this object. Only rows rowStart (inclusive) to rowStop (exclusive) are written
+  GridLineRasterizer (const GridLineSegments &segments,
+                      bool *mask,
+                      int width,
+                      int rowStart,
+                      int rowStop);
+
+  /// Rasterize all segments into this band
+  virtual void run ();
+
+private:
+  GridLineRasterizer ();
+
+  void markPixel (int x,
+                  int y);
+  void rasterizeMoreHorizontal (const QLineF &segment);
+  void rasterizeMoreVertical (const QLineF &segment);
+
+  const GridLineSegments &m_segments;
+  bool *m_mask;
+  int m_width;
+  int m_rowStart;
+  int m_rowStop;
+};
+
+#endif // GRID_LINE_RASTERIZER_H
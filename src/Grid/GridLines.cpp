@@ -16,6 +16,11 @@ void GridLines::add (GridLine *gridLine)
   m_gridLinesContainer.push_back (gridLine);
 }
 
+QString GridLines::cacheKey () const
+{
+  return m_cacheKey;
+}
+
 void GridLines::clear ()
 {
   for (int i = 0; i < m_gridLinesContainer.count(); i++) {
@@ -26,6 +31,12 @@ void GridLines::clear ()
   }
 
   m_gridLinesContainer.clear();
+  m_cacheKey = "";
+}
+
+void GridLines::setCacheKey (const QString &cacheKey)
+{
+  m_cacheKey = cacheKey;
 }
 
 void GridLines::setPen (const QPen &pen)
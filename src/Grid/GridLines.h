@@ -9,6 +9,7 @@
 
 #include "GridLine.h"
 #include <QList>
+#include <QString>
 
 class QPen;
 
@@ -24,9 +25,16 @@ class GridLines
   /// Add specified grid line. Ownership of all allocated QGraphicsItems is passed to new GridLine
   void add (GridLine *gridLine);
 
-  /// Deallocate and remove all grid lines
+  /// Key describing the inputs that the current grid lines were generated from. Empty if unknown
+  QString cacheKey () const;
+
+  /// Deallocate and remove all grid lines. The cache key is also cleared
   void clear ();
 
+  /// Set key describing the inputs that the current grid lines were generated from, so GridLineFactory can skip
+  /// regenerating identical grid lines
+  void setCacheKey (const QString &cacheKey);
+
   /// Set the pen style of each grid line
   void setPen (const QPen &pen);
 
@@ -37,6 +45,8 @@ class GridLines
 
   GridLinesContainer m_gridLinesContainer;
 
+  QString m_cacheKey;
+
 };
 
 #endif // GRID_LINES_H
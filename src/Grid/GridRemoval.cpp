@@ -12,14 +12,43 @@
 #include <qdebug.h>
 #include <QImage>
 #include <qmath.h>
+#include <QThread>
+#include "RunnableBatch.h"
 #include "Transformation.h"
 
 const double EPSILON = 0.000001;
 
-GridRemoval::GridRemoval()
+GridRemoval::GridRemoval() :
+  m_screenScale (1.0),
+  m_cancelRequested (0)
 {
 }
 
+GridRemoval::GridRemoval (double screenScale,
+                          const QAtomicInt &cancelRequested) :
+  m_screenScale (screenScale),
+  m_cancelRequested (&cancelRequested)
+{
+}
+
+void GridRemoval::addGraphLine (const Transformation &transformation,
+                                const QPointF &posGraphMin,
+                                const QPointF &posGraphMax,
+                                const QImage &image,
+                                GridLineSegments &segments) const
+{
+  QPointF posScreenMin, posScreenMax;
+  transformation.transformRawGraphToScreen (posGraphMin,
+                                            posScreenMin);
+  transformation.transformRawGraphToScreen (posGraphMax,
+                                            posScreenMax);
+
+  addLine (posScreenMin * m_screenScale,
+           posScreenMax * m_screenScale,
+           image,
+           segments);
+}
+
 QPointF GridRemoval::clipX (const QPointF &posUnprojected,
                             double xBoundary,
                             const QPointF &posOther) const
@@ -42,6 +71,11 @@ QPointF GridRemoval::clipY (const QPointF &posUnprojected,
                   (1.0 - s) * posUnprojected.y() + s * posOther.y());
 }
 
+bool GridRemoval::isCancelled () const
+{
+  return (m_cancelRequested != 0) && (m_cancelRequested->load () != 0);
+}
+
 QPixmap GridRemoval::remove (const Transformation &transformation,
                              const DocumentModelGridRemoval &modelGridRemoval,
                              const QImage &imageBefore)
@@ -56,8 +90,7 @@ QPixmap GridRemoval::remove (const Transformation &transformation,
   if (modelGridRemoval.removeDefinedGridLines() &&
       transformation.transformIsDefined()) {
 
-    GridHealer gridHealer (imageBefore,
-                           modelGridRemoval);
+    GridLineSegments segments;
 
     double yGraphMin = modelGridRemoval.startY();
     double yGraphMax = modelGridRemoval.stopY();
@@ -65,18 +98,13 @@ QPixmap GridRemoval::remove (const Transformation &transformation,
       double xGraph = modelGridRemoval.startX() + i * modelGridRemoval.stepX();
 
       // Convert line between graph coordinates (xGraph,yGraphMin) and (xGraph,yGraphMax) to screen coordinates
-      QPointF posScreenMin, posScreenMax;
-      transformation.transformRawGraphToScreen (QPointF (xGraph,
-                                                         yGraphMin),
-                                                posScreenMin);
-      transformation.transformRawGraphToScreen (QPointF (xGraph,
-                                                         yGraphMax),
-                                                posScreenMax);
-
-      removeLine (posScreenMin,
-                  posScreenMax,
-                  image,
-                  gridHealer);
+      addGraphLine (transformation,
+                    QPointF (xGraph,
+                             yGraphMin),
+                    QPointF (xGraph,
+                             yGraphMax),
+                    image,
+                    segments);
     }
 
     double xGraphMin = modelGridRemoval.startX();
@@ -85,31 +113,64 @@ QPixmap GridRemoval::remove (const Transformation &transformation,
       double yGraph = modelGridRemoval.startY() + j * modelGridRemoval.stepY();
 
       // Convert line between graph coordinates (xGraphMin,yGraph) and (xGraphMax,yGraph) to screen coordinates
-      QPointF posScreenMin, posScreenMax;
-      transformation.transformRawGraphToScreen (QPointF (xGraphMin,
-                                                         yGraph),
-                                                posScreenMin);
-      transformation.transformRawGraphToScreen (QPointF (xGraphMax,
-                                                         yGraph),
-                                                posScreenMax);
-
-      removeLine (posScreenMin,
-                  posScreenMax,
-                  image,
-                  gridHealer);
+      addGraphLine (transformation,
+                    QPointF (xGraphMin,
+                             yGraph),
+                    QPointF (xGraphMax,
+                             yGraph),
+                    image,
+                    segments);
+    }
+
+    // All lines are rasterized into one mask, rather than erasing pixel by pixel
+    QVector<bool> mask;
+    rasterizeSegments (segments,
+                       image.width(),
+                       image.height(),
+                       mask);
+    if (isCancelled ()) {
+      return QPixmap ();
     }
 
-    // Apply the healing process to the image
+    // Apply the mask in a single scanline pass. Direct scanline access requires 32 bit pixels
+    if (image.format () != QImage::Format_RGB32 &&
+        image.format () != QImage::Format_ARGB32) {
+      image = image.convertToFormat (QImage::Format_ARGB32);
+    }
+    QRgb rgbWhite = QColor (Qt::white).rgb();
+    const bool *maskRow = mask.constData();
+    for (int row = 0; row < image.height(); row++, maskRow += image.width()) {
+      QRgb *imageRow = reinterpret_cast<QRgb*> (image.scanLine (row));
+      for (int col = 0; col < image.width(); col++) {
+        if (maskRow [col]) {
+          imageRow [col] = rgbWhite;
+        }
+      }
+    }
+
+    // Apply the healing process to the image. The close distance is in pixels so it is scaled along with the image
+    DocumentModelGridRemoval modelGridRemovalScaled (modelGridRemoval);
+    modelGridRemovalScaled.setCloseDistance (modelGridRemoval.closeDistance() * m_screenScale);
+    GridHealer gridHealer (imageBefore,
+                           modelGridRemovalScaled,
+                           m_cancelRequested);
+    if (isCancelled ()) {
+      return QPixmap ();
+    }
+    gridHealer.erasePixels (mask);
     gridHealer.heal (image);
+    if (isCancelled ()) {
+      return QPixmap ();
+    }
   }
 
   return QPixmap::fromImage (image);
 }
 
-void GridRemoval::removeLine (const QPointF &posMin,
-                              const QPointF &posMax,
-                              QImage &image,
-                              GridHealer &gridHealer)
+void GridRemoval::addLine (const QPointF &posMin,
+                           const QPointF &posMax,
+                           const QImage &image,
+                           GridLineSegments &segments) const
 {
   double w = image.width() - 1; // Inclusive width = exclusive width - 1
   double h = image.height() - 1; // Inclusive height = exclusive height - 1
@@ -135,42 +196,39 @@ void GridRemoval::removeLine (const QPointF &posMin,
     if (pos1.y() > h) { pos1 = clipY (pos1, h, pos2); }
     if (pos2.y() > h) { pos2 = clipY (pos2, h, pos1); }
 
-    // Is line more horizontal or vertical?
-    double deltaX = qAbs (pos1.x() - pos2.x());
-    double deltaY = qAbs (pos1.y() - pos2.y());
-    if (deltaX > deltaY) {
-
-      // More horizontal
-      int xMin = qMin (pos1.x(), pos2.x());
-      int xMax = qMax (pos1.x(), pos2.x());
-      int yAtXMin = (pos1.x() < pos2.x() ? pos1.y() : pos2.y());
-      int yAtXMax = (pos1.x() < pos2.x() ? pos2.y() : pos1.y());
-      for (int x = xMin; x <= xMax; x++) {
-        double s = (double) (x - xMin) / (double) (xMax - xMin);
-        double yLine = (1.0 - s) * yAtXMin + s * yAtXMax;
-        for (int yOffset = -1; yOffset <= 1; yOffset++) {
-          int y = (int) (0.5 + yLine + yOffset);
-          image.setPixel (x, y, QColor(Qt::white).rgb());
-          gridHealer.erasePixel (x, y);
-        }
-      }
-    } else {
-
-      // More vertical
-      int yMin = qMin (pos1.y(), pos2.y());
-      int yMax = qMax (pos1.y(), pos2.y());
-      int xAtYMin = (pos1.y() < pos2.y() ? pos1.x() : pos2.x());
-      int xAtYMax = (pos1.y() < pos2.y() ? pos2.x() : pos1.x());
-      for (int y = yMin; y <= yMax; y++) {
-        double s = (double) (y - yMin) / (double) (yMax - yMin);
-        double xLine = (1.0 - s) * xAtYMin + s * xAtYMax;
-        for (int xOffset = -1; xOffset <= 1; xOffset++) {
-          int x = (int) (0.5 + xLine + xOffset);
-          image.setPixel (x, y, QColor(Qt::white).rgb());
-          gridHealer.erasePixel (x, y);
-        }
-      }
-    }
+    segments.append (QLineF (pos1,
+                             pos2));
   }
 }
 
+void GridRemoval::rasterizeSegments (const GridLineSegments &segments,
+                                     int width,
+                                     int height,
+                                     QVector<bool> &mask) const
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "GridRemoval::rasterizeSegments"
+                              << " segments=" << segments.count();
+
+  mask.fill (false,
+             width * height);
+
+  if (segments.count() > 0 && height > 0) {
+
+    // Each band gets a disjoint set of rows, so the bands can write into the mask without locking
+    int bandCount = qMax (1, qMin (QThread::idealThreadCount(), height));
+    int rowsPerBand = (height + bandCount - 1) / bandCount;
+    bool *maskData = mask.data(); // Detach here rather than in the worker threads
+
+    RunnableBatch batch;
+    for (int rowStart = 0; rowStart < height; rowStart += rowsPerBand) {
+
+      batch.start (new GridLineRasterizer (segments,
+                                           maskData,
+                                           width,
+                                           rowStart,
+                                           qMin (rowStart + rowsPerBand, height)));
+    }
+
+    batch.waitForDone ();
+  }
+}
@@ -7,11 +7,12 @@
 #ifndef GRID_REMOVAL_H
 #define GRID_REMOVAL_H
 
+#include "GridLineRasterizer.h"
+#include <QAtomicInt>
 #include <QPixmap>
 #include <QPointF>
 
 class DocumentModelGridRemoval;
-class GridHealer;
 class QImage;
 class Transformation;
 
@@ -19,9 +20,15 @@ class Transformation;
 class GridRemoval
 {
  public:
-  /// Single constructor
+  /// Default constructor for processing full resolution images in the calling thread
   GridRemoval();
 
+  /// Constructor for background processing, such as previews. Screen coordinates from the transformation are
+  /// multiplied by screenScale so a downsampled image can be processed. Processing is abandoned, and a null QPixmap
+  /// is returned, once cancelRequested becomes nonzero
+  GridRemoval (double screenScale,
+               const QAtomicInt &cancelRequested);
+
   /// Process QImage into QPixmap, removing the grid lines
   QPixmap remove (const Transformation &transformation,
                   const DocumentModelGridRemoval &modelGridRemoval,
@@ -29,6 +36,13 @@ class GridRemoval
 
 private:
 
+  /// Add line between two graph points, after conversion to (possibly scaled) screen coordinates
+  void addGraphLine (const Transformation &transformation,
+                     const QPointF &posGraphMin,
+                     const QPointF &posGraphMax,
+                     const QImage &image,
+                     GridLineSegments &segments) const;
+
   /// Clip line by projecting posUnprojected point onto x=xBoundary boundary. Line must pass over the boundary
   QPointF clipX (const QPointF &posUnprojected,
                  double xBoundary,
@@ -39,10 +53,23 @@ private:
                  double yBoundary,
                  const QPointF &posOther) const;
 
-  void removeLine (const QPointF &pos1,
-                   const QPointF &pos2,
-                   QImage &image,
-                   GridHealer &gridHealer);
+  /// Clip line to the image boundaries and append it to the segments. Lines entirely outside the image are skipped
+  void addLine (const QPointF &posMin,
+                const QPointF &posMax,
+                const QImage &image,
+                GridLineSegments &segments) const;
+
+  /// Rasterize all segments into the removal mask, with the rows split into bands that are processed in parallel
+  void rasterizeSegments (const GridLineSegments &segments,
+                          int width,
+                          int height,
+                          QVector<bool> &mask) const;
+
+  /// True if background processing has been superseded
+  bool isCancelled () const;
+
+  double m_screenScale;
+  const QAtomicInt *m_cancelRequested;
 };
 
 #endif // GRID_REMOVAL_H
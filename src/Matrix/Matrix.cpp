@@ -8,6 +8,9 @@
 #include "Matrix.h"
 #include <QTextStream>
 
+// Rows of the right hand matrix per block in operator*, chosen so a block of a few hundred columns stays in cache
+const int MULTIPLY_BLOCK_ROWS = 64;
+
 Matrix::Matrix (int N)
 {
   initialize (N, N);
@@ -19,28 +22,18 @@ Matrix::Matrix (int rows,
   initialize (rows, cols);
 }
 
-Matrix::Matrix (const Matrix &other)
+Matrix::Matrix (const Matrix &other) :
+  m_rows (other.rows ()),
+  m_cols (other.cols ()),
+  m_vector (other.m_vector)
 {
-  m_rows = other.rows();
-  m_cols = other.cols();
-  m_vector.resize (m_rows * m_cols);
-  for (int row = 0; row < m_rows; row++) {
-    for (int col = 0; col < m_cols; col++) {
-      set (row, col, other.get (row, col));
-    }
-  }
 }
 
 Matrix &Matrix::operator= (const Matrix &other)
 {
   m_rows = other.rows();
   m_cols = other.cols();
-  m_vector.resize (m_rows * m_cols);
-  for (int row = 0; row < m_rows; row++) {
-    for (int col = 0; col < m_cols; col++) {
-      set (row, col, other.get (row, col));
-    }
-  }
+  m_vector = other.m_vector;
 
   return *this;
 }
@@ -62,28 +55,97 @@ int Matrix::cols () const
   return m_cols;
 }
 
+bool Matrix::decomposeLU (QVector<double> &lu,
+                          QVector<int> &permutation,
+                          double &permutationSign) const
+{
+  ENGAUGE_ASSERT (m_rows == m_cols);
+
+  // Doolittle decomposition in place. Afterwards the strictly lower triangle holds L, whose diagonal is all ones,
+  // and the upper triangle holds U. Row i of lu is row permutation [i] of this matrix
+  int n = m_rows;
+  lu = m_vector;
+  permutation.resize (n);
+  for (int row = 0; row < n; row++) {
+    permutation [row] = row;
+  }
+  permutationSign = 1.0;
+
+  double *a = lu.data ();
+  for (int k = 0; k < n; k++) {
+
+    // Partial pivoting on the largest remaining entry in column k
+    int rowPivot = k;
+    double valuePivot = qAbs (a [k * n + k]);
+    for (int row = k + 1; row < n; row++) {
+      if (qAbs (a [row * n + k]) > valuePivot) {
+        rowPivot = row;
+        valuePivot = qAbs (a [row * n + k]);
+      }
+    }
+
+    if (valuePivot == 0) {
+      return false;
+    }
+
+    if (rowPivot != k) {
+      for (int col = 0; col < n; col++) {
+        qSwap (a [k * n + col], a [rowPivot * n + col]);
+      }
+      qSwap (permutation [k], permutation [rowPivot]);
+      permutationSign = -permutationSign;
+    }
+
+    // Eliminate below the pivot. The inner loop runs along contiguous rows
+    const double *rowK = a + k * n;
+    for (int row = k + 1; row < n; row++) {
+      double *rowI = a + row * n;
+      double factor = rowI [k] / rowK [k];
+      rowI [k] = factor;
+      for (int col = k + 1; col < n; col++) {
+        rowI [col] -= factor * rowK [col];
+      }
+    }
+  }
+
+  return true;
+}
+
 double Matrix::determinant () const
 {
   ENGAUGE_ASSERT (m_rows == m_cols);
 
-  double rtn;
+  const double *a = m_vector.constData ();
 
-  if (m_rows == 1) {
+  switch (m_rows) {
+    case 1:
+      return a [0];
 
-    rtn = m_vector [0];
+    case 2:
+      return a [0] * a [3] - a [1] * a [2];
 
-  } else {
+    case 3:
+      return a [0] * (a [4] * a [8] - a [5] * a [7]) -
+             a [1] * (a [3] * a [8] - a [5] * a [6]) +
+             a [2] * (a [3] * a [7] - a [4] * a [6]);
+
+    default:
+      break;
+  }
 
-    const int COL = 0; // We arbitrarily iterate through the first column
+  QVector<double> lu;
+  QVector<int> permutation;
+  double permutationSign;
+  if (!decomposeLU (lu,
+                    permutation,
+                    permutationSign)) {
+    return 0.0;
+  }
 
-    // This is a recursive algorithm
-    rtn = 0.0;
-    double multiplier = +1;
-    for (int row = 0; row < m_rows; row++) {
-      Matrix min = minorReduced (row, COL);
-      rtn += multiplier * get (row, COL) * min.determinant ();
-      multiplier *= -1.0;
-    }
+  // Product of the diagonal of U
+  double rtn = permutationSign;
+  for (int k = 0; k < m_rows; k++) {
+    rtn *= lu [k * m_cols + k];
   }
 
   return rtn;
@@ -329,14 +391,26 @@ Matrix Matrix::operator* (const Matrix &other) const
   ENGAUGE_ASSERT (m_cols == other.rows ());
 
   Matrix out (m_rows, other.cols ());
+  out.m_vector.fill (0.0); // Constructor makes square matrices the identity, but the sums below need zeros
 
-  for (int row = 0; row < m_rows; row++) {
-    for (int col = 0; col < other.cols (); col++) {
-      double sum = 0;
-      for (int index = 0; index < m_cols; index++) {
-        sum += get (row, index) * other.get (index, col);
+  int n = other.cols ();
+  const double *a = m_vector.constData ();
+  const double *b = other.m_vector.constData ();
+  double *c = out.m_vector.data ();
+
+  // Row i of the output accumulates a(i,k) times row k of other. Rows of other are visited in blocks so each block
+  // is reused from cache by every output row
+  for (int kStart = 0; kStart < m_cols; kStart += MULTIPLY_BLOCK_ROWS) {
+    int kEnd = qMin (kStart + MULTIPLY_BLOCK_ROWS, m_cols);
+    for (int row = 0; row < m_rows; row++) {
+      double *rowC = c + row * n;
+      for (int k = kStart; k < kEnd; k++) {
+        double factor = a [row * m_cols + k];
+        const double *rowB = b + k * n;
+        for (int col = 0; col < n; col++) {
+          rowC [col] += factor * rowB [col];
+        }
       }
-      out.set (row, col, sum);
     }
   }
 
@@ -349,10 +423,14 @@ QVector<double> Matrix::operator* (const QVector<double> other) const
 
   QVector<double> out;
   out.resize (m_rows);
+
+  const double *a = m_vector.constData ();
+  const double *v = other.constData ();
   for (int row = 0; row < m_rows; row++) {
+    const double *rowA = a + row * m_cols;
     double sum = 0;
     for (int col = 0; col < m_cols; col++) {
-      sum += get (row, col) * other [col];
+      sum += rowA [col] * v [col];
     }
 
     out [row] = sum;
@@ -371,6 +449,47 @@ void Matrix::set (int row, int col, double value)
   m_vector [fold2dIndexes (row, col)] = value;
 }
 
+bool Matrix::solve (const QVector<double> &b,
+                    QVector<double> &x) const
+{
+  ENGAUGE_ASSERT (m_rows == b.size ());
+
+  QVector<double> lu;
+  QVector<int> permutation;
+  double permutationSign;
+  if (!decomposeLU (lu,
+                    permutation,
+                    permutationSign)) {
+    return false;
+  }
+
+  int n = m_rows;
+  const double *a = lu.constData ();
+  QVector<double> y (n);
+
+  // Forward substitution with L, which has ones on the diagonal
+  for (int row = 0; row < n; row++) {
+    double sum = b [permutation [row]];
+    for (int col = 0; col < row; col++) {
+      sum -= a [row * n + col] * y [col];
+    }
+    y [row] = sum;
+  }
+
+  // Back substitution with U
+  for (int row = n - 1; row >= 0; row--) {
+    double sum = y [row];
+    for (int col = row + 1; col < n; col++) {
+      sum -= a [row * n + col] * y [col];
+    }
+    y [row] = sum / a [row * n + row];
+  }
+
+  x = y;
+
+  return true;
+}
+
 void Matrix::switchRows (int row1,
                          int row2)
 {
@@ -419,3 +538,32 @@ Matrix Matrix::transpose () const
 
   return out;
 }
+
+Matrix Matrix::transposeMultiply (const Matrix &other) const
+{
+  ENGAUGE_ASSERT (m_rows == other.rows ());
+
+  Matrix out (m_cols, other.cols ());
+  out.m_vector.fill (0.0); // Constructor makes square matrices the identity, but the sums below need zeros
+
+  int n = other.cols ();
+  const double *a = m_vector.constData ();
+  const double *b = other.m_vector.constData ();
+  double *c = out.m_vector.data ();
+
+  // Row k of this matrix and row k of other together contribute an outer product to the output, so every loop runs
+  // along contiguous rows
+  for (int k = 0; k < m_rows; k++) {
+    const double *rowA = a + k * m_cols;
+    const double *rowB = b + k * n;
+    for (int row = 0; row < m_cols; row++) {
+      double factor = rowA [row];
+      double *rowC = c + row * n;
+      for (int col = 0; col < n; col++) {
+        rowC [col] += factor * rowB [col];
+      }
+    }
+  }
+
+  return out;
+}
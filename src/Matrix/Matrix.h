@@ -29,7 +29,8 @@ public:
   /// Width of matrix
   int cols () const;
 
-  /// Return the determinant of this matrix
+  /// Return the determinant of this matrix. Small matrices use the closed form expansion, and larger matrices use
+  /// LU decomposition with partial pivoting so the cost is O(N^3) rather than O(N!)
   double determinant () const;
   
   /// Return (row, col) element
@@ -41,7 +42,7 @@ public:
   /// Return minor matrix which is the original with the specified row and column omitted. The name 'minor' is a reserved word
   Matrix minorReduced (int rowOmit, int colOmit) const;
   
-  /// Multiplication operator with a matrix
+  /// Multiplication operator with a matrix. Loops run along contiguous rows, in blocks that stay in cache
   Matrix operator* (const Matrix &other) const;
 
   /// Multiplication operator with a vector
@@ -53,11 +54,19 @@ public:
   /// Set (row, col) element
   void set (int row, int col, double value);
 
+  /// Return x in (this matrix) * x = b, computed by LU decomposition with partial pivoting. The matrix must be square.
+  /// Returns false, with x unchanged, if the matrix is singular
+  bool solve (const QVector<double> &b,
+              QVector<double> &x) const;
+
   /// Dump matrix to a string
   QString toString () const;
 
   /// Return the transpose of the current matrix
   Matrix transpose () const;
+
+  /// Return (transpose of this matrix) * other, without forming the transpose
+  Matrix transposeMultiply (const Matrix &other) const;
   
 private:
   Matrix();
@@ -65,6 +74,9 @@ private:
   void addRowToAnotherWithScaling (int rowFrom,
                                    int rowTo,
                                    double factor);
+  bool decomposeLU (QVector<double> &lu,
+                    QVector<int> &permutation,
+                    double &permutationSign) const; // Returns false if singular
   int fold2dIndexes (int row, int col) const;
   void initialize (int rows,
                    int cols);
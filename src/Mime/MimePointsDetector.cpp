@@ -5,10 +5,11 @@
  ******************************************************************************************************/
 
 #include "MimePointsDetector.h"
+#include "MimePointsParser.h"
 #include <QApplication>
 #include <QClipboard>
 #include <QSize>
-#include <QStringList>
+#include <QVector>
 #include "Transformation.h"
 
 MimePointsDetector::MimePointsDetector ()
@@ -38,63 +39,39 @@ bool MimePointsDetector::isMimePointsData (const Transformation &transformation,
   // 4) Skip lines that have other than 2 numbers
   // 5) Skip if numbers correspond to points outside of the X/Y coordinates since user will never be able to see them
 
-  const QString TAB_DELIMITER ("\t");
-
   if (!transformation.transformIsDefined()) {
     return false;
   }
 
   const QClipboard *clipboard = QApplication::clipboard();
-  QString text = clipboard->text ();
-  QStringList lines = text.split ("\n");
-  int i;
+  MimePointsParser parser (clipboard->text ());
 
   // Check for two lines
-  if (lines.count () < 2) {
+  if (parser.lineCount () < 2) {
     return false;
   }
 
   // Check for two columns
-  for (i = 0; i < lines.count(); i++) {
-
-    // Skip empty lines
-    QString line = lines.at (i);
-    if (!line.trimmed ().isEmpty ()) {
-
-      QStringList fields = line.split (TAB_DELIMITER);
-      if (fields.count () != 2) {
-        return false;
-      }
-    }
+  if (!parser.allLinesHaveTwoFields ()) {
+    return false;
   }
 
-  // Check for numbers outside of the legal range
-  for (i = 0; i < lines.count (); i++) {
-
-    // Skip empty lines
-    QString line = lines.at (i);
-    if (!line.trimmed ().isEmpty ()) {
-
-      QStringList fields = line.split (TAB_DELIMITER);
-      QString field0 = fields [0];
-      QString field1 = fields [1];
-      bool ok0, ok1;
-      double value0 = field0.toDouble (&ok0);
-      double value1 = field1.toDouble (&ok1);
-      if (ok0 && ok1) {
-
-        // This is a data point. Check against legal range
-        QPointF pointScreen;
-        transformation.transformRawGraphToScreen (QPointF (value0, value1),
-                                                  pointScreen);
-        if (pointScreen.x() < 0 ||
-            pointScreen.y() < 0 ||
-            pointScreen.x() > screenSize.width() ||
-            pointScreen.y() > screenSize.height ()) {
-
-          return false;
-        }
-      }
+  // Check for numbers outside of the legal range, with all data points transformed in one batch
+  int count = parser.xValues ().count ();
+  QVector<double> xScreen (count), yScreen (count);
+  transformation.transformRawGraphToScreen (count,
+                                            parser.xValues ().constData (),
+                                            parser.yValues ().constData (),
+                                            xScreen.data (),
+                                            yScreen.data ());
+
+  for (int i = 0; i < count; i++) {
+    if (xScreen [i] < 0 ||
+        yScreen [i] < 0 ||
+        xScreen [i] > screenSize.width() ||
+        yScreen [i] > screenSize.height ()) {
+
+      return false;
     }
   }
 
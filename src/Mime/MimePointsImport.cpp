@@ -5,8 +5,7 @@
  ******************************************************************************************************/
 
 #include "MimePointsImport.h"
-#include <QApplication>
-#include <QClipboard>
+#include <QVector>
 #include "Transformation.h"
 
 MimePointsImport::MimePointsImport ()
@@ -18,42 +17,29 @@ MimePointsImport::~MimePointsImport ()
 }
 
 void MimePointsImport::retrievePoints (const Transformation &transformation,
+                                       const QVector<double> &xValues,
+                                       const QVector<double> &yValues,
                                        QList<QPoint> &points,
                                        QList<double> &ordinals) const
 {
   // Sanity checking by MimePointsDetector::isMimePointsData has already been done
 
-  const QString TAB_DELIMITER ("\t");
+  // Transform all data points in one batch
+  int count = xValues.count ();
+  QVector<double> xScreen (count), yScreen (count);
+  transformation.transformRawGraphToScreen (count,
+                                            xValues.constData (),
+                                            yValues.constData (),
+                                            xScreen.data (),
+                                            yScreen.data ());
 
-  const QClipboard *clipboard = QApplication::clipboard();
-  QString text = clipboard->text ();
-  QStringList lines = text.split ("\n");
+  points.reserve (points.count () + count);
+  ordinals.reserve (ordinals.count () + count);
 
-  // Loop through lines
-  int ordinal = 0;
-  for (int i = 0; i < lines.count(); i++) {
+  for (int ordinal = 0; ordinal < count; ordinal++) {
 
-    QString line = lines.at (i);
-
-    // Skip empty lines
-    QStringList fields = line.split (TAB_DELIMITER);
-    if (!line.trimmed ().isEmpty () &&
-        fields.count () == 2) {
-
-      QString field0 = fields [0];
-      QString field1 = fields [1];
-      bool ok0, ok1;
-      double value0 = field0.toDouble (&ok0);
-      double value1 = field1.toDouble (&ok1);
-      if (ok0 && ok1) {
-
-        QPointF pointScreen;
-        transformation.transformRawGraphToScreen (QPointF (value0, value1),
-                                                  pointScreen);
-
-        points.push_back (pointScreen.toPoint ());
-        ordinals.push_back (ordinal++);
-      }
-    }
+    points.push_back (QPointF (xScreen [ordinal],
+                               yScreen [ordinal]).toPoint ());
+    ordinals.push_back (ordinal);
   }
 }
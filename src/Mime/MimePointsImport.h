@@ -9,6 +9,7 @@
 
 #include <QList>
 #include <QPoint>
+#include <QVector>
 
 class Transformation;
 
@@ -22,8 +23,10 @@ public:
   /// Destructor.
   virtual ~MimePointsImport ();
 
-  /// Retrieve points from clipboard
+  /// Retrieve points from the graph coordinates that MimePointsParser found in the clipboard text
   void retrievePoints (const Transformation &transformation,
+                       const QVector<double> &xValues,
+                       const QVector<double> &yValues,
                        QList<QPoint> &points,
                        QList<double> &ordinals) const;
 };
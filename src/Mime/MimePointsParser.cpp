@@ -0,0 +1,96 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "MimePointsParser.h"
+#include <QStringRef>
+
+const QChar LINE_DELIMITER ('\n');
+const QChar TAB_DELIMITER ('\t');
+
+MimePointsParser::MimePointsParser (const QString &text) :
+  m_allLinesHaveTwoFields (true),
+  m_lineCount (0)
+{
+  parse (text);
+}
+
+bool MimePointsParser::allLinesHaveTwoFields () const
+{
+  return m_allLinesHaveTwoFields;
+}
+
+int MimePointsParser::lineCount () const
+{
+  return m_lineCount;
+}
+
+void MimePointsParser::parse (const QString &text)
+{
+  const QChar *data = text.constData ();
+  const int length = text.length ();
+
+  // Each iteration handles the line starting at lineStart, which ends just before the next newline or the end of text
+  int lineStart = 0;
+  while (lineStart <= length) {
+
+    int lineEnd = text.indexOf (LINE_DELIMITER,
+                                lineStart);
+    if (lineEnd < 0) {
+      lineEnd = length;
+    }
+
+    ++m_lineCount;
+
+    // Count the tabs, and note the first one, while checking for an empty line
+    bool isEmpty = true;
+    int tabCount = 0, tabFirst = -1;
+    for (int i = lineStart; i < lineEnd; i++) {
+      if (data [i] == TAB_DELIMITER) {
+        if (tabCount++ == 0) {
+          tabFirst = i;
+        }
+      } else if (!data [i].isSpace ()) {
+        isEmpty = false;
+      }
+    }
+
+    // Skip empty lines
+    if (!isEmpty) {
+
+      if (tabCount == 1) {
+
+        QStringRef field0 = text.midRef (lineStart,
+                                         tabFirst - lineStart);
+        QStringRef field1 = text.midRef (tabFirst + 1,
+                                         lineEnd - tabFirst - 1);
+        bool ok0, ok1;
+        double value0 = field0.toDouble (&ok0);
+        double value1 = field1.toDouble (&ok1);
+        if (ok0 && ok1) {
+          m_xValues.push_back (value0);
+          m_yValues.push_back (value1);
+        }
+
+      } else {
+
+        m_allLinesHaveTwoFields = false;
+
+      }
+    }
+
+    lineStart = lineEnd + 1;
+  }
+}
+
+const QVector<double> &MimePointsParser::xValues () const
+{
+  return m_xValues;
+}
+
+const QVector<double> &MimePointsParser::yValues () const
+{
+  return m_yValues;
+}
@@ -0,0 +1,46 @@
+/******************************************************************************************************
+ * (C) 2014 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef MIME_POINTS_PARSER_H
+#define MIME_POINTS_PARSER_H
+
+#include <QString>
+#include <QVector>
+
+/// Single pass parser of clipboard text for MimePointsDetector and MimePointsImport. Lines are separated by newlines
+/// and fields by tabs. Each line with exactly two numeric fields is a data point. The text is scanned in place, and
+/// each field is converted through QStringRef, so no QString is allocated per line or per field. This keeps pasting
+/// of very large tables fast
+class MimePointsParser
+{
+public:
+  /// Single constructor, which parses the text
+  MimePointsParser (const QString &text);
+
+  /// True if every nonempty line has exactly two tab-delimited fields
+  bool allLinesHaveTwoFields () const;
+
+  /// Number of lines, including empty lines. Same as the count of QString::split with a newline separator
+  int lineCount () const;
+
+  /// X values of the data points, in the order they appear
+  const QVector<double> &xValues () const;
+
+  /// Y values of the data points, in the order they appear
+  const QVector<double> &yValues () const;
+
+private:
+  MimePointsParser ();
+
+  void parse (const QString &text);
+
+  bool m_allLinesHaveTwoFields;
+  int m_lineCount;
+  QVector<double> m_xValues;
+  QVector<double> m_yValues;
+};
+
+#endif // MIME_POINTS_PARSER_H
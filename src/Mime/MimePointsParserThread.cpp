@@ -0,0 +1,49 @@
+/******************************************************************************************************
+ * (C) 2017 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "MimePointsParser.h"
+#include "MimePointsParserThread.h"
+
+MimePointsParserThread::MimePointsParserThread ()
+{
+}
+
+void MimePointsParserThread::processRequest ()
+{
+  // MimePointsParser neither logs nor asserts, so it can run outside the GUI thread
+  for (int i = 0; i < m_textsTaken.count (); i++) {
+
+    MimePointsParser parser (m_textsTaken.at (i));
+
+    emit signalPointsParsed (m_curveNamesTaken.at (i),
+                             parser.xValues (),
+                             parser.yValues ());
+  }
+
+  // Release the text, which can be large, rather than holding it until the next paste
+  m_curveNamesTaken.clear ();
+  m_textsTaken.clear ();
+}
+
+void MimePointsParserThread::request (const QString &curveName,
+                                      const QString &text)
+{
+  beginRequest ();
+
+  m_curveNames << curveName;
+  m_texts << text;
+
+  endRequest ();
+}
+
+void MimePointsParserThread::takeRequest ()
+{
+  m_curveNamesTaken = m_curveNames;
+  m_textsTaken = m_texts;
+
+  m_curveNames.clear ();
+  m_texts.clear ();
+}
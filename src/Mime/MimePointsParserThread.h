@@ -0,0 +1,55 @@
+/******************************************************************************************************
+ * (C) 2017 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef MIME_POINTS_PARSER_THREAD_H
+#define MIME_POINTS_PARSER_THREAD_H
+
+#include "CoalescingThread.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/// Thread that runs MimePointsParser on pasted text, so the GUI thread is not blocked by very large tables. Unlike
+/// the other CoalescingThread subclasses, every request is kept, since each one is a separate paste. Requests that
+/// arrive while another is being parsed are parsed next, in the order they arrived
+class MimePointsParserThread : public CoalescingThread
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor
+  MimePointsParserThread ();
+
+  /// Queue the parsing of text that was pasted into the specified curve. The thread is started if it is not already
+  /// running
+  void request (const QString &curveName,
+                const QString &text);
+
+signals:
+  /// Send the graph coordinates of the data points of one request back to the GUI thread
+  void signalPointsParsed (QString curveName,
+                           QVector<double> xValues,
+                           QVector<double> yValues);
+
+protected:
+  /// Parse the requests taken by takeRequest
+  virtual void processRequest ();
+
+  /// Copy out every request queued since the last call
+  virtual void takeRequest ();
+
+private:
+
+  // Queued requests, guarded by the lock of CoalescingThread
+  QStringList m_curveNames;
+  QStringList m_texts;
+
+  // Requests being parsed, used only by this thread
+  QStringList m_curveNamesTaken;
+  QStringList m_textsTaken;
+};
+
+#endif // MIME_POINTS_PARSER_THREAD_H
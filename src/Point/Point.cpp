@@ -226,21 +226,23 @@ Point &Point::operator=(const Point &point)
 
 QString Point::curveNameFromPointIdentifier (const QString &pointIdentifier)
 {
-  QStringList tokens;
+  // This is called for every point touched by a command, so the curve name is extracted without splitting the
+  // whole identifier into a list of tokens
+  int pos = pointIdentifier.indexOf (POINT_IDENTIFIER_DELIMITER_SAFE);
 
-  if (pointIdentifier.contains (POINT_IDENTIFIER_DELIMITER_SAFE)) {
-
-    tokens = pointIdentifier.split (POINT_IDENTIFIER_DELIMITER_SAFE);
-
-  } else {
+  if (pos < 0) {
 
     // Yes, this is a hack - underscores could have been inserted by user (in the curve name) and/or this source code,
     // but there are many dig files laying around that have underscores so we need to support them
-    tokens = pointIdentifier.split (POINT_IDENTIFIER_DELIMITER_XML);
+    pos = pointIdentifier.indexOf (POINT_IDENTIFIER_DELIMITER_XML);
+
+  }
 
+  if (pos < 0) {
+    return pointIdentifier;
   }
 
-  return tokens.value (0);
+  return pointIdentifier.left (pos);
 }
 
 bool Point::hasOrdinal () const
@@ -46,6 +46,11 @@ bool PointIdentifiers::getValue (const QString &pointIdentifier) const
   return m_pointIdentifiers [pointIdentifier];
 }
 
+QStringList PointIdentifiers::keys () const
+{
+  return m_pointIdentifiers.keys ();
+}
+
 void PointIdentifiers::loadXml (QXmlStreamReader &reader)
 {
   bool success = true;
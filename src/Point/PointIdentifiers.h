@@ -9,6 +9,7 @@
 
 #include <QHash>
 #include <QString>
+#include <QStringList>
 
 class QXmlStreamReader;
 class QXmlStreamWriter;
@@ -35,6 +36,9 @@ public:
   /// Get value for key
   bool getValue (const QString &pointIdentifier) const;
 
+  /// All keys, copied once
+  QStringList keys () const;
+
   /// Load from serialized xml
   void loadXml (QXmlStreamReader &reader);
 
@@ -163,6 +163,117 @@ SplinePair Spline::findSplinePairForFunctionX (double x,
   return spCurrent;
 }
 
+SplinePair Spline::findSplinePairForFunctionXInInterval (unsigned int interval,
+                                                         double x,
+                                                         double tLow,
+                                                         double tHigh) const
+{
+  const int MAX_ITERATIONS = 64;
+  const double EPSILON_T = 1e-12; // Relative to the unit spacing of t values
+
+  const SplineCoeff &element = m_elements [interval];
+  double ti = element.t ();
+  double b = element.b ().x ();
+  double c = element.c ().x ();
+  double d = element.d ().x ();
+
+  // Since x is assumed to increase with t, values outside the bracket are ruled out as soon as they are evaluated
+  double tCurrent = (tLow + tHigh) / 2.0;
+  for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++) {
+
+    double error = element.eval (tCurrent).x () - x;
+    if (error > 0) {
+      tHigh = tCurrent;
+    } else if (error < 0) {
+      tLow = tCurrent;
+    } else {
+      break;
+    }
+
+    // Newton step, unless it leaves the bracket or the slope is zero, in which case bisection is used
+    double dt = tCurrent - ti;
+    double slope = b + dt * (2.0 * c + dt * 3.0 * d);
+    double tNext = (slope != 0.0 ? tCurrent - error / slope : tLow);
+    if (!(tLow < tNext && tNext < tHigh)) {
+      tNext = (tLow + tHigh) / 2.0;
+    }
+
+    bool converged = (qAbs (tNext - tCurrent) < EPSILON_T);
+    tCurrent = tNext;
+    if (converged) {
+      break;
+    }
+  }
+
+  return element.eval (tCurrent);
+}
+
+void Spline::findSplinePairsForFunctionX (const std::vector<double> &x,
+                                          std::vector<SplinePair> &splinePairs) const
+{
+  ENGAUGE_ASSERT (m_elements.size() != 0);
+
+  splinePairs.resize (x.size ());
+
+  unsigned int N = m_xy.size();
+  if (N < 2) {
+
+    // Only one point so there is nothing to solve for
+    for (unsigned int i = 0; i < x.size (); i++) {
+      splinePairs [i] = m_elements [0].eval (m_elements [0].t ());
+    }
+
+    return;
+  }
+
+  // Same extrapolation brackets as findSplinePairForFunctionX. Since the spline passes through the points, the x value
+  // at the start of each interval is the x value of the point at the start of that interval
+  double x0 = m_xy [0].x();
+  double x1 = m_xy [1].x();
+  double xNm2 = m_xy [N - 2].x();
+  double xNm1 = m_xy [N - 1].x();
+  unsigned int intervalLast = N - 2;
+
+  unsigned int interval = 0;
+  for (unsigned int i = 0; i < x.size (); i++) {
+
+    double xWanted = x [i];
+
+    if (xWanted < x0) {
+
+      double tStart = m_t [0] + (m_t [1] - m_t [0]) * (xWanted - x0) / (x1 - x0);
+      splinePairs [i] = findSplinePairForFunctionXInInterval (0,
+                                                              xWanted,
+                                                              m_t [0] + 2.0 * (tStart - m_t [0]),
+                                                              m_t [0]);
+
+    } else if (xNm1 < xWanted) {
+
+      double tStart = m_t [N - 1] + (m_t [N - 1] - m_t [N - 2]) * (xWanted - xNm1) / (xNm1 - xNm2);
+      splinePairs [i] = findSplinePairForFunctionXInInterval (intervalLast,
+                                                              xWanted,
+                                                              m_t [N - 1],
+                                                              m_t [N - 1] + 2.0 * (tStart - m_t [N - 1]));
+
+    } else {
+
+      // Restart the cursor if this x value is out of order, then advance it to the interval containing x
+      if (xWanted < m_xy [interval].x()) {
+        interval = 0;
+      }
+      while ((interval < intervalLast) &&
+             (m_xy [interval + 1].x() < xWanted)) {
+        ++interval;
+      }
+
+      splinePairs [i] = findSplinePairForFunctionXInInterval (interval,
+                                                              xWanted,
+                                                              m_t [interval],
+                                                              m_t [interval + 1]);
+    }
+  }
+}
+
 SplinePair Spline::interpolateCoeff (double t) const
 {
   ENGAUGE_ASSERT (m_elements.size() != 0);
@@ -176,6 +287,44 @@ SplinePair Spline::interpolateCoeff (double t) const
   return itr->eval(t);
 }
 
+void Spline::interpolateCoeffs (const std::vector<double> &t,
+                                std::vector<SplinePair> &splinePairs) const
+{
+  ENGAUGE_ASSERT (m_elements.size() != 0);
+
+  splinePairs.resize (t.size ());
+
+  // Cursor is the index that lower_bound would return in interpolateCoeff, so the same interval is selected
+  unsigned int cursor = 0;
+  for (unsigned int i = 0; i < t.size (); i++) {
+
+    if ((i > 0) &&
+        !(t [i] >= t [i - 1])) {
+      cursor = 0;
+    }
+    while ((cursor < m_elements.size ()) &&
+           (m_elements [cursor] < t [i])) {
+      ++cursor;
+    }
+
+    unsigned int interval = (cursor > 0 ? cursor - 1 : 0);
+    splinePairs [i] = m_elements [interval].eval (t [i]);
+  }
+}
+
+SplinePair Spline::interpolateDerivativeCoeff (double t) const
+{
+  ENGAUGE_ASSERT (m_elements.size() != 0);
+
+  vector<SplineCoeff>::const_iterator itr;
+  itr = lower_bound(m_elements.begin(), m_elements.end(), t);
+  if (itr != m_elements.begin()) {
+    itr--;
+  }
+
+  return itr->derivative(t);
+}
+
 SplinePair Spline::interpolateControlPoints (double t) const
 {
   ENGAUGE_ASSERT (m_xy.size() != 0);
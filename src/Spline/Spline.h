@@ -34,10 +34,26 @@ class Spline
   SplinePair findSplinePairForFunctionX (double x,
                                          int numIterations) const;
 
+  /// Batch version of findSplinePairForFunctionX, with one SplinePair output per x value. The interval containing
+  /// each x value is found by advancing a cursor, which is fastest when the x values are sorted in increasing order.
+  /// The t value is then solved for within that single interval using Newton iterations, with bisection as a fallback,
+  /// rather than bisection over the entire spline. This also assumes the curve is a function
+  void findSplinePairsForFunctionX (const std::vector<double> &x,
+                                    std::vector<SplinePair> &splinePairs) const;
+
   /// Return interpolated y for specified x. The appropriate interval is selected from the entire
   /// set of piecewise-defined intervals, then the corresponding a,b,c,d coefficients are applied
   SplinePair interpolateCoeff (double t) const;
 
+  /// Batch version of interpolateCoeff, with one SplinePair output per t value. The interval is found by advancing a
+  /// cursor, which is fastest when the t values are sorted in increasing order. Results are the same as interpolateCoeff
+  void interpolateCoeffs (const std::vector<double> &t,
+                          std::vector<SplinePair> &splinePairs) const;
+
+  /// Return the first derivative of the interpolated xy with respect to t, using the same interval selection as
+  /// interpolateCoeff. Since the spline has continuous first derivatives, the interval boundaries are not an issue
+  SplinePair interpolateDerivativeCoeff (double t) const;
+
   /// Return interpolated y for specified x, for testing. This uses the bezier points. If the t values
   /// are not separated by +1 consistently then this algorithm will probably need additional effort to work right
   SplinePair interpolateControlPoints (double t) const;
@@ -60,6 +76,12 @@ private:
                                         const std::vector<SplinePair> &xy);
   void computeControlPointsForIntervals ();
 
+  // Solve x(t)=x for t using the coefficients of the specified interval, starting from the bracket tLow to tHigh
+  SplinePair findSplinePairForFunctionXInInterval (unsigned int interval,
+                                                   double x,
+                                                   double tLow,
+                                                   double tHigh) const;
+
   // Coefficients a,b,c,d
   std::vector<SplineCoeff> m_elements;
 
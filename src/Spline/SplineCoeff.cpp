@@ -47,6 +47,12 @@ SplinePair SplineCoeff::d () const
   return m_d;
 }
 
+SplinePair SplineCoeff::derivative (double t) const
+{
+  double deltat = t - m_t;
+  return m_b + m_c * (2.0 * deltat) + m_d * (3.0 * deltat * deltat);
+}
+
 SplinePair SplineCoeff::eval(double t) const
 {
   double deltat = t - m_t;
@@ -42,6 +42,9 @@ public:
   /// Get method for d
   SplinePair d () const;
 
+  /// Evaluate the first derivative with respect to t using the b,c,d coefficients, over this interval
+  SplinePair derivative (double t) const;
+
   /// Evaluate the value using the a,b,c,d coefficients, over this interval
   SplinePair eval(double t) const;
 
@@ -1,4 +1,6 @@
 #include "Correlation.h"
+#include "CorrelationBorrow.h"
+#include "CorrelationPool.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include <qmath.h>
@@ -88,6 +90,126 @@ void TestCorrelation::loadThreeTriangles (double function [],
   }
 }
 
+void TestCorrelation::testPoolCleanupKeepsDirectInstances ()
+{
+  const int N = 1000;
+  const int INDEX_MAX = 200, INDEX_SHIFT = 50;
+
+  int binStartMaxBefore, binStartMaxAfter;
+  double function1 [N], function2 [N], correlations [N];
+  double corrMaxBefore, corrMaxAfter;
+
+  loadSinusoid (function1, N, INDEX_MAX);
+  loadSinusoid (function2, N, INDEX_MAX + INDEX_SHIFT);
+
+  // Instance created outside of the pool must keep its plans after the pool is cleaned up
+  Correlation correlation (N);
+  correlation.correlateWithShift (N,
+                                  function1,
+                                  function2,
+                                  binStartMaxBefore,
+                                  corrMaxBefore,
+                                  correlations);
+
+  {
+    CorrelationBorrow borrowed (N);
+    QVERIFY (borrowed->N () == N);
+  }
+
+  CorrelationPool::cleanup ();
+
+  correlation.correlateWithShift (N,
+                                  function1,
+                                  function2,
+                                  binStartMaxAfter,
+                                  corrMaxAfter,
+                                  correlations);
+
+  QVERIFY (binStartMaxAfter == binStartMaxBefore);
+  QVERIFY (corrMaxAfter == corrMaxBefore);
+}
+
+void TestCorrelation::testPoolReuse ()
+{
+  const int N = 1000;
+
+  // Two instances borrowed at the same time must be distinct so they can be used in separate threads
+  Correlation *correlation1 = CorrelationPool::borrow (N);
+  Correlation *correlation2 = CorrelationPool::borrow (N);
+  bool success = (correlation1 != correlation2);
+  success &= (correlation1->N () == N);
+  success &= (correlation2->N () == N);
+  CorrelationPool::giveBack (correlation1);
+  CorrelationPool::giveBack (correlation2);
+
+  // Instance given back is reused for the same size, but not for another size
+  Correlation *correlation3 = CorrelationPool::borrow (N);
+  success &= (correlation3 == correlation1 || correlation3 == correlation2);
+  Correlation *correlation4 = CorrelationPool::borrow (N + 1);
+  success &= (correlation4->N () == N + 1);
+  CorrelationPool::giveBack (correlation3);
+  CorrelationPool::giveBack (correlation4);
+
+  CorrelationPool::cleanup ();
+
+  QVERIFY (success);
+}
+
+void TestCorrelation::testShiftBatchMatchesSingle ()
+{
+  const int N = 1000;
+  const int INDEX_MAX = 200, COUNT = 5;
+  const double TOLERANCE = 0.000001;
+
+  double reference [N], candidates [COUNT] [N], correlationsBatch [COUNT] [N], correlationsSingle [N];
+  const double *candidatePointers [COUNT];
+  double *correlationPointers [COUNT];
+  int binStartMaxBatch [COUNT], binStartMaxSingle;
+  double corrMaxBatch [COUNT], corrMaxSingle;
+
+  Correlation correlation (N);
+
+  // Alternate between the two test functions, with increasing shifts
+  loadThreeTriangles (reference, N, INDEX_MAX);
+  for (int candidate = 0; candidate < COUNT; candidate++) {
+    if (candidate % 2 == 0) {
+      loadSinusoid (candidates [candidate], N, INDEX_MAX + 10 * candidate);
+    } else {
+      loadThreeTriangles (candidates [candidate], N, INDEX_MAX + 10 * candidate);
+    }
+    candidatePointers [candidate] = candidates [candidate];
+    correlationPointers [candidate] = correlationsBatch [candidate];
+  }
+
+  correlation.loadReference (N,
+                             reference);
+  correlation.correlateWithShiftBatch (N,
+                                       COUNT,
+                                       candidatePointers,
+                                       binStartMaxBatch,
+                                       corrMaxBatch,
+                                       correlationPointers);
+
+  bool success = true;
+  for (int candidate = 0; candidate < COUNT; candidate++) {
+
+    correlation.correlateWithShift (N,
+                                    reference,
+                                    candidates [candidate],
+                                    binStartMaxSingle,
+                                    corrMaxSingle,
+                                    correlationsSingle);
+
+    success &= (binStartMaxBatch [candidate] == binStartMaxSingle);
+    success &= (qAbs (corrMaxBatch [candidate] - corrMaxSingle) < TOLERANCE);
+    for (int i = 0; i < N; i++) {
+      success &= (qAbs (correlationsBatch [candidate] [i] - correlationsSingle [i]) < TOLERANCE);
+    }
+  }
+
+  QVERIFY (success);
+}
+
 void TestCorrelation::testShiftSinusoidNonPowerOf2 ()
 {
   const int N = 1000; // Non power of  2
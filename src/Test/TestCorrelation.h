@@ -23,6 +23,9 @@ private slots:
                            int n,
                            int center) const;
 
+  void testPoolCleanupKeepsDirectInstances ();
+  void testPoolReuse ();
+  void testShiftBatchMatchesSingle ();
   void testShiftSinusoidNonPowerOf2 ();
   void testShiftSinusoidPowerOf2 ();
   void testShiftThreeTrianglesNonPowerOf2 ();
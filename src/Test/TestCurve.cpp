@@ -0,0 +1,294 @@
+#include "ColorFilterSettings.h"
+#include "Curve.h"
+#include "CurveStyle.h"
+#include "LineStyle.h"
+#include "Logger.h"
+#include "MainWindow.h"
+#include "Point.h"
+#include "PointStyle.h"
+#include <QtTest/QtTest>
+#include "Test/TestCurve.h"
+#include "Transformation.h"
+
+QTEST_MAIN (TestCurve)
+
+const QString CURVE_NAME ("Curve1");
+
+TestCurve::TestCurve(QObject *parent) :
+  QObject(parent)
+{
+}
+
+void TestCurve::cleanupTestCase ()
+{
+}
+
+void TestCurve::initCurve (Curve &curve,
+                           const QList<QPointF> &positions,
+                           QStringList &identifiers) const
+{
+  for (int i = 0; i < positions.count (); i++) {
+    QString identifier = QString ("%1\tpoint\t%2")
+                         .arg (curve.curveName ())
+                         .arg (i);
+    curve.addPoint (Point (curve.curveName (),
+                           identifier,
+                           positions.at (i),
+                           i));
+    identifiers << identifier;
+  }
+}
+
+void TestCurve::initTestCase ()
+{
+  const QString NO_ERROR_REPORT_LOG_FILE;
+  const QString NO_REGRESSION_OPEN_FILE;
+  const bool NO_GNUPLOT_LOG_FILES = false;
+  const bool NO_REGRESSION_IMPORT = false;
+  const bool NO_RESET = false;
+  const bool DEBUG_FLAG = false;
+  const QStringList NO_LOAD_STARTUP_FILES;
+
+  initializeLogging ("engauge_test",
+                     "engauge_test.log",
+                     DEBUG_FLAG);
+
+  MainWindow w (NO_ERROR_REPORT_LOG_FILE,
+                NO_REGRESSION_OPEN_FILE,
+                NO_GNUPLOT_LOG_FILES,
+                NO_REGRESSION_IMPORT,
+                NO_RESET,
+                NO_LOAD_STARTUP_FILES);
+  w.show ();
+}
+
+bool TestCurve::lookupsMatch (const Curve &curve,
+                              const QStringList &identifiers,
+                              const QList<QPointF> &positions) const
+{
+  if (curve.numPoints () != identifiers.count ()) {
+    return false;
+  }
+
+  for (int i = 0; i < identifiers.count (); i++) {
+    if (curve.positionScreen (identifiers.at (i)) != positions.at (i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void TestCurve::testLookupAfterRemovePoint ()
+{
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               CurveStyle (LineStyle::defaultGraphCurve (0),
+                           PointStyle::defaultGraphCurve (0)));
+
+  QList<QPointF> positions;
+  positions << QPointF (10, 1) << QPointF (20, 2) << QPointF (30, 3) << QPointF (40, 4) << QPointF (50, 5);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+
+  curve.removePoint (identifiers.at (1));
+  QString identifierRemoved = identifiers.takeAt (1);
+  positions.removeAt (1);
+
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+  QCOMPARE (curve.positionScreen (identifierRemoved), QPointF ());
+
+  // Points after the removed point moved down by one, so an edit of the last point must not land on its old index
+  curve.movePoint (identifiers.last (),
+                   QPointF (0, 100));
+  positions.last () += QPointF (0, 100);
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+}
+
+void TestCurve::testLookupAfterRemovePoints ()
+{
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               CurveStyle (LineStyle::defaultGraphCurve (0),
+                           PointStyle::defaultGraphCurve (0)));
+
+  QList<QPointF> positions;
+  positions << QPointF (10, 1) << QPointF (20, 2) << QPointF (30, 3) << QPointF (40, 4) << QPointF (50, 5)
+            << QPointF (60, 6);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+
+  // First, a middle and the last point, plus an identifier from another curve that is ignored
+  QStringList identifiersRemoved;
+  identifiersRemoved << identifiers.at (0) << identifiers.at (3) << identifiers.at (5) << "Curve2\tpoint\t1";
+  curve.removePoints (identifiersRemoved);
+
+  identifiers.removeAt (5);
+  identifiers.removeAt (3);
+  identifiers.removeAt (0);
+  positions.removeAt (5);
+  positions.removeAt (3);
+  positions.removeAt (0);
+
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+  for (int i = 0; i < identifiersRemoved.count (); i++) {
+    QCOMPARE (curve.positionScreen (identifiersRemoved.at (i)), QPointF ());
+  }
+}
+
+void TestCurve::testLookupAfterReorder ()
+{
+  CurveStyle curveStyle (LineStyle::defaultGraphCurve (0),
+                         PointStyle::defaultGraphCurve (0));
+  curveStyle.setLineConnectAs (CONNECT_AS_FUNCTION_STRAIGHT);
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               curveStyle);
+
+  Transformation transformation;
+  transformation.identity ();
+
+  // Added out of x order, so updatePointOrdinals sorts them
+  QList<QPointF> positions;
+  positions << QPointF (30, 3) << QPointF (10, 1) << QPointF (50, 5) << QPointF (20, 2) << QPointF (40, 4);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+
+  curve.updatePointOrdinals (transformation);
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+  QCOMPARE (curve.points ().at (0).identifier (), identifiers.at (1));
+  QCOMPARE (curve.points ().at (4).identifier (), identifiers.at (2));
+
+  // Moving the first point past the last changes the order again
+  curve.movePoint (identifiers.at (1),
+                   QPointF (50, 0));
+  positions [1] += QPointF (50, 0);
+  curve.updatePointOrdinals (transformation);
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+  QCOMPARE (curve.points ().at (4).identifier (), identifiers.at (1));
+
+  // Edits after the sort must reach the point that moved, not whatever now has its old index
+  curve.movePoint (identifiers.at (3),
+                   QPointF (0, 7));
+  positions [3] += QPointF (0, 7);
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+}
+
+void TestCurve::testLookupAfterSetCurveName ()
+{
+  const QString CURVE_NAME_NEW ("Renamed");
+
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               CurveStyle (LineStyle::defaultGraphCurve (0),
+                           PointStyle::defaultGraphCurve (0)));
+
+  QList<QPointF> positions;
+  positions << QPointF (10, 1) << QPointF (20, 2) << QPointF (30, 3);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+
+  curve.setCurveName (CURVE_NAME_NEW);
+
+  // Old identifiers are gone and the renamed identifiers find the same points
+  QStringList identifiersNew;
+  for (int i = 0; i < identifiers.count (); i++) {
+    QCOMPARE (curve.positionScreen (identifiers.at (i)), QPointF ());
+    identifiersNew << CURVE_NAME_NEW + identifiers.at (i).mid (CURVE_NAME.length ());
+  }
+
+  QVERIFY (lookupsMatch (curve, identifiersNew, positions));
+
+  curve.removePoint (identifiersNew.at (0));
+  identifiersNew.removeAt (0);
+  positions.removeAt (0);
+  QVERIFY (lookupsMatch (curve, identifiersNew, positions));
+}
+
+void TestCurve::testOrdinalsAfterMidCurveInsert ()
+{
+  CurveStyle curveStyle (LineStyle::defaultGraphCurve (0),
+                         PointStyle::defaultGraphCurve (0));
+  curveStyle.setLineConnectAs (CONNECT_AS_FUNCTION_STRAIGHT);
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               curveStyle);
+
+  Transformation transformation;
+  transformation.identity ();
+
+  QList<QPointF> positions;
+  positions << QPointF (10, 1) << QPointF (20, 2) << QPointF (30, 3) << QPointF (40, 4);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+  curve.updatePointOrdinals (transformation);
+
+  // New point goes between the second and third points, but is added at the end of the curve
+  const QString IDENTIFIER_NEW = QString ("%1\tpoint\t%2")
+                                 .arg (CURVE_NAME)
+                                 .arg (positions.count ());
+  const QPointF POSITION_NEW (25, 9);
+  curve.addPoint (Point (CURVE_NAME,
+                         IDENTIFIER_NEW,
+                         POSITION_NEW,
+                         1.5));
+  curve.updatePointOrdinals (transformation);
+
+  // Points on either side keep their relative order, and the new point lands between them
+  QCOMPARE (curve.numPoints (), 5);
+  QCOMPARE (curve.points ().at (0).identifier (), identifiers.at (0));
+  QCOMPARE (curve.points ().at (1).identifier (), identifiers.at (1));
+  QCOMPARE (curve.points ().at (2).identifier (), IDENTIFIER_NEW);
+  QCOMPARE (curve.points ().at (3).identifier (), identifiers.at (2));
+  QCOMPARE (curve.points ().at (4).identifier (), identifiers.at (3));
+  for (int i = 0; i < curve.numPoints (); i++) {
+    QCOMPARE (curve.points ().at (i).ordinal (), (double) i);
+  }
+
+  identifiers.insert (2, IDENTIFIER_NEW);
+  positions.insert (2, POSITION_NEW);
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+}
+
+void TestCurve::testOrdinalsSortedInputSkipsSort ()
+{
+  CurveStyle curveStyle (LineStyle::defaultGraphCurve (0),
+                         PointStyle::defaultGraphCurve (0));
+  curveStyle.setLineConnectAs (CONNECT_AS_FUNCTION_STRAIGHT);
+  Curve curve (CURVE_NAME,
+               ColorFilterSettings::defaultFilter (),
+               curveStyle);
+
+  Transformation transformation;
+  transformation.identity ();
+
+  // Added in x order but with gaps in the ordinals, so only the ordinal values need to change
+  QList<QPointF> positions;
+  positions << QPointF (10, 1) << QPointF (20, 2) << QPointF (30, 3) << QPointF (40, 4) << QPointF (50, 5);
+  QStringList identifiers;
+  initCurve (curve,
+             positions,
+             identifiers);
+  curve.removePoint (identifiers.takeAt (1));
+  positions.removeAt (1);
+
+  QVERIFY (curve.pointsAreInOrdinalOrder ());
+  curve.updatePointOrdinals (transformation);
+  QVERIFY (curve.pointsAreInOrdinalOrder ());
+
+  for (int i = 0; i < curve.numPoints (); i++) {
+    QCOMPARE (curve.points ().at (i).identifier (), identifiers.at (i));
+    QCOMPARE (curve.points ().at (i).ordinal (), (double) i);
+  }
+  QVERIFY (lookupsMatch (curve, identifiers, positions));
+}
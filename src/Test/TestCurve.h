@@ -0,0 +1,55 @@
+#ifndef TEST_CURVE_H
+#define TEST_CURVE_H
+
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QStringList>
+
+class Curve;
+
+/// Unit test of Curve point bookkeeping
+class TestCurve : public QObject
+{
+  Q_OBJECT
+public:
+  /// Single constructor.
+  explicit TestCurve(QObject *parent = 0);
+
+signals:
+
+private slots:
+  void cleanupTestCase ();
+  void initTestCase ();
+
+  // Test identifier lookups after removing one point from the middle of the curve
+  void testLookupAfterRemovePoint ();
+
+  // Test identifier lookups after removing several points in one call
+  void testLookupAfterRemovePoints ();
+
+  // Test identifier lookups after sorting by new ordinals
+  void testLookupAfterReorder ();
+
+  // Test identifier lookups after the curve, and so every identifier, is renamed
+  void testLookupAfterSetCurveName ();
+
+  // Test that a function point inserted between two others takes the ordinal between theirs
+  void testOrdinalsAfterMidCurveInsert ();
+
+  // Test that points already in x order keep their order, without being sorted
+  void testOrdinalsSortedInputSkipsSort ();
+
+private:
+  // Curve with one point per position, with identifiers "<curveName>\tpoint\t<index>"
+  void initCurve (Curve &curve,
+                  const QList<QPointF> &positions,
+                  QStringList &identifiers) const;
+
+  // True if each identifier finds the point at the same index of positions
+  bool lookupsMatch (const Curve &curve,
+                     const QStringList &identifiers,
+                     const QList<QPointF> &positions) const;
+};
+
+#endif // TEST_CURVE_H
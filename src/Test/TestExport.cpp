@@ -1,15 +1,26 @@
 #include "CurveConnectAs.h"
 #include "Document.h"
 #include "DocumentModelExportFormat.h"
+#include "ExportColumns.h"
+#include "ExportFileBinary.h"
 #include "ExportFileFunctions.h"
+#include "ExportFileRelations.h"
+#include "ExportOrdinalsSmooth.h"
 #include "ExportValuesXOrY.h"
 #include "LineStyle.h"
 #include "Logger.h"
 #include "MainWindow.h"
 #include "MainWindowModel.h"
+#include "Points.h"
 #include "PointStyle.h"
+#include <QBuffer>
+#include <QDataStream>
 #include <QImage>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <qmath.h>
+#include <QRegExp>
 #include <QtTest/QtTest>
 #include "Spline.h"
 #include "SplinePair.h"
@@ -25,11 +36,161 @@ TestExport::TestExport(QObject *parent) :
 {
 }
 
+bool TestExport::binaryColumnsMatch (const QVector<QVector<double> > &expected,
+                                     const ExportColumns &columns) const
+{
+  const double EPSILON = 0.001; // Text has a limited number of significant digits
+
+  // Each binary format is written and then read back
+  ExportFileBinary exportBinary;
+  QByteArray bytesFloat64, bytesNpy, bytesNpz;
+  QBuffer bufferFloat64 (&bytesFloat64), bufferNpy (&bytesNpy), bufferNpz (&bytesNpz);
+  bufferFloat64.open (QIODevice::WriteOnly);
+  bufferNpy.open (QIODevice::WriteOnly);
+  bufferNpz.open (QIODevice::WriteOnly);
+  exportBinary.writeFloat64 (columns,
+                             bufferFloat64);
+  exportBinary.writeNpy (columns,
+                         bufferNpy);
+  bool success = exportBinary.writeNpz (columns,
+                                        bufferNpz);
+
+  success &= columnsMatch (expected, float64Columns (bytesFloat64), EPSILON);
+  success &= columnsMatch (expected, npyColumns (bytesNpy), EPSILON);
+  success &= columnsMatch (expected, npzColumns (bytesNpz), EPSILON);
+
+  return success;
+}
+
 void TestExport::cleanupTestCase ()
 {
 
 }
 
+bool TestExport::columnsMatch (const QVector<QVector<double> > &expected,
+                               const QVector<QVector<double> > &actual,
+                               double epsilon) const
+{
+  if (expected.count () != actual.count ()) {
+    return false;
+  }
+
+  for (int col = 0; col < expected.count (); col++) {
+    if (expected [col].count () != actual [col].count ()) {
+      return false;
+    }
+    for (int row = 0; row < expected [col].count (); row++) {
+      double tolerance = epsilon * qMax (1.0, qAbs (expected [col] [row]));
+      if (qAbs (expected [col] [row] - actual [col] [row]) > tolerance) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+QVector<QVector<double> > TestExport::csvColumns (const QString &csv,
+                                                  const QLocale &locale) const
+{
+  QVector<QVector<double> > columns;
+
+  QStringList lines = csv.split ("\n", QString::SkipEmptyParts);
+  for (int row = 0; row < lines.count (); row++) {
+    QStringList fields = lines.at (row).split ("\t");
+    columns.resize (qMax (columns.count (), fields.count ()));
+    for (int col = 0; col < fields.count (); col++) {
+      columns [col] << locale.toDouble (fields.at (col));
+    }
+  }
+
+  return columns;
+}
+
+QVector<QVector<double> > TestExport::float64Columns (const QByteArray &bytes) const
+{
+  QVector<QVector<double> > columns;
+
+  QDataStream str (bytes);
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  quint64 headerSize;
+  str >> headerSize;
+
+  const int HEADER_SIZE_SIZE = 8;
+  QJsonObject header = QJsonDocument::fromJson (bytes.mid (HEADER_SIZE_SIZE, (int) headerSize)).object ();
+  QJsonArray columnsJson = header ["columns"].toArray ();
+  for (int col = 0; col < columnsJson.count (); col++) {
+
+    QJsonObject columnJson = columnsJson.at (col).toObject ();
+    int rows = columnJson ["rows"].toInt ();
+    qint64 offset = (qint64) columnJson ["offset"].toDouble ();
+
+    QDataStream strColumn (bytes.mid ((int) (HEADER_SIZE_SIZE + headerSize + offset)));
+    strColumn.setByteOrder (QDataStream::LittleEndian);
+    strColumn.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+    QVector<double> values (rows);
+    for (int row = 0; row < rows; row++) {
+      strColumn >> values [row];
+    }
+    columns << values;
+  }
+
+  return columns;
+}
+
+void TestExport::initBinaryDocument (CurveConnectAs curveConnectAs,
+                                     Document &document,
+                                     DocumentModelExportFormat &modelExportOverride,
+                                     const MainWindowModel &modelMainWindow,
+                                     Transformation &transformation) const
+{
+  const QString CURVE_NAME ("Curve1");
+  const int LINE_WIDTH = 2, POINT_LINE_WIDTH = 1;
+  const ColorPalette LINE_COLOR = COLOR_PALETTE_BLACK, POINT_COLOR = COLOR_PALETTE_BLACK;
+  const int RADIUS = 5;
+
+  DocumentModelCoords modelCoords;
+  DocumentModelGeneral modelGeneral;
+
+  CurveStyles curveStyles (document.coordSystem ());
+  CurveStyle curveStyle (LineStyle (LINE_WIDTH,
+                                    LINE_COLOR,
+                                    curveConnectAs),
+                         PointStyle (POINT_SHAPE_CIRCLE,
+                                     RADIUS,
+                                     POINT_LINE_WIDTH,
+                                     POINT_COLOR));
+  curveStyles.setCurveStyle (CURVE_NAME, curveStyle);
+  modelCoords.setCoordScaleXTheta (COORD_SCALE_LINEAR);
+  modelCoords.setCoordScaleYRadius (COORD_SCALE_LINEAR);
+  modelCoords.setCoordsType (COORDS_TYPE_CARTESIAN);
+  modelGeneral.setCursorSize (3);
+  modelGeneral.setExtraPrecision (1);
+
+  document.setModelCurveStyles (curveStyles);
+  document.setModelCoords (modelCoords);
+  document.setModelGeneral (modelGeneral);
+
+  modelExportOverride.setDelimiter (EXPORT_DELIMITER_TAB);
+  modelExportOverride.setHeader (EXPORT_HEADER_NONE);
+  modelExportOverride.setLayoutFunctions (EXPORT_LAYOUT_ALL_PER_LINE);
+  modelExportOverride.setPointsSelectionFunctions (EXPORT_POINTS_SELECTION_FUNCTIONS_RAW);
+  modelExportOverride.setPointsSelectionRelations (EXPORT_POINTS_SELECTION_RELATIONS_RAW);
+  document.addPointGraphWithSpecifiedIdentifier (CURVE_NAME, QPointF (845, 305), "Curve1\t0", 0);
+  document.addPointGraphWithSpecifiedIdentifier (CURVE_NAME, QPointF (850, 294), "Curve1\t1", 1);
+  document.addPointGraphWithSpecifiedIdentifier (CURVE_NAME, QPointF (862, 272), "Curve1\t2", 2);
+  document.addPointGraphWithSpecifiedIdentifier (CURVE_NAME, QPointF (876, 244), "Curve1\t3", 3);
+  document.addPointGraphWithSpecifiedIdentifier (CURVE_NAME, QPointF (887, 222), "Curve1\t4", 4);
+
+  transformation.identity ();
+  transformation.setModelCoords (modelCoords,
+                                 modelGeneral,
+                                 modelMainWindow);
+}
+
 void TestExport::initTestCase ()
 {
   const QString NO_ERROR_REPORT_LOG_FILE;
@@ -53,6 +214,198 @@ void TestExport::initTestCase ()
   w.show ();
 }
 
+QVector<QVector<double> > TestExport::npyColumns (const QByteArray &bytes) const
+{
+  int rowCount;
+  QVector<double> values = npyValues (bytes,
+                                      rowCount);
+
+  // Values are in C order so each row is contiguous
+  int colCount = (rowCount > 0 ? values.count () / rowCount : 0);
+  QVector<QVector<double> > columns (colCount);
+  for (int row = 0; row < rowCount; row++) {
+    for (int col = 0; col < colCount; col++) {
+      columns [col] << values [row * colCount + col];
+    }
+  }
+
+  return columns;
+}
+
+QVector<double> TestExport::npyValues (const QByteArray &bytes,
+                                       int &rowCount) const
+{
+  const int PREAMBLE_SIZE = 10;
+
+  int headerSize = (uchar) bytes.at (8) + 256 * (uchar) bytes.at (9);
+  QString header = QString::fromLatin1 (bytes.mid (PREAMBLE_SIZE, headerSize));
+
+  QRegExp shape ("'shape': \\((\\d+)");
+  rowCount = (shape.indexIn (header) >= 0 ? shape.cap (1).toInt () : 0);
+
+  QDataStream str (bytes.mid (PREAMBLE_SIZE + headerSize));
+  str.setByteOrder (QDataStream::LittleEndian);
+  str.setFloatingPointPrecision (QDataStream::DoublePrecision);
+
+  QVector<double> values;
+  while (!str.atEnd ()) {
+    double value;
+    str >> value;
+    values << value;
+  }
+
+  return values;
+}
+
+QVector<QVector<double> > TestExport::npzColumns (const QByteArray &bytes) const
+{
+  const quint32 LOCAL_HEADER_SIGNATURE = 0x04034b50;
+
+  QVector<QVector<double> > columns;
+
+  // Entries are stored uncompressed, so each one is a local header followed by the npy bytes
+  QDataStream str (bytes);
+  str.setByteOrder (QDataStream::LittleEndian);
+
+  while (!str.atEnd ()) {
+
+    quint32 signature, crc, compressedSize, uncompressedSize;
+    quint16 version, flags, method, time, date, nameSize, extraSize;
+    str >> signature;
+    if (signature != LOCAL_HEADER_SIGNATURE) {
+      break; // Central directory
+    }
+    str >> version >> flags >> method >> time >> date >> crc >> compressedSize >> uncompressedSize >> nameSize >> extraSize;
+    str.skipRawData (nameSize + extraSize);
+
+    QByteArray data (compressedSize, 0);
+    str.readRawData (data.data (),
+                     compressedSize);
+
+    int rowCount;
+    columns << npyValues (data,
+                          rowCount);
+  }
+
+  return columns;
+}
+
+void TestExport::testBinaryMatchesCsvFunctions ()
+{
+  QImage nullImage;
+  Document document (nullImage);
+  DocumentModelExportFormat modelExportOverride;
+  MainWindowModel modelMainWindow;
+  Transformation transformation;
+
+  initBinaryDocument (CONNECT_AS_FUNCTION_STRAIGHT,
+                      document,
+                      modelExportOverride,
+                      modelMainWindow,
+                      transformation);
+
+  // Text export, which is the reference
+  QString csv;
+  QTextStream str (&csv);
+  ExportFileFunctions exportFile;
+  exportFile.exportToFile (modelExportOverride,
+                           document,
+                           modelMainWindow,
+                           transformation,
+                           str);
+  str.flush ();
+
+  QVector<QVector<double> > expected = csvColumns (csv,
+                                                   modelMainWindow.locale ());
+  QCOMPARE (expected.count (), 2);
+  QCOMPARE (expected [0].count (), 5);
+
+  // Binary exports of the same values
+  ExportColumns columns;
+  exportFile.exportToColumns (modelExportOverride,
+                              document,
+                              transformation,
+                              columns);
+
+  QVERIFY (binaryColumnsMatch (expected,
+                               columns));
+}
+
+void TestExport::testBinaryMatchesCsvRelations ()
+{
+  QImage nullImage;
+  Document document (nullImage);
+  DocumentModelExportFormat modelExportOverride;
+  MainWindowModel modelMainWindow;
+  Transformation transformation;
+
+  initBinaryDocument (CONNECT_AS_RELATION_STRAIGHT,
+                      document,
+                      modelExportOverride,
+                      modelMainWindow,
+                      transformation);
+
+  // Text export, which is the reference
+  QString csv;
+  QTextStream str (&csv);
+  ExportFileRelations exportFile;
+  exportFile.exportToFile (modelExportOverride,
+                           document,
+                           modelMainWindow,
+                           transformation,
+                           str);
+  str.flush ();
+
+  QVector<QVector<double> > expected = csvColumns (csv,
+                                                   modelMainWindow.locale ());
+  QCOMPARE (expected.count (), 2);
+  QCOMPARE (expected [0].count (), 5);
+
+  // Binary exports of the same values
+  ExportColumns columns;
+  exportFile.exportToColumns (modelExportOverride,
+                              document,
+                              transformation,
+                              columns);
+
+  QVERIFY (binaryColumnsMatch (expected,
+                               columns));
+}
+
+void TestExport::testLinearlyInterpolate ()
+{
+  const QString CURVE_NAME ("Curve1");
+  const double EPSILON = 1e-12;
+
+  Transformation transformation;
+  transformation.identity ();
+
+  Points points;
+  points << Point (CURVE_NAME, QPointF (0, 0), 0);
+  points << Point (CURVE_NAME, QPointF (1, 10), 1);
+  points << Point (CURVE_NAME, QPointF (2, 20), 2);
+  points << Point (CURVE_NAME, QPointF (4, 0), 3);
+
+  // Extrapolation before, interpolation including an exact hit, extrapolation after, and then an out of order value
+  ExportValuesXOrY xThetaValues;
+  xThetaValues << -1.0 << 0.5 << 1.0 << 3.0 << 6.0 << 1.5;
+
+  QVector<double> expected;
+  expected << -10.0 << 5.0 << 10.0 << 10.0 << -20.0 << 15.0;
+
+  ExportFileFunctions exportFile;
+  QVector<double> yRadiusValues;
+  exportFile.linearlyInterpolate (points,
+                                  xThetaValues,
+                                  transformation,
+                                  yRadiusValues);
+
+  QCOMPARE (yRadiusValues.count(), expected.count());
+  for (int row = 0; row < expected.count(); row++) {
+    QVERIFY (qAbs (yRadiusValues [row] - expected [row]) < EPSILON);
+  }
+}
+
 void TestExport::testLogExtrapolationFunctionsAll ()
 {
   const QString CURVE_NAME ("Curve1");
@@ -147,3 +500,101 @@ void TestExport::testLogExtrapolationFunctionsAll ()
 
   QVERIFY (success);
 }
+
+void TestExport::testOrdinalsSmoothArcLength ()
+{
+  const double EPSILON = 1e-9;
+  const double POINTS_INTERVAL = 2.5;
+
+  // Equally spaced collinear points give a straight spline with a speed of 5 per unit of t, so arc length is 5t
+  vector<double> t;
+  vector<SplinePair> xy;
+  for (int i = 0; i < 4; i++) {
+    t.push_back (i);
+    xy.push_back (SplinePair (3.0 * i, 4.0 * i));
+  }
+
+  ExportOrdinalsSmooth ordinalsSmooth;
+  Spline spline (t,
+                 xy);
+  vector<double> tTable, sTable;
+  ordinalsSmooth.loadArcLengthTable (spline,
+                                     t,
+                                     tTable,
+                                     sTable);
+
+  QVERIFY (qAbs (sTable.back () - 15.0) < EPSILON);
+  QVERIFY (qAbs (ordinalsSmooth.tAtArcLength (spline, tTable, sTable, 0.0)) < EPSILON);
+  QVERIFY (qAbs (ordinalsSmooth.tAtArcLength (spline, tTable, sTable, 1.0) - 0.2) < EPSILON);
+  QVERIFY (qAbs (ordinalsSmooth.tAtArcLength (spline, tTable, sTable, 7.5) - 1.5) < EPSILON);
+  QVERIFY (qAbs (ordinalsSmooth.tAtArcLength (spline, tTable, sTable, 13.0) - 2.6) < EPSILON);
+  QVERIFY (qAbs (ordinalsSmooth.tAtArcLength (spline, tTable, sTable, 15.0) - 3.0) < EPSILON);
+
+  // Last ordinal lands on the end of the curve, so the end is not added a second time
+  ExportValuesOrdinal ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (t,
+                                                                          xy,
+                                                                          POINTS_INTERVAL);
+  QCOMPARE (ordinals.count (), 6);
+  for (int i = 0; i < ordinals.count (); i++) {
+    QVERIFY (qAbs (ordinals.at (i) - 0.5 * (i + 1)) < EPSILON);
+  }
+}
+
+void TestExport::testOrdinalsSmoothEqualSpacing ()
+{
+  const double EPSILON = 1e-6;
+  const double POINTS_INTERVAL = 0.25;
+  const int NUM_CHORDS = 10000; // Chords per ordinal interval when measuring arc length independently
+
+  // Curve bends in both directions so the speed varies along it
+  vector<double> t;
+  vector<SplinePair> xy;
+  t.push_back (0);
+  t.push_back (1);
+  t.push_back (2);
+  t.push_back (3);
+  t.push_back (4);
+  xy.push_back (SplinePair (0, 0));
+  xy.push_back (SplinePair (1, 2));
+  xy.push_back (SplinePair (3, 3));
+  xy.push_back (SplinePair (6, 2));
+  xy.push_back (SplinePair (8, 0));
+
+  ExportOrdinalsSmooth ordinalsSmooth;
+  ExportValuesOrdinal ordinals = ordinalsSmooth.ordinalsAtIntervalsGraph (t,
+                                                                          xy,
+                                                                          POINTS_INTERVAL);
+
+  // Arc length between successive ordinals is measured by summing many short chords. The last ordinal is the end of
+  // the curve, which is closer than a full interval to the ordinal before it
+  Spline spline (t,
+                 xy);
+  bool success = true;
+  double tPrevious = t.front ();
+  double arcLengthLast = 0;
+  for (int i = 0; i < ordinals.count (); i++) {
+
+    double arcLength = 0;
+    SplinePair pairPrevious = spline.interpolateCoeff (tPrevious);
+    for (int chord = 1; chord <= NUM_CHORDS; chord++) {
+      SplinePair pair = spline.interpolateCoeff (tPrevious + (ordinals.at (i) - tPrevious) * chord / NUM_CHORDS);
+      double dx = pair.x () - pairPrevious.x ();
+      double dy = pair.y () - pairPrevious.y ();
+      arcLength += qSqrt (dx * dx + dy * dy);
+      pairPrevious = pair;
+    }
+
+    if ((i < ordinals.count () - 1) &&
+        (qAbs (arcLength - POINTS_INTERVAL) > EPSILON)) {
+      success = false;
+    }
+
+    arcLengthLast = arcLength;
+    tPrevious = ordinals.at (i);
+  }
+
+  QVERIFY (success);
+  QVERIFY (ordinals.count () > 2);
+  QCOMPARE (ordinals.last (), t.back ());
+  QVERIFY (arcLengthLast < POINTS_INTERVAL);
+}
@@ -1,7 +1,18 @@
 #ifndef TEST_EXPORT_H
 #define TEST_EXPORT_H
 
+#include "CurveConnectAs.h"
+#include <QByteArray>
+#include <QLocale>
 #include <QObject>
+#include <QString>
+#include <QVector>
+
+class Document;
+class DocumentModelExportFormat;
+class ExportColumns;
+class MainWindowModel;
+class Transformation;
 
 /// Unit test of Export classes
 class TestExport : public QObject
@@ -17,7 +28,31 @@ private slots:
   void cleanupTestCase ();
   void initTestCase ();
 
+  void testBinaryMatchesCsvFunctions ();
+  void testBinaryMatchesCsvRelations ();
+  void testLinearlyInterpolate ();
   void testLogExtrapolationFunctionsAll ();
+  void testOrdinalsSmoothArcLength ();
+  void testOrdinalsSmoothEqualSpacing ();
+
+private:
+  bool binaryColumnsMatch (const QVector<QVector<double> > &expected,
+                           const ExportColumns &columns) const;
+  bool columnsMatch (const QVector<QVector<double> > &expected,
+                     const QVector<QVector<double> > &actual,
+                     double epsilon) const;
+  QVector<QVector<double> > csvColumns (const QString &csv,
+                                        const QLocale &locale) const;
+  QVector<QVector<double> > float64Columns (const QByteArray &bytes) const;
+  void initBinaryDocument (CurveConnectAs curveConnectAs,
+                           Document &document,
+                           DocumentModelExportFormat &modelExportOverride,
+                           const MainWindowModel &modelMainWindow,
+                           Transformation &transformation) const;
+  QVector<QVector<double> > npyColumns (const QByteArray &bytes) const;
+  QVector<double> npyValues (const QByteArray &bytes,
+                             int &rowCount) const;
+  QVector<QVector<double> > npzColumns (const QByteArray &bytes) const;
 };
 
 #endif // TEST_EXPORT_H
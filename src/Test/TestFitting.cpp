@@ -1,3 +1,6 @@
+#include "FittingIncremental.h"
+#include "FittingLeastSquares.h"
+#include "FittingOrderSelection.h"
 #include "FittingStatistics.h"
 #include "Logger.h"
 #include "MainWindow.h"
@@ -107,6 +110,44 @@ bool TestFitting::generalTest (int order,
   return success;
 }
 
+bool TestFitting::incrementalMatchesRebuild (FittingIncremental &incremental,
+                                             const FittingPointsConvenient &points,
+                                             unsigned int order) const
+{
+  const double EPSILON = 0.000001;
+
+  if (incremental.numPoints () != points.count ()) {
+    return false;
+  }
+
+  FittingStatistics fitting;
+  double mse, rms, rSquared;
+  FittingCurveCoefficients coefficientsIncremental (MAX_POLYNOMIAL_ORDER + 1);
+  fitting.calculateCurveFitAndStatistics (order,
+                                          points,
+                                          incremental.leastSquares (),
+                                          coefficientsIncremental,
+                                          mse,
+                                          rms,
+                                          rSquared);
+
+  FittingCurveCoefficients coefficientsRebuild (MAX_POLYNOMIAL_ORDER + 1);
+  fitting.calculateCurveFitAndStatistics (order,
+                                          points,
+                                          coefficientsRebuild,
+                                          mse,
+                                          rms,
+                                          rSquared);
+
+  for (int coef = 0; coef <= MAX_POLYNOMIAL_ORDER; coef++) {
+    if (qAbs (coefficientsIncremental [coef] - coefficientsRebuild [coef]) > EPSILON) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void TestFitting::initTestCase ()
 {
   const QString NO_ERROR_REPORT_LOG_FILE;
@@ -150,6 +191,200 @@ void TestFitting::testExactFit34 ()
   QVERIFY (generalTest (3, 4));
 }
 
+void TestFitting::testIncrementalFewPoints ()
+{
+  const unsigned int ORDER = 2;
+
+  bool success = true;
+
+  QStringList identifiers;
+  FittingPointsConvenient points;
+  identifiers << "Curve1\tpoint\t0" << "Curve1\tpoint\t1" << "Curve1\tpoint\t2";
+  points << QPointF (0, 1) << QPointF (1, 3) << QPointF (2, 2);
+
+  FittingIncremental incremental;
+  incremental.rebuild (identifiers,
+                       points);
+
+  // Move
+  points [1].setY (4);
+  incremental.setPoint (identifiers.at (1),
+                        points.at (1));
+  success = success && incrementalMatchesRebuild (incremental, points, ORDER);
+
+  // Add
+  identifiers << "Curve1\tpoint\t3";
+  points << QPointF (3, 0);
+  incremental.setPoint (identifiers.at (3),
+                        points.at (3));
+  success = success && incrementalMatchesRebuild (incremental, points, ORDER);
+
+  // Remove, including a point that is not there
+  incremental.removePoint (identifiers.takeAt (0));
+  points.removeAt (0);
+  incremental.removePoint ("Curve2\tpoint\t0");
+  success = success && incrementalMatchesRebuild (incremental, points, ORDER);
+
+  QVERIFY (success);
+}
+
+void TestFitting::testIncrementalMatchesRebuild ()
+{
+  const int NUM_POINTS = 200;
+  const int NUM_CHANGES = 60;
+  const unsigned int ORDER = 3;
+
+  bool success = true;
+
+  // Noisy points around a cubic, with identifiers like those of Point
+  QStringList identifiers;
+  FittingPointsConvenient points;
+  for (int iPoint = 0; iPoint < NUM_POINTS; iPoint++) {
+    double x = iPoint / 10.0;
+    double noise = ((iPoint * 37) % 11 - 5) / 50.0;
+    identifiers << QString ("Curve1\tpoint\t%1").arg (iPoint);
+    points.append (QPointF (x, 1.0 + x - 0.2 * x * x + 0.01 * x * x * x + noise));
+  }
+
+  FittingIncremental incremental;
+  incremental.rebuild (identifiers,
+                       points);
+
+  // Move a point, remove a point or add a point, one command at a time, applying only the changed point
+  for (int change = 0; change < NUM_CHANGES; change++) {
+    int index = (change * 7) % points.count ();
+    switch (change % 3) {
+    case 0:
+      points [index].setY (points [index].y () + 0.5);
+      incremental.setPoint (identifiers.at (index),
+                            points.at (index));
+      break;
+
+    case 1:
+      incremental.removePoint (identifiers.at (index));
+      points.removeAt (index);
+      identifiers.removeAt (index);
+      break;
+
+    case 2:
+      points.append (QPointF (change / 5.0, 2.0 - change / 50.0));
+      identifiers << QString ("Curve1\tpoint\t%1").arg (NUM_POINTS + change);
+      incremental.setPoint (identifiers.last (),
+                            points.last ());
+      break;
+    }
+
+    success = success && incrementalMatchesRebuild (incremental, points, ORDER);
+  }
+
+  QVERIFY (success);
+}
+
+void TestFitting::testLargeXRange ()
+{
+  const double EPSILON = 0.001;
+  const int NUM_POINTS = 100;
+  const int ORDER = 2;
+  const double X_MAX = 1.0e7;
+
+  // Points on y = 3 + 2 * x. Column x^2 is about 1e14 times column 1, so comparing each diagonal entry of R against
+  // the largest one would drop the constant term
+  FittingPointsConvenient points;
+  for (int iPoint = 0; iPoint < NUM_POINTS; iPoint++) {
+    double x = X_MAX * iPoint / (NUM_POINTS - 1);
+    points.append (QPointF (x, 3.0 + 2.0 * x));
+  }
+
+  FittingStatistics fitting;
+  double mse, rms, rSquared;
+  FittingCurveCoefficients coefficientsGot (MAX_POLYNOMIAL_ORDER + 1);
+  fitting.calculateCurveFitAndStatistics (ORDER,
+                                          points,
+                                          coefficientsGot,
+                                          mse,
+                                          rms,
+                                          rSquared);
+
+  QVERIFY (qAbs (coefficientsGot [0] - 3.0) < EPSILON);
+  QVERIFY (qAbs (coefficientsGot [1] - 2.0) < EPSILON);
+}
+
+void TestFitting::testManyPointsOrder9 ()
+{
+  const double EPSILON = 0.000001;
+  const int NUM_POINTS = 20000;
+  const double COEFFICIENTS [] = {1, -2, 0.5, 3, -1, 0.25, 2, -0.5, 1.5, -3};
+
+  // Points on y = a0 + a1 * x + ... + a9 * x^9 with x from -1 to 1
+  FittingPointsConvenient points;
+  for (int iPoint = 0; iPoint < NUM_POINTS; iPoint++) {
+    double x = -1.0 + 2.0 * iPoint / (NUM_POINTS - 1);
+    double y = 0;
+    for (int ord = MAX_POLYNOMIAL_ORDER; ord >= 0; ord--) {
+      y = y * x + COEFFICIENTS [ord];
+    }
+
+    points.append (QPointF (x, y));
+  }
+
+  FittingStatistics fitting;
+  double mse, rms, rSquared;
+  FittingCurveCoefficients coefficientsGot (MAX_POLYNOMIAL_ORDER + 1);
+  fitting.calculateCurveFitAndStatistics (MAX_POLYNOMIAL_ORDER,
+                                          points,
+                                          coefficientsGot,
+                                          mse,
+                                          rms,
+                                          rSquared);
+
+  for (int coef = 0; coef <= MAX_POLYNOMIAL_ORDER; coef++) {
+    QVERIFY (qAbs (coefficientsGot [coef] - COEFFICIENTS [coef]) < EPSILON);
+  }
+  QVERIFY (rms < EPSILON);
+}
+
+void TestFitting::testOrderSelection ()
+{
+  const double EPSILON = 0.000001;
+  const int NUM_POINTS = 200;
+  const int ORDER_EXPECTED = 3;
+
+  // Small noise around a cubic, so higher orders reduce the error too little to pay for their coefficients
+  FittingPointsConvenient points;
+  FittingLeastSquares leastSquares (MAX_POLYNOMIAL_ORDER);
+  for (int iPoint = 0; iPoint < NUM_POINTS; iPoint++) {
+    double x = iPoint / 10.0;
+    double noise = ((iPoint * 37) % 11 - 5) / 50.0;
+    double y = 1.0 + x - 0.2 * x * x + 0.01 * x * x * x + noise;
+    points.append (QPointF (x, y));
+    leastSquares.addPoint (x, y);
+  }
+
+  FittingOrderSelection orderSelection (MAX_POLYNOMIAL_ORDER,
+                                        points,
+                                        leastSquares);
+
+  QVERIFY (orderSelection.orderMax () == MAX_POLYNOMIAL_ORDER);
+  QVERIFY (orderSelection.orderBest () == ORDER_EXPECTED);
+
+  // Each order matches the fit with that order chosen manually
+  FittingStatistics fitting;
+  for (int order = 0; order <= MAX_POLYNOMIAL_ORDER; order++) {
+
+    double mse, rms, rSquared;
+    FittingCurveCoefficients coefficients (MAX_POLYNOMIAL_ORDER + 1);
+    fitting.calculateCurveFitAndStatistics (order,
+                                            points,
+                                            coefficients,
+                                            mse,
+                                            rms,
+                                            rSquared);
+
+    QVERIFY (qAbs (orderSelection.mse (order) - mse) < EPSILON);
+    QVERIFY (qAbs (orderSelection.rSquared (order) - rSquared) < EPSILON);
+  }
+}
+
 void TestFitting::testOverfit11 ()
 {
   QVERIFY (generalTest (1, 1));
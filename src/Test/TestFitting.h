@@ -1,8 +1,11 @@
 #ifndef TEST_FITTING_H
 #define TEST_FITTING_H
 
+#include "FittingPointsConvenient.h"
 #include <QObject>
 
+class FittingIncremental;
+
 /// Unit test of Fitting classes
 class TestFitting : public QObject
 {
@@ -21,6 +24,21 @@ private slots:
   void testExactFit23 ();
   void testExactFit34 ();
 
+  // Test incremental changes with too few points for a downdate, so each removal falls back to a rebuild
+  void testIncrementalFewPoints ();
+
+  // Test that points added, removed and moved one command at a time give the same fit as a refit of all points
+  void testIncrementalMatchesRebuild ();
+
+  // Test that a large range of x values does not cause the lowest order coefficients to be dropped
+  void testLargeXRange ();
+
+  // Test highest order fit with enough points to fill many blocks
+  void testManyPointsOrder9 ();
+
+  // Test automatic order selection on noisy points around a cubic
+  void testOrderSelection ();
+
   // Test overfitted cases, for which the order is equal to, or greater than, the number of points
   void testOverfit11 ();
   void testOverfit22 ();
@@ -36,6 +54,9 @@ private slots:
  private:
   bool generalTest (int order,
                     int numPoints) const;
+  bool incrementalMatchesRebuild (FittingIncremental &incremental,
+                                  const FittingPointsConvenient &points,
+                                  unsigned int order) const;
 };
 
 #endif // TEST_FITTING_H
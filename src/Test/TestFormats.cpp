@@ -1,7 +1,9 @@
 #include "FormatDateTime.h"
 #include "FormatDegreesMinutesSecondsBase.h"
+#include "FormatDouble.h"
 #include "Logger.h"
 #include "MainWindow.h"
+#include <QLocale>
 #include <QtTest/QtTest>
 #include "Test/TestFormats.h"
 
@@ -12,6 +14,35 @@ TestFormats::TestFormats(QObject *parent) :
 {
 }
 
+#ifdef ENGAUGE_BENCHMARK
+void TestFormats::benchmarkDateTimeParse ()
+{
+  const int NUM_TIMESTAMPS = 100000;
+
+  // One second apart, starting at 2015/01/02 00:00:00
+  QDateTime start (QDate (2015, 1, 2),
+                   QTime (0, 0, 0));
+  QStringList timestamps;
+  for (int i = 0; i < NUM_TIMESTAMPS; i++) {
+    timestamps << start.addSecs (i).toString ("yyyy/MM/dd hh:mm:ss");
+  }
+
+  QBENCHMARK {
+    QStringList::const_iterator itr;
+    for (itr = timestamps.begin(); itr != timestamps.end(); itr++) {
+
+      // New instance per value, as in FormatCoordsUnitsStrategyNonPolarTheta
+      FormatDateTime format;
+      double value;
+      format.parseInput (COORD_UNITS_DATE_YEAR_MONTH_DAY,
+                         COORD_UNITS_TIME_HOUR_MINUTE_SECOND,
+                         *itr,
+                         value);
+    }
+  }
+}
+#endif
+
 void TestFormats::cleanupTestCase ()
 {
 }
@@ -39,6 +70,74 @@ void TestFormats::initTestCase ()
   w.show ();
 }
 
+bool TestFormats::formatDoubleMatchesQLocale (const QLocale &locale)
+{
+  const double VALUES [] = {1.0, -1.0, 0.5, 0.1, -0.000123456789, 1.5e-5, 12345.6789, 999999.5, 1e6, -2.5e21,
+                            3.14159265358979, 1.0 / 3.0, 100.0, 0.001, 9.9999e-5, 1e300};
+  const int NUM_VALUES = sizeof (VALUES) / sizeof (VALUES [0]);
+  const int MAX_PRECISION = 17;
+
+  bool success = true;
+  FormatDouble format (locale);
+
+  for (int i = 0; i < NUM_VALUES; i++) {
+    double value = VALUES [i];
+
+    for (int precision = 1; precision <= MAX_PRECISION; precision++) {
+      if (format.formatGeneral (value, precision) != locale.toString (value, 'g', precision) ||
+          format.formatScientific (value, precision) != locale.toString (value, 'e', precision) ||
+          format.formatFixed (value, precision) != locale.toString (value, 'f', precision)) {
+        success = false;
+      }
+    }
+  }
+
+  return success;
+}
+
+bool TestFormats::formatDoubleRoundTrips (const QLocale &locale)
+{
+  const double VALUES [] = {1.0, -1.0, 0.5, 0.1, -0.000123456789, 1.5e-5, 12345.6789, 999999.5, 1e6, -2.5e21,
+                            3.14159265358979, 1.0 / 3.0, 2.0 / 3.0, 100.0, 0.001, 9.9999e-5, 1e300};
+  const int NUM_VALUES = sizeof (VALUES) / sizeof (VALUES [0]);
+  const int ROUND_TRIP_PRECISION = 16; // Digits after the first in the 'e' format, for 17 significant digits
+
+  // Values with a few decimal places, which the 'f' format reproduces exactly with group separators where used
+  const double FIXED_VALUES [] = {12345.6789, -0.5, 1234567.25, 0.001, -98765432.125};
+  const int FIXED_DECIMALS [] = {4, 1, 2, 3, 3};
+  const int NUM_FIXED_VALUES = sizeof (FIXED_VALUES) / sizeof (FIXED_VALUES [0]);
+
+  bool success = true;
+  FormatDouble format (locale);
+
+  for (int i = 0; i < NUM_VALUES; i++) {
+    double value = VALUES [i];
+    bool okShortest, okScientific;
+
+    if (locale.toDouble (format.formatShortest (value), &okShortest) != value || !okShortest ||
+        locale.toDouble (format.formatScientific (value, ROUND_TRIP_PRECISION), &okScientific) != value || !okScientific) {
+      success = false;
+    }
+  }
+
+  // Shortest text has no more digits than needed, so 0.1 does not show its binary representation error
+  if (format.formatShortest (0.1) != locale.toString (0.1, 'g', 1) ||
+      format.formatShortest (1.0 / 3.0) != locale.toString (1.0 / 3.0, 'g', 16)) {
+    success = false;
+  }
+
+  for (int i = 0; i < NUM_FIXED_VALUES; i++) {
+    double value = FIXED_VALUES [i];
+    bool ok;
+
+    if (locale.toDouble (format.formatFixed (value, FIXED_DECIMALS [i]), &ok) != value || !ok) {
+      success = false;
+    }
+  }
+
+  return success;
+}
+
 bool TestFormats::stateDegreesMinutesSeconds (const QString &string, QValidator::State stateExpected)
 {
   FormatDegreesMinutesSecondsBase format;
@@ -174,6 +273,28 @@ void TestFormats::testDateTime2015Slash01Slash02Space01Colon02Colon03SpaceAM ()
   QVERIFY (stateYearMonthDayHourMinuteSecond ("2015/01/02 01:02:03 AM", QValidator::Acceptable));
 }
 
+void TestFormats::testDateTimeMixedFormats ()
+{
+  // Alternating formats exercise switching away from the most recent match
+  QStringList strings, formats;
+  strings << "2015/01/02 01:02:03" << "01 02 2015" << "01-02-2015 01:02 PM" << "2015/01/02 01:02:03" << "1/2/2015";
+  formats << "yyyy/MM/dd hh:mm:ss" << "MM dd yyyy" << "MM-dd-yyyy hh:mm A" << "yyyy/MM/dd hh:mm:ss" << "M/d/yyyy";
+
+  for (int i = 0; i < strings.count(); i++) {
+
+    FormatDateTime format;
+    double value;
+    QVERIFY (format.parseInput (COORD_UNITS_DATE_MONTH_DAY_YEAR,
+                                COORD_UNITS_TIME_HOUR_MINUTE_SECOND,
+                                strings [i],
+                                value) == QValidator::Acceptable);
+
+    QDateTime expected = QDateTime::fromString (strings [i],
+                                                formats [i]);
+    QCOMPARE (value, (double) expected.toTimeSpec (Qt::UTC).toTime_t ());
+  }
+}
+
 void TestFormats::testDegreesMinutesSeconds ()
 {
   QVERIFY (stateDegreesMinutesSeconds ("", QValidator::Intermediate));
@@ -203,3 +324,35 @@ void TestFormats::testDegreesMinutesSeconds180Space10Space20 ()
 {
   QVERIFY (stateDegreesMinutesSeconds ("180 10 20", QValidator::Acceptable));
 }
+
+void TestFormats::testFormatDoubleMatchesQLocale ()
+{
+  QLocale localeGerman (QLocale::German);
+  localeGerman.setNumberOptions (QLocale::OmitGroupSeparator);
+
+  // Group separators are inserted by QLocale itself
+  QLocale localeGermanGroups (QLocale::German);
+  localeGermanGroups.setNumberOptions (0);
+
+  QVERIFY (formatDoubleMatchesQLocale (QLocale::c ()));
+  QVERIFY (formatDoubleMatchesQLocale (localeGerman));
+  QVERIFY (formatDoubleMatchesQLocale (localeGermanGroups));
+}
+
+void TestFormats::testFormatDoubleRoundTrip ()
+{
+  QLocale localeGerman (QLocale::German);
+  localeGerman.setNumberOptions (QLocale::OmitGroupSeparator);
+
+  // Comma decimal point with period group separators, which toDouble must skip
+  QLocale localeGermanGroups (QLocale::German);
+  localeGermanGroups.setNumberOptions (0);
+
+  QLocale localeEnglishGroups (QLocale::English, QLocale::UnitedStates);
+  localeEnglishGroups.setNumberOptions (0);
+
+  QVERIFY (formatDoubleRoundTrips (QLocale::c ()));
+  QVERIFY (formatDoubleRoundTrips (localeGerman));
+  QVERIFY (formatDoubleRoundTrips (localeGermanGroups));
+  QVERIFY (formatDoubleRoundTrips (localeEnglishGroups));
+}
@@ -18,6 +18,9 @@ class TestFormats : public QObject
   void cleanupTestCase ();
   void initTestCase ();
 
+#ifdef ENGAUGE_BENCHMARK
+  void benchmarkDateTimeParse ();
+#endif
   void testDateTime ();
   void testDateTime2 ();
   void testDateTime20 ();
@@ -41,14 +44,19 @@ class TestFormats : public QObject
   void testDateTime2015Slash01Slash02Space01Colon02Colon03Space ();
   void testDateTime2015Slash01Slash02Space01Colon02Colon03SpaceA ();
   void testDateTime2015Slash01Slash02Space01Colon02Colon03SpaceAM ();
+  void testDateTimeMixedFormats ();
   void testDegreesMinutesSeconds ();
   void testDegreesMinutesSeconds180 ();
   void testDegreesMinutesSeconds180Space ();
   void testDegreesMinutesSeconds180Space10 ();
   void testDegreesMinutesSeconds180Space10Space ();
   void testDegreesMinutesSeconds180Space10Space20 ();
+  void testFormatDoubleMatchesQLocale ();
+  void testFormatDoubleRoundTrip ();
 
  private:
+  bool formatDoubleMatchesQLocale (const QLocale &locale);
+  bool formatDoubleRoundTrips (const QLocale &locale);
   bool stateDegreesMinutesSeconds (const QString &string, QValidator::State stateExpected);
   bool stateYearMonthDayHourMinuteSecond (const QString &string, QValidator::State stateExpected);
 
@@ -0,0 +1,291 @@
+#include "DocumentModelCoords.h"
+#include "DocumentModelGeneral.h"
+#include "GeometryCache.h"
+#include "GeometryPrefixSums.h"
+#include "GeometryStrategyContext.h"
+#include "Logger.h"
+#include "MainWindow.h"
+#include "MainWindowModel.h"
+#include <qmath.h>
+#include "Points.h"
+#include <QtTest/QtTest>
+#include "Test/TestGeometry.h"
+#include "Transformation.h"
+
+QTEST_MAIN (TestGeometry)
+
+const QString CURVE_NAME ("Curve1");
+const double EPSILON = 1e-9;
+
+TestGeometry::TestGeometry(QObject *parent) :
+  QObject(parent)
+{
+}
+
+void TestGeometry::cacheInsert (GeometryCache &cache,
+                                Points &points) const
+{
+  points.clear ();
+  points << Point (CURVE_NAME, QPointF (1, 1), 0)
+         << Point (CURVE_NAME, QPointF (2, 3), 1)
+         << Point (CURVE_NAME, QPointF (4, 3), 2);
+
+  GeometryResult result;
+  result.curveName = CURVE_NAME;
+  result.settingsKey = settingsKey (CONNECT_AS_FUNCTION_STRAIGHT,
+                                    DocumentModelGeneral ());
+  result.points = points;
+  result.funcArea = "8";
+
+  cache.insert (result);
+}
+
+void TestGeometry::calculateGeometry (CurveConnectAs connectAs,
+                                      const QVector<QPointF> &positions,
+                                      QString &funcArea,
+                                      QString &polyArea,
+                                      GeometryPrefixSums &prefixSums) const
+{
+  // Identity transformation so screen and graph coordinates are the same
+  Transformation transformation;
+  transformation.identity ();
+
+  Points points;
+  for (int i = 0; i < positions.count (); i++) {
+    points << Point (CURVE_NAME,
+                     positions.at (i),
+                     i);
+  }
+
+  DocumentModelCoords modelCoords;
+  DocumentModelGeneral modelGeneral;
+  MainWindowModel modelMainWindow;
+  QVector<QString> x, y, distanceGraphForward, distancePercentForward, distanceGraphBackward, distancePercentBackward;
+
+  GeometryStrategyContext context;
+  context.calculateGeometry (points,
+                             modelCoords,
+                             modelGeneral,
+                             modelMainWindow,
+                             transformation,
+                             connectAs,
+                             funcArea,
+                             polyArea,
+                             x,
+                             y,
+                             distanceGraphForward,
+                             distancePercentForward,
+                             distanceGraphBackward,
+                             distancePercentBackward,
+                             prefixSums);
+}
+
+void TestGeometry::cleanupTestCase ()
+{
+}
+
+void TestGeometry::initTestCase ()
+{
+  const QString NO_ERROR_REPORT_LOG_FILE;
+  const QString NO_REGRESSION_OPEN_FILE;
+  const bool NO_GNUPLOT_LOG_FILES = false;
+  const bool NO_REGRESSION_IMPORT = false;
+  const bool NO_RESET = false;
+  const bool DEBUG_FLAG = false;
+  const QStringList NO_LOAD_STARTUP_FILES;
+
+  initializeLogging ("engauge_test",
+                     "engauge_test.log",
+                     DEBUG_FLAG);
+
+  MainWindow w (NO_ERROR_REPORT_LOG_FILE,
+                NO_REGRESSION_OPEN_FILE,
+                NO_GNUPLOT_LOG_FILES,
+                NO_REGRESSION_IMPORT,
+                NO_RESET,
+                NO_LOAD_STARTUP_FILES);
+  w.show ();
+}
+
+QString TestGeometry::settingsKey (CurveConnectAs connectAs,
+                                   const DocumentModelGeneral &modelGeneral) const
+{
+  Transformation transformation;
+  transformation.identity ();
+
+  return GeometryCache::settingsKey (DocumentModelCoords (),
+                                     modelGeneral,
+                                     MainWindowModel (),
+                                     transformation,
+                                     connectAs);
+}
+
+void TestGeometry::testCacheHit ()
+{
+  GeometryCache cache;
+  Points points;
+  cacheInsert (cache,
+               points);
+
+  // Copy of the points, as a later command would see them
+  Points pointsAgain = points;
+
+  GeometryResult result;
+  QVERIFY (cache.lookup (CURVE_NAME,
+                         settingsKey (CONNECT_AS_FUNCTION_STRAIGHT,
+                                      DocumentModelGeneral ()),
+                         pointsAgain,
+                         result));
+  QVERIFY (result.funcArea == "8");
+}
+
+void TestGeometry::testCacheMissAfterClear ()
+{
+  GeometryCache cache;
+  Points points;
+  cacheInsert (cache,
+               points);
+
+  cache.clear ();
+
+  GeometryResult result;
+  QVERIFY (!cache.lookup (CURVE_NAME,
+                          settingsKey (CONNECT_AS_FUNCTION_STRAIGHT,
+                                       DocumentModelGeneral ()),
+                          points,
+                          result));
+}
+
+void TestGeometry::testCacheMissAfterSettingsChange ()
+{
+  GeometryCache cache;
+  Points points;
+  cacheInsert (cache,
+               points);
+
+  GeometryResult result;
+
+  // Different strategy
+  QVERIFY (!cache.lookup (CURVE_NAME,
+                          settingsKey (CONNECT_AS_FUNCTION_SMOOTH,
+                                       DocumentModelGeneral ()),
+                          points,
+                          result));
+
+  // Different formatting of the x and y columns
+  DocumentModelGeneral modelGeneral;
+  modelGeneral.setExtraPrecision (modelGeneral.extraPrecision () + 1);
+  QVERIFY (!cache.lookup (CURVE_NAME,
+                          settingsKey (CONNECT_AS_FUNCTION_STRAIGHT,
+                                       modelGeneral),
+                          points,
+                          result));
+
+  // Original settings still hit, so the misses above came from the settings alone
+  QVERIFY (cache.lookup (CURVE_NAME,
+                         settingsKey (CONNECT_AS_FUNCTION_STRAIGHT,
+                                      DocumentModelGeneral ()),
+                         points,
+                         result));
+}
+
+void TestGeometry::testFunctionStraightRanges ()
+{
+  QVector<QPointF> positions;
+  positions << QPointF (1, 1) << QPointF (2, 3) << QPointF (4, 3) << QPointF (5, 1);
+
+  QString funcArea, polyArea;
+  GeometryPrefixSums prefixSums;
+  calculateGeometry (CONNECT_AS_FUNCTION_STRAIGHT,
+                     positions,
+                     funcArea,
+                     polyArea,
+                     prefixSums);
+
+  QVERIFY (prefixSums.count () == 4);
+
+  // Distance is the same in either direction
+  QVERIFY (qAbs (prefixSums.distance (1, 3) - (2.0 + qSqrt (5.0))) < EPSILON);
+  QVERIFY (qAbs (prefixSums.distance (3, 1) - (2.0 + qSqrt (5.0))) < EPSILON);
+  QVERIFY (qAbs (prefixSums.distance (2, 2)) < EPSILON);
+
+  // Trapezoids of 2, 6 and 2, with the sign following the direction
+  QVERIFY (qAbs (prefixSums.functionArea (1, 2) - 6.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.functionArea (0, 2) - 8.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.functionArea (2, 1) + 6.0) < EPSILON);
+
+  // Triangles (1,1) (2,3) (4,3) and (2,3) (4,3) (5,1)
+  QVERIFY (qAbs (prefixSums.polygonArea (0, 2) - 2.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.polygonArea (1, 3) - 2.0) < EPSILON);
+}
+
+void TestGeometry::testFunctionStraightTotals ()
+{
+  // First point is away from the origin, so an area that starts from the origin would be off
+  QVector<QPointF> positions;
+  positions << QPointF (1, 1) << QPointF (2, 3) << QPointF (4, 3) << QPointF (5, 1);
+
+  QString funcArea, polyArea;
+  GeometryPrefixSums prefixSums;
+  calculateGeometry (CONNECT_AS_FUNCTION_STRAIGHT,
+                     positions,
+                     funcArea,
+                     polyArea,
+                     prefixSums);
+
+  // Trapezoidal rule gives 0.5 * (1 + 3) * 1 + 3 * 2 + 0.5 * (3 + 1) * 1
+  QVERIFY (qAbs (funcArea.toDouble () - 10.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.functionAreaTotal () - 10.0) < EPSILON);
+  QVERIFY (polyArea.isEmpty ());
+
+  QVERIFY (qAbs (prefixSums.distanceTotal () - (2.0 + 2.0 * qSqrt (5.0))) < EPSILON);
+
+  // Shoelace terms 1, -6, -11 and 4 for the closing edge sum to -12
+  QVERIFY (qAbs (prefixSums.polygonAreaTotal () - 6.0) < EPSILON);
+}
+
+void TestGeometry::testRelationStraightRanges ()
+{
+  QVector<QPointF> positions;
+  positions << QPointF (0, 0) << QPointF (2, 0) << QPointF (2, 2) << QPointF (0, 2);
+
+  QString funcArea, polyArea;
+  GeometryPrefixSums prefixSums;
+  calculateGeometry (CONNECT_AS_RELATION_STRAIGHT,
+                     positions,
+                     funcArea,
+                     polyArea,
+                     prefixSums);
+
+  QVERIFY (prefixSums.count () == 4);
+
+  QVERIFY (qAbs (prefixSums.distance (0, 2) - 4.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.distance (1, 3) - 4.0) < EPSILON);
+
+  // Half of the square on either side of a diagonal
+  QVERIFY (qAbs (prefixSums.polygonArea (0, 2) - 2.0) < EPSILON);
+  QVERIFY (qAbs (prefixSums.polygonArea (1, 3) - 2.0) < EPSILON);
+
+  // Two points enclose nothing
+  QVERIFY (qAbs (prefixSums.polygonArea (1, 2)) < EPSILON);
+}
+
+void TestGeometry::testRelationStraightTotals ()
+{
+  QVector<QPointF> positions;
+  positions << QPointF (0, 0) << QPointF (2, 0) << QPointF (2, 2) << QPointF (0, 2);
+
+  QString funcArea, polyArea;
+  GeometryPrefixSums prefixSums;
+  calculateGeometry (CONNECT_AS_RELATION_STRAIGHT,
+                     positions,
+                     funcArea,
+                     polyArea,
+                     prefixSums);
+
+  QVERIFY (funcArea.isEmpty ());
+  QVERIFY (qAbs (polyArea.toDouble () - 4.0) < EPSILON);
+
+  // Closing edge from the last point back to the first is not part of the distance
+  QVERIFY (qAbs (prefixSums.distanceTotal () - 6.0) < EPSILON);
+}
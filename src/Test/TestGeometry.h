@@ -0,0 +1,62 @@
+#ifndef TEST_GEOMETRY_H
+#define TEST_GEOMETRY_H
+
+#include "CurveConnectAs.h"
+#include "Points.h"
+#include <QObject>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+
+class DocumentModelGeneral;
+class GeometryCache;
+class GeometryPrefixSums;
+
+/// Unit test of geometry calculations
+class TestGeometry : public QObject
+{
+  Q_OBJECT
+public:
+  /// Single constructor.
+  explicit TestGeometry(QObject *parent = 0);
+
+signals:
+
+private slots:
+  void cleanupTestCase ();
+  void initTestCase ();
+
+  // Test that an unchanged curve is found in the cache
+  void testCacheHit ();
+
+  // Test that the cache is missed after clearing
+  void testCacheMissAfterClear ();
+
+  // Test that the cache is missed after a change to a setting that goes into the calculation
+  void testCacheMissAfterSettingsChange ();
+
+  // Test distance and area between pairs of points of a straight function
+  void testFunctionStraightRanges ();
+
+  // Test header totals of a straight function that does not start at the origin
+  void testFunctionStraightTotals ();
+
+  // Test distance and area between pairs of points of a straight relation
+  void testRelationStraightRanges ();
+
+  // Test header totals of a straight relation that goes around a square
+  void testRelationStraightTotals ();
+
+private:
+  void cacheInsert (GeometryCache &cache,
+                    Points &points) const;
+  void calculateGeometry (CurveConnectAs connectAs,
+                          const QVector<QPointF> &positions,
+                          QString &funcArea,
+                          QString &polyArea,
+                          GeometryPrefixSums &prefixSums) const;
+  QString settingsKey (CurveConnectAs connectAs,
+                       const DocumentModelGeneral &modelGeneral) const;
+};
+
+#endif // TEST_GEOMETRY_H
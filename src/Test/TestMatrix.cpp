@@ -6,11 +6,57 @@
 
 QTEST_MAIN (TestMatrix)
 
+#ifdef ENGAUGE_BENCHMARK
+const int BENCHMARK_SIZE = 200; // Rows and columns of benchmark matrices
+#endif
+
 TestMatrix::TestMatrix(QObject *parent) :
   QObject(parent)
 {
 }
 
+#ifdef ENGAUGE_BENCHMARK
+void TestMatrix::benchmarkDeterminant ()
+{
+  Matrix m = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+
+  QBENCHMARK {
+    m.determinant ();
+  }
+}
+
+void TestMatrix::benchmarkMultiply ()
+{
+  Matrix a = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+  Matrix b = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+
+  QBENCHMARK {
+    Matrix c = a * b;
+  }
+}
+
+void TestMatrix::benchmarkSolve ()
+{
+  Matrix m = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+  QVector<double> b (BENCHMARK_SIZE, 1.0), x;
+
+  QBENCHMARK {
+    m.solve (b,
+             x);
+  }
+}
+
+void TestMatrix::benchmarkTransposeMultiply ()
+{
+  Matrix a = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+  Matrix b = randomMatrix (BENCHMARK_SIZE, BENCHMARK_SIZE);
+
+  QBENCHMARK {
+    Matrix c = a.transposeMultiply (b);
+  }
+}
+#endif
+
 void TestMatrix::cleanupTestCase ()
 {
 }
@@ -38,6 +84,23 @@ void TestMatrix::initTestCase ()
   w.show ();
 }
 
+Matrix TestMatrix::randomMatrix (int rows,
+                                int cols) const
+{
+  // Repeatable pseudo-random values in [-1, 1]
+  unsigned int seed = 12345;
+
+  Matrix m (rows, cols);
+  for (int row = 0; row < rows; row++) {
+    for (int col = 0; col < cols; col++) {
+      seed = 1103515245 * seed + 12345;
+      m.set (row, col, ((seed >> 16) & 0x7fff) / 16383.5 - 1.0);
+    }
+  }
+
+  return m;
+}
+
 void TestMatrix::testDeterminant ()
 {
   Matrix m (3);
@@ -50,6 +113,20 @@ void TestMatrix::testDeterminant ()
   QVERIFY ((m.determinant () == a00 * a11 - a01 * a10));
 }
 
+void TestMatrix::testDeterminantLarge ()
+{
+  // Expansion into 3x3 minors, which use the closed form, is the reference for the LU decomposition used above 3x3
+  Matrix m = randomMatrix (4, 4);
+
+  double expected = 0, multiplier = 1;
+  for (int row = 0; row < 4; row++) {
+    expected += multiplier * m.get (row, 0) * m.minorReduced (row, 0).determinant ();
+    multiplier *= -1;
+  }
+
+  QVERIFY (qAbs (m.determinant () - expected) < 0.000001 * qAbs (expected));
+}
+
 void TestMatrix::testInverse ()
 {
   bool success = true;
@@ -274,6 +351,34 @@ void TestMatrix::testMultiplySquareMatrixAndVector ()
   QVERIFY (success);
 }  
 
+void TestMatrix::testSolve ()
+{
+  const int N = 6;
+
+  Matrix m = randomMatrix (N, N);
+  QVector<double> b (N), x;
+  for (int row = 0; row < N; row++) {
+    b [row] = row + 1;
+  }
+
+  QVERIFY (m.solve (b,
+                    x));
+
+  QVector<double> product = m * x;
+  for (int row = 0; row < N; row++) {
+    QVERIFY (qAbs (product [row] - b [row]) < 0.000001);
+  }
+
+  // Singular matrix has no solution
+  Matrix singular (2);
+  singular.set (0, 0, 1);
+  singular.set (0, 1, 2);
+  singular.set (1, 0, 2);
+  singular.set (1, 1, 4);
+  QVERIFY (!singular.solve (QVector<double> (2, 1.0),
+                            x));
+}
+
 void TestMatrix::testTranspose ()
 {
   bool success = true;
@@ -300,3 +405,20 @@ void TestMatrix::testTranspose ()
   
   QVERIFY (success);
 }
+
+void TestMatrix::testTransposeMultiply ()
+{
+  Matrix a = randomMatrix (3, 5);
+  Matrix b = randomMatrix (3, 4);
+
+  Matrix afterGot = a.transposeMultiply (b);
+  Matrix afterWanted = a.transpose () * b;
+
+  QVERIFY (afterGot.rows () == afterWanted.rows ());
+  QVERIFY (afterGot.cols () == afterWanted.cols ());
+  for (int row = 0; row < afterWanted.rows (); row++) {
+    for (int col = 0; col < afterWanted.cols (); col++) {
+      QVERIFY (qAbs (afterGot.get (row, col) - afterWanted.get (row, col)) < 0.000001);
+    }
+  }
+}
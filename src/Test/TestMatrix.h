@@ -18,16 +18,27 @@ private slots:
   void cleanupTestCase ();
   void initTestCase ();
 
+#ifdef ENGAUGE_BENCHMARK
+  void benchmarkDeterminant ();
+  void benchmarkMultiply ();
+  void benchmarkSolve ();
+  void benchmarkTransposeMultiply ();
+#endif
   void testDeterminant ();
+  void testDeterminantLarge ();
   void testInverse ();
   void testInverse2 ();
   void testMultiplyNonSquareMatrix ();
   void testMultiplyNonSquareMatrixAndVector ();    
   void testMultiplySquareMatrix ();
   void testMultiplySquareMatrixAndVector ();  
+  void testSolve ();
   void testTranspose ();
+  void testTransposeMultiply ();
   
 private:
+  Matrix randomMatrix (int rows,
+                       int cols) const;
 
 };
 
@@ -0,0 +1,130 @@
+#include "Logger.h"
+#include "MainWindow.h"
+#include "MimePointsParser.h"
+#include <QStringList>
+#include <QtTest/QtTest>
+#include "Test/TestMimePointsParser.h"
+
+QTEST_MAIN (TestMimePointsParser)
+
+TestMimePointsParser::TestMimePointsParser(QObject *parent) :
+  QObject(parent)
+{
+}
+
+void TestMimePointsParser::cleanupTestCase ()
+{
+}
+
+void TestMimePointsParser::initTestCase ()
+{
+  const QString NO_ERROR_REPORT_LOG_FILE;
+  const QString NO_REGRESSION_OPEN_FILE;
+  const bool NO_GNUPLOT_LOG_FILES = false;
+  const bool NO_REGRESSION_IMPORT = false;
+  const bool NO_RESET = false;
+  const bool DEBUG_FLAG = false;
+  const QStringList NO_LOAD_STARTUP_FILES;
+
+  initializeLogging ("engauge_test",
+                     "engauge_test.log",
+                     DEBUG_FLAG);
+
+  MainWindow w (NO_ERROR_REPORT_LOG_FILE,
+                NO_REGRESSION_OPEN_FILE,
+                NO_GNUPLOT_LOG_FILES,
+                NO_REGRESSION_IMPORT,
+                NO_RESET,
+                NO_LOAD_STARTUP_FILES);
+  w.show ();
+}
+
+void TestMimePointsParser::testCrLf ()
+{
+  // Windows line endings leave a carriage return at the end of each second field, which is ignored like other
+  // trailing whitespace
+  MimePointsParser parser ("x\tCurve1\r\n1\t2\r\n3.5\t-4\r\n");
+
+  QVERIFY (parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.lineCount () == 4);
+  QVERIFY (parser.xValues ().count () == 2);
+  QVERIFY (parser.xValues ().at (0) == 1.0);
+  QVERIFY (parser.yValues ().at (0) == 2.0);
+  QVERIFY (parser.xValues ().at (1) == 3.5);
+  QVERIFY (parser.yValues ().at (1) == -4.0);
+}
+
+void TestMimePointsParser::testLargeTable ()
+{
+  const int NUM_ROWS = 100000;
+
+  QString text ("x\tCurve1\n");
+  for (int row = 0; row < NUM_ROWS; row++) {
+    text += QString ("%1\t%2\n")
+            .arg (row)
+            .arg (0.5 * row);
+  }
+
+  MimePointsParser parser (text);
+
+  QVERIFY (parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.lineCount () == text.split ("\n").count ());
+  QVERIFY (parser.xValues ().count () == NUM_ROWS);
+  QVERIFY (parser.yValues ().count () == NUM_ROWS);
+
+  bool success = true;
+  for (int row = 0; row < NUM_ROWS; row++) {
+    if (parser.xValues ().at (row) != row ||
+        parser.yValues ().at (row) != 0.5 * row) {
+      success = false;
+    }
+  }
+
+  QVERIFY (success);
+}
+
+void TestMimePointsParser::testMalformedNumbers ()
+{
+  // Lines with two fields that are not both numbers, like headers, are not points but are still two-field lines
+  MimePointsParser parser ("x\tCurve1\n1.2.3\t4\n5\t6e\n\t7\n8\t9\n");
+
+  QVERIFY (parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.xValues ().count () == 1);
+  QVERIFY (parser.xValues ().at (0) == 8.0);
+  QVERIFY (parser.yValues ().at (0) == 9.0);
+}
+
+void TestMimePointsParser::testTabOnlyLines ()
+{
+  // Lines with only whitespace, including tabs, are empty lines, which are skipped
+  MimePointsParser parser ("1\t2\n\t\n \t \n3\t4");
+
+  QVERIFY (parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.lineCount () == 4);
+  QVERIFY (parser.xValues ().count () == 2);
+  QVERIFY (parser.xValues ().at (1) == 3.0);
+  QVERIFY (parser.yValues ().at (1) == 4.0);
+}
+
+void TestMimePointsParser::testThreeFields ()
+{
+  // A line with three fields means the text is not a point table, and that line gives no point
+  MimePointsParser parser ("1\t2\n3\t4\t5\n6\t7\n");
+
+  QVERIFY (!parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.xValues ().count () == 2);
+  QVERIFY (parser.xValues ().at (1) == 6.0);
+  QVERIFY (parser.yValues ().at (1) == 7.0);
+}
+
+void TestMimePointsParser::testTrailingNewline ()
+{
+  // Trailing newline gives an empty last line, as with QString::split
+  QString text ("1\t2\n3\t4\n");
+  MimePointsParser parser (text);
+
+  QVERIFY (parser.allLinesHaveTwoFields ());
+  QVERIFY (parser.lineCount () == text.split ("\n").count ());
+  QVERIFY (parser.lineCount () == 3);
+  QVERIFY (parser.xValues ().count () == 2);
+}
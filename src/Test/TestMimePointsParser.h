@@ -0,0 +1,28 @@
+#ifndef TEST_MIME_POINTS_PARSER_H
+#define TEST_MIME_POINTS_PARSER_H
+
+#include <QObject>
+
+/// Unit test of parser for pasted point tables
+class TestMimePointsParser : public QObject
+{
+  Q_OBJECT
+public:
+  /// Single constructor.
+  explicit TestMimePointsParser(QObject *parent = 0);
+
+signals:
+
+private slots:
+  void cleanupTestCase ();
+  void initTestCase ();
+
+  void testCrLf ();
+  void testLargeTable ();
+  void testMalformedNumbers ();
+  void testTabOnlyLines ();
+  void testThreeFields ();
+  void testTrailingNewline ();
+};
+
+#endif // TEST_MIME_POINTS_PARSER_H
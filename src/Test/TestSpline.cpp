@@ -43,6 +43,103 @@ void TestSpline::initTestCase ()
   w.show ();
 }
 
+void TestSpline::testBatchMatchesSingle ()
+{
+  const int T_START = 0, T_STOP = 4; // Extrapolation in findSplinePairForFunctionX assumes t starts at zero
+  const double X_EPSILON = 0.00001;
+  const int NUM_T = 40;
+  const unsigned int NUM_ITERATIONS = 48;
+
+  bool success = true;
+
+  vector<double> t;
+  vector<SplinePair> xy;
+
+  t.push_back (T_START);
+  t.push_back (1);
+  t.push_back (2);
+  t.push_back (3);
+  t.push_back (T_STOP);
+
+  // Monotonic in x so function inversion is well defined
+  xy.push_back (SplinePair (1, 0.5));
+  xy.push_back (SplinePair (2.1, 0.9));
+  xy.push_back (SplinePair (2.9, 0.2));
+  xy.push_back (SplinePair (4.2, -0.3));
+  xy.push_back (SplinePair (5, 0.1));
+
+  Spline s (t, xy);
+
+  // Batch coefficient evaluation must reproduce the single-value evaluation exactly
+  vector<double> tValues;
+  for (int i = 0; i <= NUM_T; i++) {
+    tValues.push_back (T_START + (double) i * (T_STOP - T_START) / (double) NUM_T);
+  }
+
+  vector<SplinePair> batchCoeffs;
+  s.interpolateCoeffs (tValues, batchCoeffs);
+  for (unsigned int i = 0; i < tValues.size(); i++) {
+    SplinePair single = s.interpolateCoeff (tValues [i]);
+    if (batchCoeffs [i].x() != single.x() ||
+        batchCoeffs [i].y() != single.y()) {
+      success = false;
+    }
+  }
+
+  // Batch inversion, including extrapolation on both sides, must agree with the bisection search
+  vector<double> xValues;
+  for (int i = 0; i <= NUM_T; i++) {
+    xValues.push_back (0.5 + (double) i * 5.0 / (double) NUM_T);
+  }
+
+  vector<SplinePair> batchPairs;
+  s.findSplinePairsForFunctionX (xValues, batchPairs);
+  for (unsigned int i = 0; i < xValues.size(); i++) {
+    SplinePair single = s.findSplinePairForFunctionX (xValues [i],
+                                                      NUM_ITERATIONS);
+    if (qAbs (batchPairs [i].x() - single.x()) > X_EPSILON ||
+        qAbs (batchPairs [i].y() - single.y()) > X_EPSILON) {
+      success = false;
+    }
+  }
+
+  QVERIFY (success);
+}
+
+void TestSpline::testBatchSinglePoint ()
+{
+  bool success = true;
+
+  vector<double> t;
+  vector<SplinePair> xy;
+
+  t.push_back (0);
+  xy.push_back (SplinePair (1.5, -2.5));
+
+  Spline s (t, xy);
+
+  // With only one point every x value maps back to that point
+  vector<double> xValues;
+  xValues.push_back (-1.0);
+  xValues.push_back (1.5);
+  xValues.push_back (7.0);
+
+  vector<SplinePair> batchPairs;
+  s.findSplinePairsForFunctionX (xValues, batchPairs);
+  if (batchPairs.size () != xValues.size ()) {
+    success = false;
+  } else {
+    for (unsigned int i = 0; i < batchPairs.size (); i++) {
+      if (batchPairs [i].x() != 1.5 ||
+          batchPairs [i].y() != -2.5) {
+        success = false;
+      }
+    }
+  }
+
+  QVERIFY (success);
+}
+
 void TestSpline::testSplinesAsControlPoints ()
 {
   const int T_START = 1, T_STOP = 7;
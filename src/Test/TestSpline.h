@@ -17,6 +17,8 @@ private slots:
   void cleanupTestCase ();
   void initTestCase ();
 
+  void testBatchMatchesSingle ();
+  void testBatchSinglePoint ();
   void testSplinesAsControlPoints ();
 };
 
@@ -4,6 +4,7 @@
 #include "MainWindow.h"
 #include "MainWindowModel.h"
 #include <qmath.h>
+#include <QList>
 #include <QtTest/QtTest>
 #include "Test/TestTransformation.h"
 #include "Transformation.h"
@@ -11,6 +12,8 @@
 QTEST_MAIN (TestTransformation)
 
 const double EPSILON = 1.0;
+const double EPSILON_BATCH = 1e-9;
+const int NUM_BATCH_POINTS = 1000000; // Benchmarks only, since this is too slow for the regular tests
 
 using namespace std;
 
@@ -19,6 +22,65 @@ TestTransformation::TestTransformation(QObject *parent) :
 {
 }
 
+void TestTransformation::batchPoints (int count,
+                                      QVector<double> &x,
+                                      QVector<double> &y) const
+{
+  // Screen points spread over a 1000x1000 image, avoiding the origin where polar angles are undefined
+  x.resize (count);
+  y.resize (count);
+  for (int i = 0; i < count; i++) {
+    x [i] = 10.0 + (i % 997);
+    y [i] = 10.0 + (i / 997) % 991;
+  }
+}
+
+#ifdef ENGAUGE_BENCHMARK
+void TestTransformation::benchmarkBatch ()
+{
+  Transformation t;
+  initBatchTransformation (modelCoordsDefault(),
+                           t);
+
+  QVector<double> xScreen, yScreen;
+  batchPoints (NUM_BATCH_POINTS,
+               xScreen,
+               yScreen);
+  QVector<double> xGraph (NUM_BATCH_POINTS), yGraph (NUM_BATCH_POINTS);
+
+  QBENCHMARK {
+    t.transformScreenToRawGraph (NUM_BATCH_POINTS,
+                                 xScreen.constData (),
+                                 yScreen.constData (),
+                                 xGraph.data (),
+                                 yGraph.data ());
+  }
+}
+
+void TestTransformation::benchmarkSingle ()
+{
+  Transformation t;
+  initBatchTransformation (modelCoordsDefault(),
+                           t);
+
+  QVector<double> xScreen, yScreen;
+  batchPoints (NUM_BATCH_POINTS,
+               xScreen,
+               yScreen);
+  QVector<double> xGraph (NUM_BATCH_POINTS), yGraph (NUM_BATCH_POINTS);
+
+  QBENCHMARK {
+    for (int i = 0; i < NUM_BATCH_POINTS; i++) {
+      QPointF posGraph;
+      t.transformScreenToRawGraph (QPointF (xScreen [i], yScreen [i]),
+                                   posGraph);
+      xGraph [i] = posGraph.x();
+      yGraph [i] = posGraph.y();
+    }
+  }
+}
+#endif
+
 void TestTransformation::cleanupTestCase ()
 {
 
@@ -54,6 +116,25 @@ void TestTransformation::initTestCase ()
   w.show ();
 }
 
+void TestTransformation::initBatchTransformation (const DocumentModelCoords &modelCoords,
+                                                  Transformation &transformation) const
+{
+  // Axes points that are valid for every combination of cartesian/polar and linear/log
+  QTransform matrixScreen (100, 900, 100,
+                           900, 900, 100,
+                           1.0, 1.0, 1.0);
+  QTransform matrixGraph (1, 10, 1,
+                          1, 1, 10,
+                          1.0, 1.0, 1.0);
+
+  MainWindowModel mainWindowModel;
+  transformation.setModelCoords (modelCoords,
+                                 modelGeneralDefault(),
+                                 mainWindowModel);
+  transformation.updateTransformFromMatrices (matrixScreen,
+                                              matrixGraph);
+}
+
 void TestTransformation::initTransformation (const QPointF &s0,
                                              const QPointF &s1,
                                              const QPointF &s2,
@@ -120,6 +201,74 @@ DocumentModelGeneral TestTransformation::modelGeneralDefault() const
   return modelGeneral;
 }
 
+void TestTransformation::testBatchMatchesSingle ()
+{
+  QList<DocumentModelCoords> modelCoordsList;
+  for (int polar = 0; polar < 2; polar++) {
+    for (int logX = 0; logX < 2; logX++) {
+      for (int logY = 0; logY < 2; logY++) {
+
+        DocumentModelCoords modelCoords = modelCoordsDefault();
+        modelCoords.setCoordsType (polar ? COORDS_TYPE_POLAR : COORDS_TYPE_CARTESIAN);
+        modelCoords.setCoordScaleXTheta (logX ? COORD_SCALE_LOG : COORD_SCALE_LINEAR);
+        modelCoords.setCoordScaleYRadius (logY ? COORD_SCALE_LOG : COORD_SCALE_LINEAR);
+        modelCoords.setOriginRadius (polar && logY ? 0.5 : 0.0);
+        modelCoordsList << modelCoords;
+      }
+    }
+  }
+
+  // Theta units other than degrees
+  DocumentModelCoords modelCoordsRadians = modelCoordsDefault();
+  modelCoordsRadians.setCoordsType (COORDS_TYPE_POLAR);
+  modelCoordsRadians.setCoordUnitsTheta (COORD_UNITS_POLAR_THETA_RADIANS);
+  modelCoordsList << modelCoordsRadians;
+
+  DocumentModelCoords modelCoordsTurns = modelCoordsRadians;
+  modelCoordsTurns.setCoordUnitsTheta (COORD_UNITS_POLAR_THETA_TURNS);
+  modelCoordsList << modelCoordsTurns;
+
+  const int NUM_POINTS = 1000;
+  QVector<double> xScreen, yScreen;
+  batchPoints (NUM_POINTS,
+               xScreen,
+               yScreen);
+
+  QList<DocumentModelCoords>::const_iterator itr;
+  for (itr = modelCoordsList.begin(); itr != modelCoordsList.end(); itr++) {
+
+    Transformation t;
+    initBatchTransformation (*itr,
+                             t);
+
+    QVector<double> xGraph (NUM_POINTS), yGraph (NUM_POINTS);
+    t.transformScreenToRawGraph (NUM_POINTS,
+                                 xScreen.constData (),
+                                 yScreen.constData (),
+                                 xGraph.data (),
+                                 yGraph.data ());
+
+    QVector<double> xScreenRoundTrip (NUM_POINTS), yScreenRoundTrip (NUM_POINTS);
+    t.transformRawGraphToScreen (NUM_POINTS,
+                                 xGraph.constData (),
+                                 yGraph.constData (),
+                                 xScreenRoundTrip.data (),
+                                 yScreenRoundTrip.data ());
+
+    for (int i = 0; i < NUM_POINTS; i++) {
+
+      QPointF posGraph, posScreen;
+      t.transformScreenToRawGraph (QPointF (xScreen [i], yScreen [i]),
+                                   posGraph);
+      t.transformRawGraphToScreen (QPointF (xGraph [i], yGraph [i]),
+                                   posScreen);
+
+      QVERIFY ((differenceMagnitude (posGraph, QPointF (xGraph [i], yGraph [i])) < EPSILON_BATCH * (1.0 + qAbs (posGraph.x()) + qAbs (posGraph.y()))));
+      QVERIFY ((differenceMagnitude (posScreen, QPointF (xScreenRoundTrip [i], yScreenRoundTrip [i])) < EPSILON_BATCH * 1000.0));
+    }
+  }
+}
+
 void TestTransformation::testCartesianLinearLinear ()
 {
   QPointF s0 (10, 1000);
@@ -5,6 +5,9 @@
 #include "DocumentModelGeneral.h"
 #include <QObject>
 #include <QPointF>
+#include <QVector>
+
+class Transformation;
 
 /// Unit test of transformation class. Checking mostly involves verifying forward/reverse are inverses of each other
 class TestTransformation : public QObject
@@ -18,6 +21,11 @@ private slots:
   void cleanupTestCase ();
   void initTestCase ();
 
+#ifdef ENGAUGE_BENCHMARK
+  void benchmarkBatch ();
+  void benchmarkSingle ();
+#endif
+  void testBatchMatchesSingle ();
   void testCartesianLinearLinear ();
   void testCartesianLinearLog ();
   void testCartesianLogLinear ();
@@ -27,11 +35,16 @@ private slots:
   void testPolarLogOffset10 ();
 
 private:
+  void batchPoints (int count,
+                    QVector<double> &x,
+                    QVector<double> &y) const;
   DocumentModelCoords modelCoordsDefault() const;
   DocumentModelGeneral modelGeneralDefault() const;
 
   double differenceMagnitude (const QPointF &vector1,
                               const QPointF &vector2) const;
+  void initBatchTransformation (const DocumentModelCoords &modelCoords,
+                                Transformation &transformation) const;
   void initTransformation (const QPointF &s0,
                            const QPointF &s1,
                            const QPointF &s2,
@@ -22,18 +22,200 @@ using namespace std;
 /// number of characters.
 const int PRECISION_DIGITS = 4;
 
+const double NEAR_CLIP = 0.000001; // Same as QTransform
 const double PI = 3.1415926535;
 const double ZERO_OFFSET_AFTER_LOG = 1; // Log of this value is zero
 
+/// Values that the batch transformations need from DocumentModelCoords, extracted once per batch. Angle conversions
+/// are kept as numerator and denominator so the batch results match the single point results exactly
+struct BatchParameters
+{
+  double thetaNumerator;
+  double thetaDenominator;
+  double originRadius;
+  double lnOffset;
+};
+
+static BatchParameters batchParameters (const DocumentModelCoords &modelCoords,
+                                        bool toRadians)
+{
+  double thetaUnitsPerHalfTurn = 180.0; // Initialized to prevent compiler warning
+  switch (modelCoords.coordUnitsTheta())
+  {
+    case COORD_UNITS_POLAR_THETA_DEGREES:
+    case COORD_UNITS_POLAR_THETA_DEGREES_MINUTES:
+    case COORD_UNITS_POLAR_THETA_DEGREES_MINUTES_SECONDS:
+    case COORD_UNITS_POLAR_THETA_DEGREES_MINUTES_SECONDS_NSEW:
+      thetaUnitsPerHalfTurn = 180.0;
+      break;
+
+    case COORD_UNITS_POLAR_THETA_GRADIANS:
+      thetaUnitsPerHalfTurn = 200.0;
+      break;
+
+    case COORD_UNITS_POLAR_THETA_RADIANS:
+      thetaUnitsPerHalfTurn = PI;
+      break;
+
+    case COORD_UNITS_POLAR_THETA_TURNS:
+      thetaUnitsPerHalfTurn = 0.5;
+      break;
+
+    default:
+      ENGAUGE_ASSERT (false);
+  }
+
+  BatchParameters parameters;
+  if (modelCoords.coordUnitsTheta() == COORD_UNITS_POLAR_THETA_RADIANS) {
+
+    // No conversion, which is not the same as multiplying and dividing by PI because of roundoff
+    parameters.thetaNumerator = 1.0;
+    parameters.thetaDenominator = 1.0;
+
+  } else if (toRadians) {
+
+    parameters.thetaNumerator = PI;
+    parameters.thetaDenominator = thetaUnitsPerHalfTurn;
+
+  } else {
+
+    parameters.thetaNumerator = thetaUnitsPerHalfTurn;
+    parameters.thetaDenominator = PI;
+
+  }
+  parameters.originRadius = modelCoords.originRadius();
+  parameters.lnOffset = qLn (modelCoords.coordsType() == COORDS_TYPE_CARTESIAN ?
+                             ZERO_OFFSET_AFTER_LOG :
+                             modelCoords.originRadius());
+
+  return parameters;
+}
+
+/// Batch version of Transformation::transformLinearCartesianGraphToRawGraph, operating in place. There is one
+/// instantiation per coordinate type combination so the inner loop has no branches
+template <bool IS_POLAR, bool IS_LOG_X, bool IS_LOG_Y>
+static void batchLinearCartesianGraphToRawGraph (int count,
+                                                 double x [],
+                                                 double y [],
+                                                 const BatchParameters &parameters)
+{
+  for (int i = 0; i < count; i++) {
+
+    double xRaw = x [i];
+    double yRaw = y [i];
+
+    if (IS_POLAR) {
+      double angleRadians = qAtan2 (yRaw,
+                                    xRaw);
+      double radius = qSqrt (xRaw * xRaw + yRaw * yRaw);
+      xRaw = angleRadians * parameters.thetaNumerator / parameters.thetaDenominator;
+      yRaw = radius;
+
+      if (!IS_LOG_Y) {
+        yRaw += parameters.originRadius;
+      }
+    }
+
+    if (IS_LOG_X) {
+      xRaw = qExp (xRaw);
+    }
+
+    if (IS_LOG_Y) {
+      yRaw = qExp (yRaw + parameters.lnOffset);
+    }
+
+    x [i] = xRaw;
+    y [i] = yRaw;
+  }
+}
+
+/// Batch version of Transformation::transformRawGraphToLinearCartesianGraph, with one instantiation per
+/// coordinate type combination
+template <bool IS_POLAR, bool IS_LOG_X, bool IS_LOG_Y>
+static void batchRawGraphToLinearCartesianGraph (int count,
+                                                 const double xRaw [],
+                                                 const double yRaw [],
+                                                 double x [],
+                                                 double y [],
+                                                 const BatchParameters &parameters)
+{
+  for (int i = 0; i < count; i++) {
+
+    double xLinear = xRaw [i];
+    double yLinear = yRaw [i];
+
+    if (IS_POLAR && !IS_LOG_Y) {
+      yLinear -= parameters.originRadius;
+    }
+
+    if (IS_LOG_X) {
+      xLinear = qLn (xLinear);
+    }
+
+    if (IS_LOG_Y) {
+      yLinear = qLn (yLinear) - parameters.lnOffset;
+    }
+
+    if (IS_POLAR) {
+      double angleRadians = xLinear * parameters.thetaNumerator / parameters.thetaDenominator;
+      double radius = yLinear;
+      xLinear = radius * cos (angleRadians);
+      yLinear = radius * sin (angleRadians);
+    }
+
+    x [i] = xLinear;
+    y [i] = yLinear;
+  }
+}
+
+/// Apply a QTransform to arrays of points. The matrix entries are loaded once, and the affine loop, which is the
+/// usual case, is simple enough for the compiler to vectorize
+static void batchMap (const QTransform &transform,
+                      int count,
+                      const double xIn [],
+                      const double yIn [],
+                      double xOut [],
+                      double yOut [])
+{
+  const double m11 = transform.m11 (), m12 = transform.m12 (), m13 = transform.m13 ();
+  const double m21 = transform.m21 (), m22 = transform.m22 (), m23 = transform.m23 ();
+  const double m31 = transform.m31 (), m32 = transform.m32 (), m33 = transform.m33 ();
+
+  if (transform.type () < QTransform::TxProject) {
+
+    for (int i = 0; i < count; i++) {
+      double x = xIn [i];
+      double y = yIn [i];
+      xOut [i] = m11 * x + m21 * y + m31;
+      yOut [i] = m12 * x + m22 * y + m32;
+    }
+
+  } else {
+
+    // Same perspective handling as QTransform::map
+    for (int i = 0; i < count; i++) {
+      double x = xIn [i];
+      double y = yIn [i];
+      double w = m13 * x + m23 * y + m33;
+      if (w < NEAR_CLIP) {
+        w = NEAR_CLIP;
+      }
+      w = 1.0 / w;
+      xOut [i] = (m11 * x + m21 * y + m31) * w;
+      yOut [i] = (m12 * x + m22 * y + m32) * w;
+    }
+  }
+}
+
 Transformation::Transformation() :
   m_transformIsDefined (false)
 {
 }
 
 Transformation::Transformation (const Transformation &other) :
-  m_transformIsDefined (other.transformIsDefined()),
-  m_transform (other.transformMatrix())
+  m_transformIsDefined (other.transformIsDefined())
 {
+  setTransform (other.transformMatrix());
   setModelCoords (other.modelCoords(),
                   other.modelGeneral(),
                   other.modelMainWindow());
@@ -42,7 +224,7 @@ Transformation::Transformation (const Transformation &other) :
 Transformation &Transformation::operator=(const Transformation &other)
 {
   m_transformIsDefined = other.transformIsDefined();
-  m_transform = other.transformMatrix ();
+  setTransform (other.transformMatrix ());
   setModelCoords (other.modelCoords(),
                   other.modelGeneral(),
                   other.modelMainWindow());
@@ -241,7 +423,7 @@ void Transformation::identity()
   m_transformIsDefined = true;
 
   QTransform ident;
-  m_transform = ident;
+  setTransform (ident);
 }
 
 double Transformation::logToLinearCartesian (double xy)
@@ -328,6 +510,15 @@ void Transformation::setModelCoords (const DocumentModelCoords &modelCoords,
   m_modelMainWindow = modelMainWindow;
 }
 
+void Transformation::setTransform (const QTransform &transform)
+{
+  m_transform = transform;
+
+  // Each point transformation only needs a 3x3 map, so the transpose and inverse are computed here once
+  m_transformScreenToGraph = transform.transposed ();
+  m_transformGraphToScreen = transform.inverted ().transposed ();
+}
+
 bool Transformation::transformIsDefined() const
 {
   return m_transformIsDefined;
@@ -377,7 +568,7 @@ void Transformation::transformLinearCartesianGraphToScreen (const QPointF &coord
 {
   ENGAUGE_ASSERT (m_transformIsDefined);
 
-  coordScreen = m_transform.inverted ().transposed ().map (coordGraph);
+  coordScreen = m_transformGraphToScreen.map (coordGraph);
 }
 
 QTransform Transformation::transformMatrix () const
@@ -438,12 +629,65 @@ void Transformation::transformRawGraphToScreen (const QPointF &pointRaw,
                                          pointScreen);
 }
 
+void Transformation::transformRawGraphToScreen (int count,
+                                                const double xRaw [],
+                                                const double yRaw [],
+                                                double xScreen [],
+                                                double yScreen []) const
+{
+  ENGAUGE_ASSERT (m_transformIsDefined);
+
+  // WARNING - the template instantiations below must mirror transformRawGraphToLinearCartesianGraph
+
+  BatchParameters parameters = batchParameters (m_modelCoords,
+                                                true);
+
+  bool isPolar = (m_modelCoords.coordsType() == COORDS_TYPE_POLAR);
+  bool isLogX = (m_modelCoords.coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogY = (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LOG);
+
+  int combination = (isPolar ? 4 : 0) + (isLogX ? 2 : 0) + (isLogY ? 1 : 0);
+  switch (combination) {
+    case 0: batchRawGraphToLinearCartesianGraph<false, false, false> (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 1: batchRawGraphToLinearCartesianGraph<false, false, true > (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 2: batchRawGraphToLinearCartesianGraph<false, true , false> (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 3: batchRawGraphToLinearCartesianGraph<false, true , true > (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 4: batchRawGraphToLinearCartesianGraph<true , false, false> (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 5: batchRawGraphToLinearCartesianGraph<true , false, true > (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 6: batchRawGraphToLinearCartesianGraph<true , true , false> (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+    case 7: batchRawGraphToLinearCartesianGraph<true , true , true > (count, xRaw, yRaw, xScreen, yScreen, parameters); break;
+  }
+
+  batchMap (m_transformGraphToScreen,
+            count,
+            xScreen,
+            yScreen,
+            xScreen,
+            yScreen);
+}
+
 void Transformation::transformScreenToLinearCartesianGraph (const QPointF &coordScreen,
                                                             QPointF &coordGraph) const
 {
   ENGAUGE_ASSERT (m_transformIsDefined);
 
-  coordGraph = m_transform.transposed ().map (coordScreen);
+  coordGraph = m_transformScreenToGraph.map (coordScreen);
+}
+
+void Transformation::transformScreenToLinearCartesianGraph (int count,
+                                                            const double xScreen [],
+                                                            const double yScreen [],
+                                                            double xLinearCartesian [],
+                                                            double yLinearCartesian []) const
+{
+  ENGAUGE_ASSERT (m_transformIsDefined);
+
+  batchMap (m_transformScreenToGraph,
+            count,
+            xScreen,
+            yScreen,
+            xLinearCartesian,
+            yLinearCartesian);
 }
 
 void Transformation::transformScreenToRawGraph (const QPointF &coordScreen,
@@ -456,6 +700,40 @@ void Transformation::transformScreenToRawGraph (const QPointF &coordScreen,
                                            coordGraph);
 }
 
+void Transformation::transformScreenToRawGraph (int count,
+                                                const double xScreen [],
+                                                const double yScreen [],
+                                                double xGraph [],
+                                                double yGraph []) const
+{
+  // WARNING - the template instantiations below must mirror transformLinearCartesianGraphToRawGraph
+
+  transformScreenToLinearCartesianGraph (count,
+                                         xScreen,
+                                         yScreen,
+                                         xGraph,
+                                         yGraph);
+
+  BatchParameters parameters = batchParameters (m_modelCoords,
+                                                false);
+
+  bool isPolar = (m_modelCoords.coordsType() == COORDS_TYPE_POLAR);
+  bool isLogX = (m_modelCoords.coordScaleXTheta() == COORD_SCALE_LOG);
+  bool isLogY = (m_modelCoords.coordScaleYRadius() == COORD_SCALE_LOG);
+
+  int combination = (isPolar ? 4 : 0) + (isLogX ? 2 : 0) + (isLogY ? 1 : 0);
+  switch (combination) {
+    case 0: batchLinearCartesianGraphToRawGraph<false, false, false> (count, xGraph, yGraph, parameters); break;
+    case 1: batchLinearCartesianGraphToRawGraph<false, false, true > (count, xGraph, yGraph, parameters); break;
+    case 2: batchLinearCartesianGraphToRawGraph<false, true , false> (count, xGraph, yGraph, parameters); break;
+    case 3: batchLinearCartesianGraphToRawGraph<false, true , true > (count, xGraph, yGraph, parameters); break;
+    case 4: batchLinearCartesianGraphToRawGraph<true , false, false> (count, xGraph, yGraph, parameters); break;
+    case 5: batchLinearCartesianGraphToRawGraph<true , false, true > (count, xGraph, yGraph, parameters); break;
+    case 6: batchLinearCartesianGraphToRawGraph<true , true , false> (count, xGraph, yGraph, parameters); break;
+    case 7: batchLinearCartesianGraphToRawGraph<true , true , true > (count, xGraph, yGraph, parameters); break;
+  }
+}
+
 void Transformation::update (bool fileIsLoaded,
                              const CmdMediator &cmdMediator,
                              const MainWindowModel &modelMainWindow)
@@ -515,12 +793,12 @@ void Transformation::updateTransformFromMatrices (const QTransform &matrixScreen
                                            pointGraphLinearCart2);
 
   // Calculate the transform
-  m_transform = calculateTransformFromLinearCartesianPoints (QPointF (matrixScreen.m11(), matrixScreen.m21()),
+  setTransform (calculateTransformFromLinearCartesianPoints (QPointF (matrixScreen.m11(), matrixScreen.m21()),
                                                              QPointF (matrixScreen.m12(), matrixScreen.m22()),
                                                              QPointF (matrixScreen.m13(), matrixScreen.m23()),
                                                              QPointF (pointGraphLinearCart0.x(), pointGraphLinearCart0.y()),
                                                              QPointF (pointGraphLinearCart1.x(), pointGraphLinearCart1.y()),
-                                                             QPointF (pointGraphLinearCart2.x(), pointGraphLinearCart2.y()));
+                                                             QPointF (pointGraphLinearCart2.x(), pointGraphLinearCart2.y())));
 
   // Logging
   QTransform matrixGraphLinear (pointGraphLinearCart0.x(),
@@ -123,14 +123,39 @@ public:
   void transformRawGraphToScreen (const QPointF &pointRaw,
                                   QPointF &pointScreen) const;
 
+  /// Batch version of transformRawGraphToScreen for count points held in separate x and y arrays. The coordinate
+  /// type is resolved once per call instead of once per point, so this should be used for large loops. Output arrays
+  /// may be the same as the input arrays
+  void transformRawGraphToScreen (int count,
+                                  const double xRaw [],
+                                  const double yRaw [],
+                                  double xScreen [],
+                                  double yScreen []) const;
+
   /// Transform screen coordinates to linear cartesian coordinates
   void transformScreenToLinearCartesianGraph (const QPointF &pointScreen,
                                               QPointF &pointLinearCartesian) const;
 
+  /// Batch version of transformScreenToLinearCartesianGraph. Output arrays may be the same as the input arrays
+  void transformScreenToLinearCartesianGraph (int count,
+                                              const double xScreen [],
+                                              const double yScreen [],
+                                              double xLinearCartesian [],
+                                              double yLinearCartesian []) const;
+
   /// Transform from cartesian pixel screen coordinates to cartesian/polar graph coordinates
   void transformScreenToRawGraph (const QPointF &coordScreen,
                                   QPointF &coordGraph) const;
 
+  /// Batch version of transformScreenToRawGraph for count points held in separate x and y arrays. The coordinate
+  /// type is resolved once per call instead of once per point, so this should be used for large loops. Output arrays
+  /// may be the same as the input arrays
+  void transformScreenToRawGraph (int count,
+                                  const double xScreen [],
+                                  const double yScreen [],
+                                  double xGraph [],
+                                  double yGraph []) const;
+
   /// Update transform by iterating through the axis points.
   void update (bool fileIsLoaded,
                const CmdMediator &cmdMediator,
@@ -146,6 +171,9 @@ private:
                        const DocumentModelGeneral &modelGeneral,
                        const MainWindowModel &modelMainWindow);
 
+  // Set m_transform and the derived transforms
+  void setTransform (const QTransform &transform);
+
   // Compute transform from screen and graph points. The 3x3 matrices are handled as QTransform since QMatrix is deprecated
   void updateTransformFromMatrices (const QTransform &matrixScreen,
                                     const QTransform &matrixGraph);
@@ -156,6 +184,10 @@ private:
   // Transform between cartesian screen coordinates and cartesian graph coordinates
   QTransform m_transform;
 
+  // Derived from m_transform by setTransform. These map screen to linear cartesian graph coordinates, and back
+  QTransform m_transformScreenToGraph;
+  QTransform m_transformGraphToScreen;
+
   // Coordinates information from last time the transform was updated. Only defined if  m_transformIsDefined is true
   DocumentModelCoords m_modelCoords;
 
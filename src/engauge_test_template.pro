@@ -19,7 +19,11 @@ TEMPLATE    = app
 #    Sample command lines
 #       qmake CONFIG+=pdf
 #       qmake "CONFIG+=debug pdf"
-# 3) Gratuitous warning about import_qpa_plugin in Fedora is due to 'CONFIG=qt' but that option takes care of 
+# 3) Add 'benchmark' to the qmake command line to include the benchmarks, which are too slow for the regular tests
+#    Sample command lines
+#       qmake CONFIG+=benchmark
+#       qmake "CONFIG+=release benchmark"
+# 4) Gratuitous warning about import_qpa_plugin in Fedora is due to 'CONFIG=qt' but that option takes care of 
 #    include/library files in an automated and platform-independent manner, so it will not be removed
 CONFIG      += qt warn_on thread testcase 
 
@@ -91,6 +95,7 @@ HEADERS  += \
     Cmd/CmdSettingsSegments.h \
     Cmd/CmdStackShadow.h \
     Cmd/CmdUndoForTest.h \
+    util/CoalescingThread.h \
     Color/ColorConstants.h \
     Color/ColorFilter.h \
     Color/ColorFilterEntry.h \
@@ -122,6 +127,9 @@ HEADERS  += \
     Coord/CoordUnitsPolarTheta.h \
     Coord/CoordUnitsTime.h \
     Correlation/Correlation.h \
+    Correlation/CorrelationBatchWorker.h \
+    Correlation/CorrelationBorrow.h \
+    Correlation/CorrelationPool.h \
     Cursor/CursorFactory.h \
     Cursor/CursorSize.h \
     Curve/Curve.h \
@@ -153,6 +161,8 @@ HEADERS  += \
     Dlg/DlgFilterCommand.h \
     Dlg/DlgFilterThread.h \
     Dlg/DlgFilterWorker.h \
+    Dlg/DlgGridRemovalThread.h \
+    Dlg/DlgGridRemovalWorker.h \
     Dlg/DlgImportAdvanced.h \
     Dlg/DlgImportCroppingNonPdf.h \
     Dlg/DlgRequiresTransform.h \
@@ -196,6 +206,7 @@ HEADERS  += \
     util/EnumsToQt.h \
     Export/ExportAlignLinear.h \
     Export/ExportAlignLog.h \
+    Export/ExportColumns.h \
     Export/ExportDelimiter.h \
     Export/ExportLayoutFunctions.h \
     Export/ExportPointsIntervalUnits.h \
@@ -203,8 +214,11 @@ HEADERS  += \
     Export/ExportPointsSelectionRelations.h \
     Export/ExportDelimiter.h \
     Export/ExportFileAbstractBase.h \
+    Export/ExportFileBinary.h \
     Export/ExportFileFunctions.h \
+    Export/ExportFileFunctionsWorker.h \
     Export/ExportFileRelations.h \
+    Export/ExportFileRelationsWorker.h \
     Export/ExportHeader.h \
     Export/ExportImageForRegression.h \
     Export/ExportOrdinalsSmooth.h \
@@ -214,6 +228,7 @@ HEADERS  += \
     Export/ExportValuesOrdinal.h \
     Export/ExportValuesXOrY.h \
     Export/ExportXThetaValuesMergedFunctions.h \
+    Export/ExportYRadiusValues.h \
     FileCmd/FileCmdAbstract.h \
     FileCmd/FileCmdClose.h \
     FileCmd/FileCmdExport.h \
@@ -225,7 +240,12 @@ HEADERS  += \
     Filter/FilterImage.h \
     Fitting/FittingCurve.h \
     Fitting/FittingCurveCoefficients.h \            
+    Fitting/FittingIncremental.h \
+    Fitting/FittingLeastSquares.h \
     Fitting/FittingModel.h \
+    Fitting/FittingOrderSelection.h \
+    Fitting/FittingOrderSelectionThread.h \
+    Fitting/FittingOrderSelectionWorker.h \
     Fitting/FittingPointsConvenient.h \        
     Fitting/FittingStatistics.h \
     Fitting/FittingWindow.h \
@@ -234,17 +254,23 @@ HEADERS  += \
     Format/FormatCoordsUnitsStrategyNonPolarTheta.h \
     Format/FormatCoordsUnitsStrategyPolarTheta.h \
     Format/FormatDateTime.h \
+    Format/FormatDateTimeCompiled.h \
     Format/FormatDegreesMinutesSecondsBase.h \
     Format/FormatDegreesMinutesSecondsNonPolarTheta.h \
     Format/FormatDegreesMinutesSecondsPolarTheta.h \
+    Format/FormatDouble.h \
     Callback/functor.h \
+    Geometry/GeometryCache.h \
     Geometry/GeometryModel.h \
+    Geometry/GeometryPrefixSums.h \
+    Geometry/GeometryResult.h \
     Geometry/GeometryStrategyAbstractBase.h \
     Geometry/GeometryStrategyContext.h \
     Geometry/GeometryStrategyFunctionSmooth.h \
     Geometry/GeometryStrategyFunctionStraight.h \
     Geometry/GeometryStrategyRelationSmooth.h \
     Geometry/GeometryStrategyRelationStraight.h \
+    Geometry/GeometryThread.h \
     Geometry/GeometryWindow.h \
     Ghosts/GhostEllipse.h \
     Ghosts/GhostPath.h \
@@ -269,6 +295,7 @@ HEADERS  += \
     Grid/GridLine.h \
     Grid/GridLineFactory.h \
     Grid/GridLineLimiter.h \
+    Grid/GridLineRasterizer.h \
     Grid/GridLines.h \
     Grid/GridLineStyle.h \
     Grid/GridRemoval.h \
@@ -291,6 +318,8 @@ HEADERS  += \
     Mime/MimePointsDetector.h \
     Mime/MimePointsExport.h \
     Mime/MimePointsImport.h \    
+    Mime/MimePointsParser.h \
+    Mime/MimePointsParserThread.h \
     util/mmsubs.h \
     Network/NetworkClient.h \
     NonPdf/NonPdf.h \
@@ -309,6 +338,7 @@ HEADERS  += \
     Point/PointShape.h \
     Point/PointStyle.h \
     util/QtToString.h \
+    util/RunnableBatch.h \
     ScaleBar/ScaleBarAxisPointsUnite.h \
     Segment/Segment.h \
     Segment/SegmentFactory.h \
@@ -425,6 +455,7 @@ SOURCES += \
     Cmd/CmdSettingsSegments.cpp \
     Cmd/CmdStackShadow.cpp \
     Cmd/CmdUndoForTest.cpp \
+    util/CoalescingThread.cpp \
     Color/ColorFilter.cpp \
     Color/ColorFilterHistogram.cpp \
     Color/ColorFilterMode.cpp \
@@ -453,6 +484,9 @@ SOURCES += \
     Coord/CoordUnitsPolarTheta.cpp \
     Coord/CoordUnitsTime.cpp \
     Correlation/Correlation.cpp \
+    Correlation/CorrelationBatchWorker.cpp \
+    Correlation/CorrelationBorrow.cpp \
+    Correlation/CorrelationPool.cpp \
     Cursor/CursorFactory.cpp \
     Cursor/CursorSize.cpp \
     Curve/Curve.cpp \
@@ -484,6 +518,8 @@ SOURCES += \
     Dlg/DlgFilterCommand.cpp \
     Dlg/DlgFilterThread.cpp \
     Dlg/DlgFilterWorker.cpp \
+    Dlg/DlgGridRemovalThread.cpp \
+    Dlg/DlgGridRemovalWorker.cpp \
     Dlg/DlgImportAdvanced.cpp \
     Dlg/DlgImportCroppingNonPdf.cpp \
     Dlg/DlgRequiresTransform.cpp \
@@ -524,10 +560,14 @@ SOURCES += \
     util/EnumsToQt.cpp \
     Export/ExportAlignLinear.cpp \
     Export/ExportAlignLog.cpp \
+    Export/ExportColumns.cpp \
     Export/ExportDelimiter.cpp \
     Export/ExportFileAbstractBase.cpp \
+    Export/ExportFileBinary.cpp \
     Export/ExportFileFunctions.cpp \
+    Export/ExportFileFunctionsWorker.cpp \
     Export/ExportFileRelations.cpp \
+    Export/ExportFileRelationsWorker.cpp \
     Export/ExportHeader.cpp \
     Export/ExportImageForRegression.cpp \
     Export/ExportLayoutFunctions.cpp \
@@ -539,6 +579,7 @@ SOURCES += \
     Export/ExportToClipboard.cpp \
     Export/ExportToFile.cpp \
     Export/ExportXThetaValuesMergedFunctions.cpp \
+    Export/ExportYRadiusValues.cpp \
     FileCmd/FileCmdAbstract.cpp \
     FileCmd/FileCmdClose.cpp \
     FileCmd/FileCmdExport.cpp \
@@ -549,7 +590,12 @@ SOURCES += \
     FileCmd/FileCmdScript.cpp \
     Filter/FilterImage.cpp \
     Fitting/FittingCurve.cpp \    
+    Fitting/FittingIncremental.cpp \
+    Fitting/FittingLeastSquares.cpp \
     Fitting/FittingModel.cpp \
+    Fitting/FittingOrderSelection.cpp \
+    Fitting/FittingOrderSelectionThread.cpp \
+    Fitting/FittingOrderSelectionWorker.cpp \
     Fitting/FittingStatistics.cpp \
     Fitting/FittingWindow.cpp \    
     Format/FormatCoordsUnits.cpp \
@@ -557,16 +603,21 @@ SOURCES += \
     Format/FormatCoordsUnitsStrategyNonPolarTheta.cpp \
     Format/FormatCoordsUnitsStrategyPolarTheta.cpp \
     Format/FormatDateTime.cpp \
+    Format/FormatDateTimeCompiled.cpp \
     Format/FormatDegreesMinutesSecondsBase.cpp \
     Format/FormatDegreesMinutesSecondsNonPolarTheta.cpp \
     Format/FormatDegreesMinutesSecondsPolarTheta.cpp \
+    Format/FormatDouble.cpp \
+    Geometry/GeometryCache.cpp \
     Geometry/GeometryModel.cpp \
+    Geometry/GeometryPrefixSums.cpp \
     Geometry/GeometryStrategyAbstractBase.cpp \
     Geometry/GeometryStrategyContext.cpp \
     Geometry/GeometryStrategyFunctionSmooth.cpp \
     Geometry/GeometryStrategyFunctionStraight.cpp \
     Geometry/GeometryStrategyRelationSmooth.cpp \
     Geometry/GeometryStrategyRelationStraight.cpp \
+    Geometry/GeometryThread.cpp \
     Geometry/GeometryWindow.cpp \
     Ghosts/GhostEllipse.cpp \
     Ghosts/GhostPath.cpp \
@@ -590,6 +641,7 @@ SOURCES += \
     Grid/GridLine.cpp \
     Grid/GridLineFactory.cpp \
     Grid/GridLineLimiter.cpp \
+    Grid/GridLineRasterizer.cpp \
     Grid/GridLines.cpp \
     Grid/GridRemoval.cpp \
     Help/HelpBrowser.cpp \
@@ -609,6 +661,8 @@ SOURCES += \
     Mime/MimePointsDetector.cpp \
     Mime/MimePointsExport.cpp \
     Mime/MimePointsImport.cpp \    
+    Mime/MimePointsParser.cpp \
+    Mime/MimePointsParserThread.cpp \
     util/mmsubs.cpp \
     Network/NetworkClient.cpp \
     NonPdf/NonPdf.cpp \
@@ -624,6 +678,7 @@ SOURCES += \
     Point/PointShape.cpp \
     Point/PointStyle.cpp \
     util/QtToString.cpp \
+    util/RunnableBatch.cpp \
     ScaleBar/ScaleBarAxisPointsUnite.cpp \    
     Segment/Segment.cpp \
     Segment/SegmentFactory.cpp \
@@ -748,6 +803,13 @@ CONFIG(debug,debug|release) {
   message("Build type:       release")
 }
 
+benchmark {
+    message("Benchmarks:       yes")
+    DEFINES += "ENGAUGE_BENCHMARK"
+} else {
+    message("Benchmarks:       no")
+}
+
 jpeg2000 {
     message("JPEG2000 support: yes")
     _JPEG2000_INCLUDE = $$(JPEG2000_INCLUDE)
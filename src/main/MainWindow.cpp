@@ -77,6 +77,7 @@
 #include "MainTitleBarFormat.h"
 #include "MainWindow.h"
 #include "MimePointsImport.h"
+#include "MimePointsParserThread.h"
 #ifdef NETWORKING
 #include "NetworkClient.h"
 #endif
@@ -161,7 +162,8 @@ MainWindow::MainWindow(const QString &errorReportFile,
   m_fileCmdScript (0),
   m_isErrorReportRegressionTest (isRegressionTest),
   m_timerRegressionFileCmdScript(0),
-  m_fittingCurve (0)
+  m_fittingCurve (0),
+  m_mimePointsParserThread (0)
 {
   LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::MainWindow"
                               << " curDir=" << QDir::currentPath().toLatin1().data();
@@ -191,6 +193,7 @@ MainWindow::MainWindow(const QString &errorReportFile,
   createScene ();
   createNetwork ();
   createLoadImageFromUrl ();
+  createMimePointsParserThread ();
   createStateContextBackground ();
   createStateContextDigitize ();
   createStateContextTransformation ();
@@ -228,6 +231,11 @@ MainWindow::MainWindow(const QString &errorReportFile,
 
 MainWindow::~MainWindow()
 {
+  // Parsing in progress uses copies of its inputs, so it only has to finish
+  if (m_mimePointsParserThread != 0) {
+    m_mimePointsParserThread->wait ();
+    delete m_mimePointsParserThread;
+  }
 }
 
 void MainWindow::addDockWindow (QDockWidget *dockWidget,
@@ -1144,6 +1152,15 @@ void MainWindow::createMenus()
   updateRecentFileList();
 }
 
+void MainWindow::createMimePointsParserThread ()
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::createMimePointsParserThread";
+
+  m_mimePointsParserThread = new MimePointsParserThread;
+  connect (m_mimePointsParserThread, SIGNAL (signalPointsParsed (QString, QVector<double>, QVector<double>)),
+           this, SLOT (slotMimePointsParsed (QString, QVector<double>, QVector<double>)));
+}
+
 void MainWindow::createNetwork ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::createNetwork";
@@ -1467,16 +1484,38 @@ void MainWindow::fileExport(const QString &fileName,
   QFile file (fileName);
   if (file.open(QIODevice::WriteOnly)) {
 
-    QTextStream str (&file);
-
     DocumentModelExportFormat modelExportFormat = modelExportOverride (m_cmdMediator->document().modelExport(),
                                                                        exportStrategy,
                                                                        fileName);
-    exportStrategy.exportToFile (modelExportFormat,
-                                 m_cmdMediator->document(),
-                                 m_modelMainWindow,
-                                 transformation (),
-                                 str);
+
+    if (exportStrategy.isBinaryFileName (fileName)) {
+
+      if (!exportStrategy.exportToBinaryFile (modelExportFormat,
+                                              m_cmdMediator->document(),
+                                              transformation (),
+                                              fileName,
+                                              file)) {
+
+        // Nothing was written, so the empty file is removed
+        file.remove ();
+
+        QMessageBox::critical (0,
+                               engaugeWindowTitle(),
+                               tr ("Unable to export to file ") + fileName +
+                               tr (" since the values are too large for that format"));
+        return;
+      }
+
+    } else {
+
+      QTextStream str (&file);
+
+      exportStrategy.exportToFile (modelExportFormat,
+                                   m_cmdMediator->document(),
+                                   m_modelMainWindow,
+                                   transformation (),
+                                   str);
+    }
 
     updateChecklistGuide ();
     m_statusBar->showTemporaryMessage("File saved");
@@ -3126,21 +3165,12 @@ void MainWindow::slotEditPaste ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::slotEditPaste";
 
-  QList<QPoint> points;
-  QList<double> ordinals;
-
-  MimePointsImport mimePointsImport;
-  mimePointsImport.retrievePoints (m_transformation,
-                                   points,
-                                   ordinals);
+  // Large tables take a noticeable time to parse, so that is done in another thread while the user interface stays
+  // responsive. The points are added by slotMimePointsParsed, which restores the cursor
+  QApplication::setOverrideCursor (Qt::WaitCursor);
 
-  CmdAddPointsGraph *cmd = new CmdAddPointsGraph (*this,
-                                                  m_cmdMediator->document(),
-                                                  m_cmbCurve->currentText (),
-                                                  points,
-                                                  ordinals);
-  m_digitizeStateContext->appendNewCmd (m_cmdMediator,
-                                        cmd);
+  m_mimePointsParserThread->request (m_cmbCurve->currentText (),
+                                     QApplication::clipboard()->text ());
 }
 
 void MainWindow::slotEditPasteAsNew ()
@@ -3217,9 +3247,12 @@ void MainWindow::slotFileExport ()
   if (m_transformation.transformIsDefined()) {
 
     ExportToFile exportStrategy;
-    QString filter = QString ("%1;;%2;;All files (*.*)")
+    QString filter = QString ("%1;;%2;;%3;;%4;;%5;;All files (*.*)")
                      .arg (exportStrategy.filterCsv ())
-                     .arg (exportStrategy.filterTsv ());
+                     .arg (exportStrategy.filterTsv ())
+                     .arg (exportStrategy.filterNpy ())
+                     .arg (exportStrategy.filterNpz ())
+                     .arg (exportStrategy.filterFloat64 ());
 
     // OSX sandbox requires, for the default, a non-empty filename
     QString defaultFileName = QString ("%1/%2.%3")
@@ -3493,6 +3526,43 @@ void MainWindow::slotLoadStartupFiles ()
   }
 }
 
+void MainWindow::slotMimePointsParsed (QString curveName,
+                                       QVector<double> xValues,
+                                       QVector<double> yValues)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::slotMimePointsParsed"
+                              << " curve=" << curveName.toLatin1().data()
+                              << " points=" << xValues.count ();
+
+  QApplication::restoreOverrideCursor ();
+
+  // Document may have been closed, the curve removed, or the transformation lost, while the text was being parsed
+  if (m_cmdMediator == 0 ||
+      !m_cmdMediator->document().curvesGraphsNames().contains (curveName) ||
+      !m_transformation.transformIsDefined ()) {
+    return;
+  }
+
+  QList<QPoint> points;
+  QList<double> ordinals;
+
+  MimePointsImport mimePointsImport;
+  mimePointsImport.retrievePoints (m_transformation,
+                                   xValues,
+                                   yValues,
+                                   points,
+                                   ordinals);
+
+  // All points are added by one command, so there is one undo step and one update of the display
+  CmdAddPointsGraph *cmd = new CmdAddPointsGraph (*this,
+                                                  m_cmdMediator->document(),
+                                                  curveName,
+                                                  points,
+                                                  ordinals);
+  m_digitizeStateContext->appendNewCmd (m_cmdMediator,
+                                        cmd);
+}
+
 void MainWindow::slotMouseMove (QPointF pos)
 {
 //  LOG4CPP_DEBUG_S ((*mainCat)) << "MainWindow::slotMouseMove pos=" << QPointFToString (pos).toLatin1 ().data ();
@@ -4330,6 +4400,16 @@ void MainWindow::updateAfterCommand ()
   m_view->setFocus ();
 }
 
+void MainWindow::updateAfterCommand (const QStringList &pointIdentifiersChanged)
+{
+  LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::updateAfterCommand"
+                              << " changed=" << pointIdentifiersChanged.count ();
+
+  m_dockFittingWindow->setPointIdentifiersChanged (pointIdentifiersChanged);
+
+  updateAfterCommand ();
+}
+
 void MainWindow::updateAfterCommandStatusBarCoords ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::updateAfterCommandStatusBarCoords";
@@ -4582,10 +4662,7 @@ void MainWindow::updateGridLines ()
 {
   LOG4CPP_INFO_S ((*mainCat)) << "MainWindow::updateGridLines";
 
-  // Remove old grid lines
-  m_gridLines.clear ();
-
-  // Create new grid lines
+  // Create new grid lines. Old grid lines are removed by the factory, unless they are still valid
   GridLineFactory factory (*m_scene,
                            m_cmdMediator->document().modelCoords());
   factory.createGridLinesForEvenlySpacedGrid (m_cmdMediator->document().modelGridDisplay(),
@@ -18,6 +18,7 @@
 #include <QMainWindow>
 #include <QMap>
 #include <QUrl>
+#include <QVector>
 #include "Transformation.h"
 #include "ZoomControl.h"
 #include "ZoomFactor.h"
@@ -62,6 +63,7 @@ class GraphicsScene;
 class GraphicsView;
 class HelpWindow;
 class LoadImageFromUrl;
+class MimePointsParserThread;
 class NetworkClient;
 class QAction;
 class QActionGroup;
@@ -166,6 +168,10 @@ public:
   /// See GraphicsScene::updateAfterCommand
   void updateAfterCommand();
 
+  /// Same as the other updateAfterCommand, for a command that only added, removed or moved the specified graph points.
+  /// The Fitting Window then applies just those points to its fit
+  void updateAfterCommand (const QStringList &pointIdentifiersChanged);
+
   /// Call MainWindow::updateControls (which is private) after the very specific case - a mouse press/release.
   void updateAfterMouseRelease();
 
@@ -274,6 +280,7 @@ private slots:
   void slotHelpTutorial();
   void slotKeyPress (Qt::Key, bool);
   void slotLoadStartupFiles ();
+  void slotMimePointsParsed (QString, QVector<double>, QVector<double>);
   void slotMouseMove (QPointF);
   void slotMousePress (QPointF);
   void slotMouseRelease (QPointF);
@@ -359,6 +366,7 @@ private:
   void createIcons();
   void createLoadImageFromUrl ();
   void createMenus();
+  void createMimePointsParserThread ();
   void createNetwork();
   void createScene ();
   void createSettingsDialogs ();
@@ -636,6 +644,9 @@ private:
 
   // Fitted curve. Null if not currently applicable/defined
   FittingCurve *m_fittingCurve;
+
+  // Parsing of pasted point tables, so large tables do not block the user interface
+  MimePointsParserThread *m_mimePointsParserThread;
 };
 
 #endif // MAIN_WINDOW_H
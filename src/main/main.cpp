@@ -5,7 +5,10 @@
  ******************************************************************************************************/
 
 #include "ColorFilterMode.h"
+#include "CorrelationPool.h"
 #include "FittingCurveCoefficients.h"
+#include "FittingOrderSelection.h"
+#include "GeometryResult.h"
 #include <iostream>
 #include "Logger.h"
 #include "MainWindow.h"
@@ -17,6 +20,7 @@
 #include <QObject>
 #include <QProcessEnvironment>
 #include <QStyleFactory>
+#include <QVector>
 #include "TranslatorContainer.h"
 
 using namespace std;
@@ -107,6 +111,9 @@ int main(int argc, char *argv[])
 {
   qRegisterMetaType<ColorFilterMode> ("ColorFilterMode");
   qRegisterMetaType<FittingCurveCoefficients> ("FilterCurveCoefficients");
+  qRegisterMetaType<FittingOrderSelection> ("FittingOrderSelection");
+  qRegisterMetaType<GeometryResult> ("GeometryResult");
+  qRegisterMetaType<QVector<double> > ("QVector<double>");
 
   QApplication app(argc, argv);
 
@@ -143,7 +150,11 @@ int main(int argc, char *argv[])
   w.show();
 
   // Event loop
-  return app.exec();
+  int result = app.exec();
+
+  CorrelationPool::cleanup ();
+
+  return result;
 }
 
 void parseCmdLine (int argc,
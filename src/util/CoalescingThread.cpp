@@ -0,0 +1,56 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include "CoalescingThread.h"
+#include <QMutexLocker>
+
+CoalescingThread::CoalescingThread () :
+  m_isActive (false),
+  m_isPending (false)
+{
+}
+
+void CoalescingThread::beginRequest ()
+{
+  m_mutex.lock ();
+}
+
+void CoalescingThread::endRequest ()
+{
+  m_isPending = true;
+
+  bool isStartNeeded = !m_isActive;
+  m_isActive = true;
+
+  m_mutex.unlock ();
+
+  if (isStartNeeded) {
+
+    // Run may still be returning from its final check of the queue, after which start would otherwise be ignored
+    wait ();
+    start ();
+  }
+}
+
+void CoalescingThread::run ()
+{
+  while (true) {
+
+    {
+      QMutexLocker locker (&m_mutex);
+
+      if (!m_isPending) {
+        m_isActive = false;
+        return;
+      }
+
+      m_isPending = false;
+      takeRequest ();
+    }
+
+    processRequest ();
+  }
+}
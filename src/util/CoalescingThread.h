@@ -0,0 +1,52 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef COALESCING_THREAD_H
+#define COALESCING_THREAD_H
+
+#include <QMutex>
+#include <QThread>
+
+/// Base class for threads that process requests from the GUI thread. Requests that arrive while one is being
+/// processed are coalesced into the next call of takeRequest. Subclasses usually keep only the most recent request,
+/// so a burst of requests does not queue up stale work. Subclasses store the inputs of a request between beginRequest
+/// and endRequest, copy them out in takeRequest, and do the work in processRequest.
+///
+/// Since processRequest runs outside the GUI thread it must not log or reach ENGAUGE_ASSERT, whose failure report is
+/// a dialog. Inputs are therefore validated in the GUI thread before endRequest
+class CoalescingThread : public QThread
+{
+  Q_OBJECT;
+
+public:
+  /// Single constructor
+  CoalescingThread ();
+
+  /// Process queued requests until there are none left
+  virtual void run ();
+
+protected:
+  /// Lock the request inputs so the subclass can store a new request, replacing any that has not been taken yet
+  void beginRequest ();
+
+  /// Queue the request stored since beginRequest, and start the thread if it is not already running
+  void endRequest ();
+
+  /// Process the request copied out by takeRequest. Called in this thread without the lock
+  virtual void processRequest () = 0;
+
+  /// Copy out the inputs stored since the last call, for processRequest. Called in this thread with the lock held
+  virtual void takeRequest () = 0;
+
+private:
+
+  QMutex m_mutex; // Guards the members below and the request inputs of the subclass
+
+  bool m_isActive; // True from when the thread is started until run has nothing left to do
+  bool m_isPending;
+};
+
+#endif // COALESCING_THREAD_H
@@ -0,0 +1,59 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#include <QRunnable>
+#include <QThreadPool>
+#include "RunnableBatch.h"
+
+// Runs one runnable of a batch and then reports completion to the batch. The pool deletes this wrapper, while the
+// wrapped runnable stays with the batch
+class RunnableBatchTask : public QRunnable
+{
+public:
+  RunnableBatchTask (QRunnable &runnable,
+                     QSemaphore &finished) :
+    m_runnable (runnable),
+    m_finished (finished)
+  {
+  }
+
+  virtual void run ()
+  {
+    m_runnable.run ();
+    m_finished.release ();
+  }
+
+private:
+  QRunnable &m_runnable;
+  QSemaphore &m_finished;
+};
+
+RunnableBatch::RunnableBatch () :
+  m_countUnfinished (0)
+{
+}
+
+RunnableBatch::~RunnableBatch ()
+{
+  waitForDone ();
+
+  qDeleteAll (m_runnables);
+}
+
+void RunnableBatch::start (QRunnable *runnable)
+{
+  m_runnables << runnable;
+  ++m_countUnfinished;
+
+  QThreadPool::globalInstance ()->start (new RunnableBatchTask (*runnable,
+                                                                m_finished));
+}
+
+void RunnableBatch::waitForDone ()
+{
+  m_finished.acquire (m_countUnfinished);
+  m_countUnfinished = 0;
+}
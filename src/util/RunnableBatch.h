@@ -0,0 +1,43 @@
+/******************************************************************************************************
+ * (C) 2016 markummitchell@github.com. This file is part of Engauge Digitizer, which is released      *
+ * under GNU General Public License version 2 (GPLv2) or (at your option) any later version. See file *
+ * LICENSE or go to gnu.org/licenses for details. Distribution requires prior written permission.     *
+ ******************************************************************************************************/
+
+#ifndef RUNNABLE_BATCH_H
+#define RUNNABLE_BATCH_H
+
+#include <QList>
+#include <QSemaphore>
+
+class QRunnable;
+
+/// Batch of runnables that run on the global thread pool. Waiting covers just this batch, so other users of the
+/// shared pool are not waited for. The batch owns its runnables and deletes them when it is destroyed, so their results
+/// can be read after waitForDone. Runnables must not wait on a batch of their own, since every pool thread could end
+/// up waiting on the pool
+class RunnableBatch
+{
+public:
+  /// Single constructor
+  RunnableBatch ();
+
+  /// Waits for the runnables, and then deletes them
+  ~RunnableBatch ();
+
+  /// Start a runnable, which then belongs to this batch
+  void start (QRunnable *runnable);
+
+  /// Wait until every started runnable has finished
+  void waitForDone ();
+
+private:
+  RunnableBatch (const RunnableBatch &other);
+  RunnableBatch &operator= (const RunnableBatch &other);
+
+  QList<QRunnable*> m_runnables;
+  int m_countUnfinished;
+  QSemaphore m_finished;
+};
+
+#endif // RUNNABLE_BATCH_H